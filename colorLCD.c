@@ -0,0 +1,63 @@
+#include "colorLCD.h"
+#include "frameLCD.h"
+#include "dma2dLCD.h"
+
+
+LCD_Color16 LCD_mezclaRGB565(LCD_Color16 fondo, LCD_Color16 color, uint8_t alfa) {
+	uint32_t a = (alfa + 4) >> 3;  // Opacidad de 0 a 32
+	uint32_t f = (fondo | ((uint32_t) fondo << 16)) & 0x07E0F81Fu;
+	uint32_t c = (color | ((uint32_t) color << 16)) & 0x07E0F81Fu;
+	// Separa el verde de rojo y azul dejando hueco entre ellos para mezclar los tres a la vez
+	uint32_t r = (f + (((c - f) * a) >> 5)) & 0x07E0F81Fu;
+	return (LCD_Color16) (r | (r >> 16));
+}
+
+
+static void mezclaPunto(uint8_t * destino, LCD_Color16 color, uint8_t alfa) {
+// Mezcla un punto RGB565 con el punto del frame buffer que hay en 'destino', en el formato de los frame buffers
+
+#ifdef LCD_FORMATO_RGB565
+	uint16_t * p = (uint16_t *) destino;
+	*p = alfa == 255 ? color : LCD_mezclaRGB565(*p, color, alfa);
+#else
+	uint32_t * p = (uint32_t *) destino;
+	uint32_t argb = LCD_RGB565_A_ARGB(color);
+	if (alfa != 255) {
+		uint32_t fondo = *p, mezcla = 0xFF000000u;
+		for (int desp = 0; desp < 24; desp += 8) {
+			uint32_t cf = (fondo >> desp) & 0xFF, cc = (argb >> desp) & 0xFF;
+			mezcla |= ((cf * (255 - alfa) + cc * alfa + 127) / 255) << desp;
+		}
+		argb = mezcla;
+	}
+	*p = argb;
+#endif
+}
+
+
+void LCD_dibujaImagen16(uint16_t x, uint16_t y, int opacidad, const LCD_Imagen16 * pImagen) {
+	if (opacidad <= 0)
+		return;
+	LCD_Region region = {x, y, pImagen->ancho, pImagen->alto}, fisica;
+	LCD_regionFisica(&region, &fisica);
+	uint8_t * destino = LCD_direccionPuntoFisico(fisica.x, fisica.y);
+
+	if (pImagen->alfa == 0 && opacidad >= 100) {
+		LCD_copiaBloqueRGB565DMA2D(pImagen->colores, destino, fisica.ancho, fisica.alto);
+		return;
+	}
+
+	LCD_esperaDMA2D();  // La mezcla se hace con la CPU
+	uint32_t escala = opacidad >= 100 ? 255 : opacidad * 255 / 100;
+	const LCD_Color16 * colores = pImagen->colores;
+	const uint8_t * alfa = pImagen->alfa;
+	for (uint16_t fila = 0; fila < fisica.alto; fila++) {
+		uint8_t * p = destino + fila * LCD_ANCHO_FISICO * LCD_BYTES_PUNTO;
+		for (uint16_t columna = 0; columna < fisica.ancho; columna++, p += LCD_BYTES_PUNTO) {
+			uint32_t a = alfa ? *alfa++ * escala / 255 : escala;
+			LCD_Color16 color = *colores++;
+			if (a != 0)  // Los puntos transparentes no se leen ni se escriben
+				mezclaPunto(p, color, (uint8_t) a);
+		}
+	}
+}
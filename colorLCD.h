@@ -0,0 +1,99 @@
+#ifndef COLORLCD_H_
+#define COLORLCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file colorLCD.h
+  * @author EII
+  *
+  * @brief Colores e imágenes de 16 bits en el formato RGB565 de la capa del LTDC.
+  *
+  * Las imágenes en formato ARGB de 32 bits ocupan el doble que las RGB565 y además obligan a convertir
+  * cada punto al formato de la pantalla. Una imagen LCD_Imagen16 guarda sus puntos en RGB565 y, sólo si
+  * tiene zonas transparentes, una máscara separada de 8 bits de alfa por punto. Las imágenes opacas se
+  * copian con una única transferencia del DMA2D; las que tienen máscara se mezclan punto a punto con el
+  * contenido del frame buffer.
+  *
+  * Los puntos de las imágenes se guardan en la orientación física del frame buffer (ver LCD_regionFisica()
+  * en frameLCD.h), para que el DMA2D pueda copiarlas línea a línea sin girarlas. Con la pantalla en
+  * horizontal, la herramienta que genera la imagen tiene que girarla 90 grados.
+  *
+  * Compilando con -DLCD_FORMATO_RGB565 los frame buffers pasan a ser RGB565, el mismo formato que la capa
+  * del LTDC, de forma que rellenos, copias e imágenes de 16 bits se escriben sin conversión y se mueve
+  * la mitad de datos por el bus de la SDRAM. La biblioteca pantallaLCD tiene que compilarse con el mismo
+  * formato.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static const LCD_Color16 puntos[60 * 60] = { ... };  // Generados por la herramienta de conversión
+  * static const uint8_t alfa[60 * 60] = { ... };
+  * static const LCD_Imagen16 alarma = {60, 60, puntos, alfa};
+  *
+  * LCD_dibujaImagen16(10, 10, 100, &alarma);
+  * @endcode
+  */
+
+
+/** @brief Color de 16 bits en formato RGB565 */
+typedef uint16_t LCD_Color16;
+
+/** @brief Construye un color RGB565 a partir de sus componentes de 8 bits */
+#define LCD_RGB565(r, g, b) ((LCD_Color16) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+/** @brief Convierte un color ARGB de 32 bits a RGB565, descartando el canal alfa */
+#define LCD_ARGB_A_RGB565(color) \
+    LCD_RGB565(((color) >> 16) & 0xFF, ((color) >> 8) & 0xFF, (color) & 0xFF)
+
+/** @brief Convierte un color RGB565 a ARGB de 32 bits opaco, replicando los bits altos de cada componente */
+#define LCD_RGB565_A_ARGB(color) (0xFF000000u | \
+    ((((color) >> 8) & 0xF8) | (((color) >> 13) & 0x07)) << 16 | \
+    ((((color) >> 3) & 0xFC) | (((color) >> 9) & 0x03)) << 8 | \
+    ((((color) << 3) & 0xF8) | (((color) >> 2) & 0x07)))
+
+/** @brief Canal alfa de un color ARGB de 32 bits */
+#define LCD_ALFA_ARGB(color) ((uint8_t) ((color) >> 24))
+
+
+/**
+ * @brief Imagen con los puntos en formato RGB565 y máscara de alfa opcional
+ */
+typedef struct {
+    /** @brief Ancho de la imagen en pantalla */
+    uint16_t ancho;
+    /** @brief Alto de la imagen en pantalla */
+    uint16_t alto;
+    /** @brief Puntos de la imagen en la orientación física del frame buffer */
+    const LCD_Color16 * colores;
+    /** @brief Alfa de cada punto, en el mismo orden que los colores: 0 transparente, 255 opaco. NULL si la
+     *     imagen es completamente opaca */
+    const uint8_t * alfa;
+} LCD_Imagen16;
+
+
+/**
+ * @brief Mezcla dos colores RGB565
+ *
+ * @param fondo Color que queda detrás
+ * @param color Color que se dibuja encima
+ * @param alfa Opacidad de 'color', entre 0 y 255
+ * @return Color resultante
+ */
+LCD_Color16 LCD_mezclaRGB565(LCD_Color16 fondo, LCD_Color16 color, uint8_t alfa);
+
+
+/**
+ * @brief Dibuja una imagen de 16 bits en el frame buffer oculto
+ *
+ * Si la imagen no tiene máscara y la opacidad es 100 se copia con una única transferencia del DMA2D.
+ * En caso contrario se mezcla punto a punto con el contenido del frame buffer.
+ *
+ * @param x Coordenada X en pantalla de la esquina superior izquierda
+ * @param y Coordenada Y en pantalla de la esquina superior izquierda
+ * @param opacidad Opacidad de toda la imagen, de 0 (no se dibuja) a 100
+ * @param pImagen Puntero a la imagen
+ */
+void LCD_dibujaImagen16(uint16_t x, uint16_t y, int opacidad, const LCD_Imagen16 * pImagen);
+
+
+#endif /* COLORLCD_H_ */
@@ -0,0 +1,357 @@
+#include "dma2dLCD.h"
+#include <string.h>  // Para memmove()
+#include "pantallaLCD.h"
+#include "frameLCD.h"
+#include "colorLCD.h"
+#include "memoriaSDRAM.h"
+
+#ifndef LCD_DMA2D_SOFTWARE
+#include "main.h"
+
+extern DMA2D_HandleTypeDef hdma2d;  // Inicializado en main.c
+#endif
+
+
+static uint32_t grisARGB(uint32_t color) {
+// Convierte un color ARGB a escala de grises conservando su canal alfa
+
+	uint32_t r = (color >> 16) & 0xFF, g = (color >> 8) & 0xFF, b = color & 0xFF;
+	uint32_t luminancia = (r * 77 + g * 150 + b * 29) >> 8;
+	return (color & 0xFF000000u) | (luminancia << 16) | (luminancia << 8) | luminancia;
+}
+
+
+static uint32_t leePunto(const uint8_t * p) {
+// Devuelve en formato ARGB el punto de un frame buffer
+
+#ifdef LCD_FORMATO_RGB565
+	return LCD_RGB565_A_ARGB(*(const uint16_t *) p);
+#else
+	return *(const uint32_t *) p;
+#endif
+}
+
+
+static void escribePunto(uint8_t * p, uint32_t color) {
+// Escribe un color ARGB en un punto de un frame buffer, en su formato
+
+#ifdef LCD_FORMATO_RGB565
+	*(uint16_t *) p = LCD_ARGB_A_RGB565(color);
+#else
+	*(uint32_t *) p = color;
+#endif
+}
+
+
+static void mezclaBloqueCPU(const uint8_t * origen, uint16_t offsetOrigen, uint32_t color, uint8_t * destino,
+	uint16_t ancho, uint16_t alto, uint8_t opacidad, int enBlancoYNegro) {
+// Mezcla con la CPU una imagen ARGB, o un color constante si 'origen' es NULL, con un bloque de un frame
+// buffer. Calcula lo mismo que el DMA2D en modo M2M_BLEND con un fondo opaco
+
+	for (uint16_t fila = 0; fila < alto; fila++) {
+		uint8_t * p = destino + fila * LCD_ANCHO_FISICO * LCD_BYTES_PUNTO;
+		for (uint16_t columna = 0; columna < ancho; columna++, p += LCD_BYTES_PUNTO) {
+			uint32_t c = color;
+			if (origen != NULL) {
+				c = *(const uint32_t *) origen;
+				origen += 4;
+			}
+			if (enBlancoYNegro)
+				c = grisARGB(c);
+			uint32_t alfa = (c >> 24) * opacidad / 255;
+			if (alfa == 0)
+				continue;
+			if (alfa != 255) {
+				uint32_t fondo = leePunto(p), mezcla = 0xFF000000u;
+				for (int desp = 0; desp < 24; desp += 8) {
+					uint32_t cf = (fondo >> desp) & 0xFF, cc = (c >> desp) & 0xFF;
+					mezcla |= ((cc * alfa + cf * (255 - alfa) + 127) / 255) << desp;
+				}
+				c = mezcla;
+			} else c |= 0xFF000000u;
+			escribePunto(p, c);
+		}
+		if (origen != NULL)
+			origen += offsetOrigen * 4;
+	}
+}
+
+
+static uint32_t puntosDMA2D = 0;  // Puntos escritos por las operaciones de bloque, para las medidas
+
+
+uint32_t LCD_puntosDMA2D(void) {
+	return puntosDMA2D;
+}
+
+
+#ifdef LCD_DMA2D_SOFTWARE
+// ---------------------------------------------------------------------------------------------------
+// Versión con la CPU
+
+void LCD_esperaDMA2D(void) {
+}
+
+
+void LCD_copiaBloqueDMA2D(const uint8_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	for (uint16_t fila = 0; fila < alto; fila++) {
+		uint32_t desplazamiento = fila * LCD_ANCHO_FISICO * LCD_BYTES_PUNTO;
+		memmove(destino + desplazamiento, origen + desplazamiento, ancho * LCD_BYTES_PUNTO);
+	}
+}
+
+
+void LCD_rellenaBloqueDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	for (uint16_t fila = 0; fila < alto; fila++) {
+		uint8_t * p = destino + fila * LCD_ANCHO_FISICO * LCD_BYTES_PUNTO;
+		for (uint16_t columna = 0; columna < ancho; columna++, p += LCD_BYTES_PUNTO)
+			escribePunto(p, color);
+	}
+}
+
+
+void LCD_copiaBloqueRGB565DMA2D(const uint16_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	for (uint16_t fila = 0; fila < alto; fila++) {
+		uint8_t * p = destino + fila * LCD_ANCHO_FISICO * LCD_BYTES_PUNTO;
+		for (uint16_t columna = 0; columna < ancho; columna++, p += LCD_BYTES_PUNTO, origen++)
+			escribePunto(p, LCD_RGB565_A_ARGB(*origen));
+	}
+}
+
+
+void LCD_mezclaColorDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	mezclaBloqueCPU(NULL, 0, color, destino, ancho, alto, 255, 0);
+}
+
+
+void LCD_mezclaBloqueARGBDMA2D(const uint8_t * origen, uint16_t offsetOrigen, uint8_t * destino,
+	uint16_t ancho, uint16_t alto, uint8_t opacidad) {
+	puntosDMA2D += ancho * alto;
+	mezclaBloqueCPU(origen, offsetOrigen, 0, destino, ancho, alto, opacidad, 0);
+}
+
+
+#else
+// ---------------------------------------------------------------------------------------------------
+// Versión con el DMA2D
+
+void LCD_esperaDMA2D(void) {
+	if (hdma2d.State == HAL_DMA2D_STATE_BUSY)
+		HAL_DMA2D_PollForTransfer(&hdma2d, LCD_ESPERA_MAXIMA_DMA2D);
+}
+
+
+static int configura(uint32_t modo, uint16_t ancho) {
+// Espera a la transferencia anterior y prepara una nueva que escribe líneas de 'ancho' puntos en un frame
+// buffer. Cada línea está separada de la siguiente por el resto de la línea del frame buffer
+
+	LCD_esperaDMA2D();
+	hdma2d.Init.Mode = modo;
+	hdma2d.Init.ColorMode = LCD_FORMATO_SALIDA_DMA2D;
+	hdma2d.Init.OutputOffset = LCD_ANCHO_FISICO - ancho;
+	return HAL_DMA2D_Init(&hdma2d) == HAL_OK;
+}
+
+
+static int configuraCapa(uint32_t capa, uint32_t formato, uint32_t offset, uint32_t modoAlfa, uint32_t alfa) {
+// Configura la capa de primer plano (1) o de fondo (0)
+
+	hdma2d.LayerCfg[capa].InputOffset = offset;
+	hdma2d.LayerCfg[capa].InputColorMode = formato;
+	hdma2d.LayerCfg[capa].AlphaMode = modoAlfa;
+	hdma2d.LayerCfg[capa].InputAlpha = alfa;
+	return HAL_DMA2D_ConfigLayer(&hdma2d, capa) == HAL_OK;
+}
+
+
+void LCD_copiaBloqueDMA2D(const uint8_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	if (configura(DMA2D_M2M, ancho) &&
+			configuraCapa(1, LCD_FORMATO_ENTRADA_DMA2D, LCD_ANCHO_FISICO - ancho, DMA2D_NO_MODIF_ALPHA, 0))
+		HAL_DMA2D_Start(&hdma2d, (uint32_t) origen, (uint32_t) destino, ancho, alto);
+}
+
+
+void LCD_rellenaBloqueDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	if (configura(DMA2D_R2M, ancho))
+		HAL_DMA2D_Start(&hdma2d, color, (uint32_t) destino, ancho, alto);
+	// En modo R2M el color se da en ARGB y el DMA2D lo convierte al formato de salida
+}
+
+
+void LCD_copiaBloqueRGB565DMA2D(const uint16_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+#ifdef LCD_FORMATO_RGB565
+	uint32_t modo = DMA2D_M2M;
+#else
+	uint32_t modo = DMA2D_M2M_PFC;  // Con frame buffers ARGB el DMA2D convierte cada punto al vuelo
+#endif
+	if (configura(modo, ancho) && configuraCapa(1, DMA2D_INPUT_RGB565, 0, DMA2D_NO_MODIF_ALPHA, 0))
+		HAL_DMA2D_Start(&hdma2d, (uint32_t) origen, (uint32_t) destino, ancho, alto);
+}
+
+
+void LCD_mezclaColorDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto) {
+	puntosDMA2D += ancho * alto;
+	if (configura(DMA2D_M2M_BLEND, ancho) &&
+			configuraCapa(1, DMA2D_INPUT_A8, LCD_ANCHO_FISICO - ancho, DMA2D_REPLACE_ALPHA, color) &&
+			configuraCapa(0, LCD_FORMATO_ENTRADA_DMA2D, LCD_ANCHO_FISICO - ancho, DMA2D_NO_MODIF_ALPHA, 0))
+		HAL_DMA2D_BlendingStart(&hdma2d, (uint32_t) destino, (uint32_t) destino, (uint32_t) destino,
+			ancho, alto);
+	// El primer plano es un color fijo: en formato A8 el color sale del registro FGCOLR y, al sustituir el
+	// alfa, lo que se lee de memoria no se utiliza. Se lee del propio destino, que siempre es accesible
+}
+
+
+void LCD_mezclaBloqueARGBDMA2D(const uint8_t * origen, uint16_t offsetOrigen, uint8_t * destino,
+	uint16_t ancho, uint16_t alto, uint8_t opacidad) {
+	puntosDMA2D += ancho * alto;
+	uint32_t modoAlfa = opacidad == 255 ? DMA2D_NO_MODIF_ALPHA : DMA2D_COMBINE_ALPHA;
+	if (configura(DMA2D_M2M_BLEND, ancho) &&
+			configuraCapa(1, DMA2D_INPUT_ARGB8888, offsetOrigen, modoAlfa, opacidad) &&
+			configuraCapa(0, LCD_FORMATO_ENTRADA_DMA2D, LCD_ANCHO_FISICO - ancho, DMA2D_NO_MODIF_ALPHA, 0))
+		HAL_DMA2D_BlendingStart(&hdma2d, (uint32_t) origen, (uint32_t) destino, (uint32_t) destino,
+			ancho, alto);
+}
+
+#endif
+
+
+// ---------------------------------------------------------------------------------------------------
+// Sustitutos de las funciones de pantallaLCD
+
+static int recorta(uint16_t x, uint16_t y, uint16_t * ancho, uint16_t * alto) {
+// Recorta las dimensiones de un rectángulo a la pantalla. Devuelve falso si no queda nada que dibujar
+
+	uint16_t anchoPantalla = LCD_anchoPantalla(), altoPantalla = LCD_altoPantalla();
+	if (x >= anchoPantalla || y >= altoPantalla || *ancho == 0 || *alto == 0)
+		return 0;
+	if (x + *ancho > anchoPantalla) *ancho = anchoPantalla - x;
+	if (y + *alto > altoPantalla) *alto = altoPantalla - y;
+	return 1;
+}
+
+
+static uint8_t opacidadTransparencia(int transparencia) {
+// Convierte una transparencia de pantallaLCD, de 0 a 100, en una opacidad de 0 a 255
+
+	if (transparencia <= 0) return 0;
+	if (transparencia >= 100) return 255;
+	return transparencia * 255 / 100;
+}
+
+
+void LCD_dibujaRectanguloRellenoDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+	int enBlancoYNegro, int transparencia) {
+	if (!LCD_regionesActivas()) {  // Sin gestión de regiones no se sabe cuál es el buffer oculto
+		LCD_dibujaRectanguloRelleno(x, y, ancho, alto, color, enBlancoYNegro, transparencia);
+		return;
+	}
+	if (!recorta(x, y, &ancho, &alto))
+		return;
+	if (enBlancoYNegro)
+		color = grisARGB(color);
+	uint32_t alfa = (color >> 24) * opacidadTransparencia(transparencia) / 255;
+	LCD_Region region = {x, y, ancho, alto}, fisica;
+	LCD_regionFisica(&region, &fisica);
+	uint8_t * destino = LCD_direccionPuntoFisico(fisica.x, fisica.y);
+	if (alfa == 255)
+		LCD_rellenaBloqueDMA2D(color, destino, fisica.ancho, fisica.alto);
+	else if (alfa != 0)
+		LCD_mezclaColorDMA2D((alfa << 24) | (color & 0x00FFFFFFu), destino, fisica.ancho, fisica.alto);
+}
+
+
+void LCD_dibujaRectanguloRellenoOpacoDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto,
+	uint32_t color) {
+	if (!LCD_regionesActivas()) {
+		LCD_dibujaRectanguloRellenoOpaco(x, y, ancho, alto, color);
+		return;
+	}
+	if (!recorta(x, y, &ancho, &alto))
+		return;
+	LCD_Region region = {x, y, ancho, alto};
+	LCD_rellenaRegion(&region, color | 0xFF000000u);
+}
+
+
+typedef struct {
+	const uint8_t * colores;  // Imagen original, NULL si la entrada está libre
+	uint16_t ancho, alto;
+	uint32_t * girada;  // Copia en la SDRAM con 'alto' puntos por línea y 'ancho' líneas
+} ImagenGirada;
+
+static ImagenGirada imagenesGiradas[LCD_IMAGENES_GIRADAS];
+
+
+static const uint32_t * imagenGirada(const uint8_t * colores, uint16_t ancho, uint16_t alto) {
+// Devuelve la copia de la imagen girada como la pantalla en horizontal, creándola si aún no existe, o NULL
+// si no hay sitio. La columna c de la imagen es la línea c de la copia, y su punto de la línea 'linea'
+// queda en la posición alto - 1 - linea, igual que en el frame buffer (ver LCD_regionFisica())
+
+	ImagenGirada * e = imagenesGiradas;
+	for (; e < imagenesGiradas + LCD_IMAGENES_GIRADAS && e->colores != NULL; e++)
+		if (e->colores == colores && e->ancho == ancho && e->alto == alto)
+			return e->girada;
+	if (e == imagenesGiradas + LCD_IMAGENES_GIRADAS ||
+			(e->girada = reservaSDRAM(ancho * alto * 4)) == NULL)
+		return NULL;
+
+	const uint32_t * origen = (const uint32_t *) colores;
+	for (uint16_t linea = 0; linea < alto; linea++)
+		for (uint16_t columna = 0; columna < ancho; columna++)
+			e->girada[columna * alto + alto - 1 - linea] = *origen++;
+	e->colores = colores;
+	e->ancho = ancho;
+	e->alto = alto;
+	return e->girada;
+}
+
+
+void LCD_dibujaImagenDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
+	int enBlancoYNegro, int transparencia) {
+	if (!LCD_regionesActivas()) {
+		LCD_dibujaImagen(x, y, ancho, alto, colores, enBlancoYNegro, transparencia);
+		return;
+	}
+	uint16_t anchoVisible = ancho, altoVisible = alto;
+	uint8_t opacidad = opacidadTransparencia(transparencia);
+	if (opacidad == 0 || !recorta(x, y, &anchoVisible, &altoVisible))
+		return;
+	if (enBlancoYNegro)
+		LCD_esperaDMA2D();  // La escala de grises se hace con la CPU
+
+	if (LCD_anchoPantalla() <= LCD_altoPantalla()) {  // Vertical: las líneas de la imagen son las del buffer
+		uint8_t * destino = LCD_direccionPuntoFisico(x, y);
+		if (enBlancoYNegro)
+			mezclaBloqueCPU(colores, ancho - anchoVisible, 0, destino, anchoVisible, altoVisible, opacidad, 1);
+		else LCD_mezclaBloqueARGBDMA2D(colores, ancho - anchoVisible, destino, anchoVisible, altoVisible,
+			opacidad);
+		return;
+	}
+
+	LCD_Region region = {x, y, anchoVisible, altoVisible}, fisica;
+	LCD_regionFisica(&region, &fisica);
+	const uint32_t * girada = imagenGirada(colores, ancho, alto);
+	if (girada != NULL) {
+		// Las líneas recortadas de la imagen son las primeras columnas de la copia
+		const uint8_t * origen = (const uint8_t *) (girada + alto - altoVisible);
+		uint8_t * destino = LCD_direccionPuntoFisico(fisica.x, fisica.y);
+		if (enBlancoYNegro)
+			mezclaBloqueCPU(origen, alto - altoVisible, 0, destino, fisica.ancho, fisica.alto, opacidad, 1);
+		else LCD_mezclaBloqueARGBDMA2D(origen, alto - altoVisible, destino, fisica.ancho, fisica.alto, opacidad);
+		return;
+	}
+
+	LCD_esperaDMA2D();  // Sin copia girada, línea a línea con la CPU
+	for (uint16_t linea = 0; linea < altoVisible; linea++) {
+		// En horizontal, la línea 'linea' de la imagen ocupa una columna del frame buffer de arriba a abajo
+		uint8_t * destino = LCD_direccionPuntoFisico(fisica.x + altoVisible - 1 - linea, fisica.y);
+		mezclaBloqueCPU(colores + linea * ancho * 4, 0, 0, destino, 1, anchoVisible, opacidad, enBlancoYNegro);
+	}
+}
@@ -0,0 +1,198 @@
+#ifndef DMA2DLCD_H_
+#define DMA2DLCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file dma2dLCD.h
+  * @author EII
+  *
+  * @brief Operaciones sobre los frame buffers realizadas con el DMA2D.
+  *
+  * Utiliza el manejador hdma2d inicializado en main.c. Hay dos niveles de funciones:
+  *
+  * - Operaciones de bloque, con direcciones y dimensiones en coordenadas físicas de los frame buffers (ver
+  *   LCD_regionFisica() en frameLCD.h), donde cada línea ocupa LCD_ANCHO_FISICO puntos. Cubren los modos
+  *   R2M (relleno), M2M (copia), M2M_PFC (copia con conversión de formato) y M2M_BLEND (mezcla).
+  * - Sustitutos de LCD_dibujaRectanguloRelleno(), LCD_dibujaRectanguloRellenoOpaco() y LCD_dibujaImagen()
+  *   de pantallaLCD, con los mismos parámetros en coordenadas de pantalla, que recortan a la pantalla y
+  *   giran las imágenes si está en horizontal. Necesitan la gestión de regiones de frameLCD para conocer el
+  *   buffer oculto; si no se activó, llaman a las funciones de pantallaLCD.
+  *
+  * Las transferencias son asíncronas: cada función programa el DMA2D y retorna sin esperar a que termine,
+  * de forma que la CPU puede seguir trabajando. Antes de dibujar con la CPU en un frame buffer (por ejemplo
+  * texto o líneas con pantallaLCD) hay que llamar a LCD_esperaDMA2D(). Las funciones de este módulo y
+  * LCD_intercambiaBuffersRegiones() ya esperan a la transferencia anterior.
+  *
+  * La versión deshabilitada (enBlancoYNegro) de las imágenes no se puede hacer con el DMA2D, que no
+  * convierte a escala de grises, así que se dibuja con la CPU. En los rectángulos basta con convertir el
+  * color antes de rellenar.
+  *
+  * Compilando con -DLCD_DMA2D_SOFTWARE todas las operaciones se hacen con la CPU, con los mismos resultados
+  * salvo redondeos en las mezclas, para poder comprobarlas sin el hardware. El simulador (LCD_SIMULADOR)
+  * lo activa siempre.
+  *
+  * El formato de salida es el de los frame buffers: RGB565 si se compila con LCD_FORMATO_RGB565 (ver
+  * frameLCD.h) o ARGB de 32 bits en caso contrario.
+  */
+
+
+#if defined(LCD_SIMULADOR) && !defined(LCD_DMA2D_SOFTWARE)
+#define LCD_DMA2D_SOFTWARE  // En el simulador no hay DMA2D
+#endif
+
+#ifdef LCD_FORMATO_RGB565
+/** @brief Formato de salida del DMA2D, el de los frame buffers */
+#define LCD_FORMATO_SALIDA_DMA2D DMA2D_OUTPUT_RGB565
+/** @brief Formato de entrada del DMA2D al leer de un frame buffer */
+#define LCD_FORMATO_ENTRADA_DMA2D DMA2D_INPUT_RGB565
+#else
+#define LCD_FORMATO_SALIDA_DMA2D DMA2D_OUTPUT_ARGB8888
+#define LCD_FORMATO_ENTRADA_DMA2D DMA2D_INPUT_ARGB8888
+#endif
+
+/** @brief Tiempo máximo en ms que se espera a que termine una transferencia */
+#ifndef LCD_ESPERA_MAXIMA_DMA2D
+#define LCD_ESPERA_MAXIMA_DMA2D 50
+#endif
+
+/** @brief Imágenes distintas de las que se guarda una copia girada en la SDRAM para la pantalla en horizontal */
+#ifndef LCD_IMAGENES_GIRADAS
+#define LCD_IMAGENES_GIRADAS 16
+#endif
+
+
+/**
+ * @brief Espera a que termine la transferencia en curso del DMA2D, si la hay
+ *
+ * Hay que llamarla antes de leer o escribir con la CPU en un frame buffer.
+ */
+void LCD_esperaDMA2D(void);
+
+
+/**
+ * @brief Copia un bloque rectangular de puntos entre dos buffers con el formato de los frame buffers
+ *
+ * Se puede utilizar para desplazar una zona dentro del mismo buffer siempre que el destino esté en una
+ * dirección menor que el origen.
+ *
+ * @param origen Dirección del primer punto del bloque de origen
+ * @param destino Dirección del primer punto del bloque de destino
+ * @param ancho Número de puntos de cada línea del bloque
+ * @param alto Número de líneas del bloque
+ */
+void LCD_copiaBloqueDMA2D(const uint8_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Rellena un bloque rectangular de un frame buffer con un color
+ *
+ * El DMA2D escribe directamente en el formato de los frame buffers, sin leer la memoria de destino.
+ *
+ * @param color Color en formato ARGB de 32 bits
+ * @param destino Dirección del primer punto del bloque
+ * @param ancho Número de puntos de cada línea del bloque
+ * @param alto Número de líneas del bloque
+ */
+void LCD_rellenaBloqueDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Copia en un frame buffer una imagen RGB565 guardada de forma contigua
+ *
+ * Si los frame buffers son RGB565 es una copia directa. Si son ARGB, el DMA2D convierte el formato.
+ *
+ * @param origen Puntos de la imagen, ancho x alto, línea a línea en la orientación física del frame buffer
+ * @param destino Dirección del primer punto del bloque de destino
+ * @param ancho Número de puntos de cada línea
+ * @param alto Número de líneas
+ */
+void LCD_copiaBloqueRGB565DMA2D(const uint16_t * origen, uint8_t * destino, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Mezcla un color semitransparente con un bloque rectangular de un frame buffer
+ *
+ * @param color Color en formato ARGB de 32 bits. Su canal alfa es la opacidad
+ * @param destino Dirección del primer punto del bloque
+ * @param ancho Número de puntos de cada línea del bloque
+ * @param alto Número de líneas del bloque
+ */
+void LCD_mezclaColorDMA2D(uint32_t color, uint8_t * destino, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Mezcla una imagen ARGB de 32 bits con un bloque rectangular de un frame buffer
+ *
+ * Cada punto se mezcla según su canal alfa multiplicado por la opacidad.
+ *
+ * @param origen Dirección del primer punto de la imagen a mezclar
+ * @param offsetOrigen Puntos que hay que saltar en la imagen al terminar cada línea del bloque
+ * @param destino Dirección del primer punto del bloque de destino
+ * @param ancho Número de puntos de cada línea del bloque
+ * @param alto Número de líneas del bloque
+ * @param opacidad Opacidad de la imagen, entre 0 y 255
+ */
+void LCD_mezclaBloqueARGBDMA2D(const uint8_t * origen, uint16_t offsetOrigen, uint8_t * destino,
+    uint16_t ancho, uint16_t alto, uint8_t opacidad);
+
+
+/**
+ * @brief Número total de puntos escritos por las operaciones de bloque desde el arranque
+ *
+ * Cuenta también los que se escriben con la CPU en la versión LCD_DMA2D_SOFTWARE. Para medir una
+ * operación basta con restar el valor anterior, ver rendimiento.h.
+ */
+uint32_t LCD_puntosDMA2D(void);
+
+
+/**
+ * @brief Dibuja un rectángulo relleno en el frame buffer oculto con el DMA2D
+ *
+ * Sustituye a LCD_dibujaRectanguloRelleno(). Si el color es opaco y la transparencia es 100 se rellena
+ * en modo R2M; en caso contrario se mezcla en modo M2M_BLEND.
+ *
+ * @param x Coordenada X de la esquina superior izquierda
+ * @param y Coordenada Y de la esquina superior izquierda
+ * @param ancho Ancho en puntos
+ * @param alto Alto en puntos
+ * @param color Color en formato ARGB de 32 bits
+ * @param enBlancoYNegro Buleano que indica si se dibuja en escala de grises
+ * @param transparencia Opacidad de 0 (no se dibuja) a 100
+ */
+void LCD_dibujaRectanguloRellenoDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+    int enBlancoYNegro, int transparencia);
+
+
+/**
+ * @brief Dibuja un rectángulo relleno opaco en el frame buffer oculto con el DMA2D
+ *
+ * Sustituye a LCD_dibujaRectanguloRellenoOpaco(). Se rellena en modo R2M, ignorando el canal alfa.
+ */
+void LCD_dibujaRectanguloRellenoOpacoDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto,
+    uint32_t color);
+
+
+/**
+ * @brief Dibuja una imagen ARGB de 32 bits en el frame buffer oculto con el DMA2D
+ *
+ * Sustituye a LCD_dibujaImagen(). La imagen se mezcla en modo M2M_BLEND según el canal alfa de cada punto
+ * y la transparencia. Con la pantalla en horizontal cada línea de la imagen es una columna del frame
+ * buffer: la primera vez que se dibuja una imagen se guarda en la SDRAM una copia girada, con la
+ * disposición del frame buffer, y se mezcla esa copia con una única transferencia. Las copias se buscan
+ * por la dirección de 'colores', así que no hay que cambiar los puntos de una imagen ya dibujada. Si ya
+ * hay LCD_IMAGENES_GIRADAS copias o no queda SDRAM, la imagen se mezcla con la CPU.
+ *
+ * @param x Coordenada X de la esquina superior izquierda
+ * @param y Coordenada Y de la esquina superior izquierda
+ * @param ancho Ancho de la imagen en puntos
+ * @param alto Alto de la imagen en puntos
+ * @param colores Puntos de la imagen línea a línea, en formato ARGB de 32 bits
+ * @param enBlancoYNegro Buleano que indica si se dibuja en escala de grises. Se hace con la CPU
+ * @param transparencia Opacidad de 0 (no se dibuja) a 100
+ */
+void LCD_dibujaImagenDMA2D(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
+    int enBlancoYNegro, int transparencia);
+
+
+#endif /* DMA2DLCD_H_ */
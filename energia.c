@@ -0,0 +1,223 @@
+#include "energia.h"
+#include "cmsis_os.h"
+#include "perfilado.h"
+#include "telemetria.h"
+
+#ifndef LCD_SIMULADOR
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+extern UART_HandleTypeDef huart1;  // Inicializados en main.c
+extern SDRAM_HandleTypeDef hsdram1;
+extern TIM_HandleTypeDef htim6;  // Base de tiempos de la HAL, en stm32f4xx_hal_timebase_tim.c
+
+#define REFRESCO_SDRAM_NS 15625u  // 64 ms / 4096 filas
+#define COMPENSACION_SYSTICK 45u  // Ciclos que el SysTick está parado en vPortSuppressTicksAndSleep()
+#endif
+
+
+static volatile PerfilEnergia perfil = ENERGIA_PERFIL_ALTO;
+static volatile PerfilEnergia pedido = ENERGIA_PERFIL_ALTO;  // Último perfil pedido, aún sin aplicar si difiere
+static volatile int cambioPendiente = 0;  // Buleano cierto si hay que aplicar 'pedido' con USART1 libre
+static uint32_t inicioPerfil;  // Instante en ticks en que se entró en el perfil actual
+static uint32_t tiempoPerfil[2];  // Ticks acumulados en cada perfil sin contar el tramo actual
+static volatile uint32_t tiempoDormido = 0;  // Ticks dormidos en el reposo sin tick
+
+
+#ifndef LCD_SIMULADOR
+static void programaRefrescoSDRAM(uint32_t hclk) {
+// Cuenta de refresco para la frecuencia de HCLK indicada (SDCLK = HCLK/2), con el margen de 20 ciclos del manual
+
+	uint32_t sdclk = hclk / 2;
+	HAL_SDRAM_ProgramRefreshRate(&hsdram1, (uint32_t) ((uint64_t) REFRESCO_SDRAM_NS * sdclk / 1000000000u) - 20);
+}
+
+
+static void cambiaReloj(PerfilEnergia nuevo) {
+	RCC_ClkInitTypeDef reloj = {0};
+	reloj.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	reloj.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	if (nuevo == ENERGIA_PERFIL_ALTO) {
+		reloj.AHBCLKDivider = RCC_SYSCLK_DIV1;
+		reloj.APB1CLKDivider = RCC_HCLK_DIV2;
+		reloj.APB2CLKDivider = RCC_HCLK_DIV1;
+	} else {
+		reloj.AHBCLKDivider = RCC_SYSCLK_DIV2;
+		reloj.APB1CLKDivider = RCC_HCLK_DIV1;
+		reloj.APB2CLKDivider = RCC_HCLK_DIV1;
+	}
+
+	// La SDRAM se refresca de más durante el cambio, nunca de menos
+	if (nuevo == ENERGIA_PERFIL_BAJO) {
+		programaRefrescoSDRAM(HAL_RCC_GetSysClockFreq() / 2);
+		HAL_RCC_ClockConfig(&reloj, FLASH_LATENCY_1);
+	} else {
+		HAL_RCC_ClockConfig(&reloj, FLASH_LATENCY_2);
+		programaRefrescoSDRAM(HAL_RCC_GetHCLKFreq());
+	}
+	huart1.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK2Freq(), huart1.Init.BaudRate);
+#ifdef PERFILADO
+	ajustaRelojPerfilado();  // TIM1 también cuelga de PCLK2
+#endif
+
+	// El tick de FreeRTOS sigue siendo de 1 ms con la nueva frecuencia de HCLK
+	SysTick->LOAD = SystemCoreClock / configTICK_RATE_HZ - 1;
+	SysTick->VAL = 0;
+}
+#endif
+
+
+static void aplicaPerfil(void) {
+// Cambia al perfil pedido con la telemetría detenida y sin envío en curso, así que no se cambia la velocidad
+// de USART1 a mitad de un carácter. Se llama desde una tarea o desde la interrupción de fin de envío
+
+	PerfilEnergia nuevo = pedido;
+	if (nuevo != perfil) {
+#ifndef LCD_SIMULADOR
+		cambiaReloj(nuevo);
+#endif
+		uint32_t ahora = osKernelGetTickCount();
+		tiempoPerfil[perfil] += ahora - inicioPerfil;
+		inicioPerfil = ahora;
+		perfil = nuevo;
+	}
+	pausaTelemetria(0);
+}
+
+
+static void finEnvio(void) {
+// Fin de un envío con la telemetría detenida: si el cambio esperaba a este envío, se aplica ya
+
+	if (__atomic_exchange_n(&cambioPendiente, 0, __ATOMIC_ACQ_REL))
+		aplicaPerfil();
+}
+
+
+void inicializaEnergia(void) {
+	perfil = ENERGIA_PERFIL_ALTO;
+	inicioPerfil = osKernelGetTickCount();
+	tiempoPerfil[ENERGIA_PERFIL_ALTO] = tiempoPerfil[ENERGIA_PERFIL_BAJO] = 0;
+	tiempoDormido = 0;
+	pedido = ENERGIA_PERFIL_ALTO;
+	cambioPendiente = 0;
+	setFuncionPausaTelemetria(finEnvio);
+#ifndef LCD_SIMULADOR
+	programaRefrescoSDRAM(HAL_RCC_GetHCLKFreq());
+#endif
+}
+
+
+void setPerfilEnergia(PerfilEnergia nuevo) {
+	if (nuevo == pedido)
+		return;
+	pedido = nuevo;
+
+	// Sin nuevos envíos. Si hay uno en curso, el cambio lo aplica finEnvio() cuando termine; si no, o si ha
+	// terminado entre medias, se aplica aquí. Lo aplica sólo quien pone a 0 'cambioPendiente'
+	pausaTelemetria(1);
+	__atomic_store_n(&cambioPendiente, 1, __ATOMIC_RELEASE);
+	if (transmitiendoTelemetria() || !__atomic_exchange_n(&cambioPendiente, 0, __ATOMIC_ACQ_REL))
+		return;
+#ifndef LCD_SIMULADOR
+	osKernelLock();  // Ninguna otra tarea usa los periféricos a mitad del cambio
+#endif
+	aplicaPerfil();
+#ifndef LCD_SIMULADOR
+	osKernelUnlock();
+#endif
+}
+
+
+PerfilEnergia perfilEnergia(void) {
+	return perfil;
+}
+
+
+uint32_t tiempoPerfilEnergia(PerfilEnergia consultado) {
+	uint32_t tiempo = tiempoPerfil[consultado];
+	if (consultado == perfil)
+		tiempo += osKernelGetTickCount() - inicioPerfil;
+	return tiempo * 1000 / osKernelGetTickFreq();
+}
+
+
+uint32_t tiempoDormidoEnergia(void) {
+	return tiempoDormido * 1000 / osKernelGetTickFreq();
+}
+
+
+#ifndef LCD_SIMULADOR
+void vPortSuppressTicksAndSleep(TickType_t esperados) {
+// Como la de port.c de FreeRTOS, pero con las cuentas del SysTick de la frecuencia actual y parando TIM6
+
+	uint32_t cuentasTick = SystemCoreClock / configTICK_RATE_HZ;
+	uint32_t maximo = SysTick_LOAD_RELOAD_Msk / cuentasTick;
+	if (esperados > maximo)
+		esperados = maximo;
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	uint32_t recarga = SysTick->VAL + cuentasTick * (esperados - 1);
+	if (recarga > COMPENSACION_SYSTICK)
+		recarga -= COMPENSACION_SYSTICK;
+
+	__disable_irq();
+	__DSB();
+	__ISB();
+	if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+		// Una tarea quedó lista mientras se preparaba: se reanuda el tick actual
+		SysTick->LOAD = SysTick->VAL;
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		SysTick->LOAD = cuentasTick - 1;
+		__enable_irq();
+		return;
+	}
+
+	HAL_SuspendTick();  // Sin la interrupción de TIM6 cada milisegundo
+	SysTick->LOAD = recarga;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	__DSB();
+	__WFI();
+	__ISB();
+
+	__enable_irq();  // Se atiende la interrupción que ha despertado a la CPU
+	__DSB();
+	__ISB();
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;  // Parado, sin borrar COUNTFLAG
+	uint32_t completos, dormidos;
+	if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) {
+		// Ha despertado el SysTick: su interrupción ya contó el último tick
+		uint32_t resto = (cuentasTick - 1) - (recarga - SysTick->VAL);
+		if (resto < COMPENSACION_SYSTICK || resto > cuentasTick)
+			resto = cuentasTick - 1;
+		SysTick->LOAD = resto;
+		completos = esperados - 1;
+		dormidos = esperados;
+	} else {
+		// Ha despertado otra interrupción: se cuentan los ticks completos y se termina el actual
+		uint32_t transcurridas = esperados * cuentasTick - SysTick->VAL;
+		completos = transcurridas / cuentasTick;
+		SysTick->LOAD = (completos + 1) * cuentasTick - transcurridas;
+		dormidos = completos;
+	}
+
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	vTaskStepTick(completos);
+	SysTick->LOAD = cuentasTick - 1;
+
+	// TIM6 ha seguido contando con la interrupción parada: se descarta la pendiente y se suman los
+	// milisegundos dormidos, de forma que HAL_GetTick() no se atrasa
+	__HAL_TIM_CLEAR_IT(&htim6, TIM_IT_UPDATE);
+	uwTick += dormidos * 1000 / configTICK_RATE_HZ;
+	tiempoDormido += dormidos;
+	HAL_ResumeTick();
+	__enable_irq();
+}
+#endif
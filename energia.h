@@ -0,0 +1,101 @@
+#ifndef ENERGIA_H_
+#define ENERGIA_H_
+
+#include <stdint.h>
+
+/**
+  * @file energia.h
+  * @author EII
+  *
+  * @brief Perfiles de reloj y reposo sin tick de FreeRTOS, para alargar la batería entre mediciones.
+  *
+  * SystemClock_Config() deja SYSCLK a 72 MHz con el PLL principal (HSE 8 MHz, PLLM=4, PLLN=72, PLLP=2).
+  * Hay dos perfiles, que sólo cambian los divisores del AHB y de los APB, sin tocar el PLL:
+  *
+  * - ENERGIA_PERFIL_ALTO: HCLK 72 MHz, PCLK1 36 MHz, PCLK2 72 MHz. Mientras se usa la pantalla.
+  * - ENERGIA_PERFIL_BAJO: HCLK 36 MHz, PCLK1 36 MHz, PCLK2 36 MHz. Cuando la pantalla lleva un rato
+  *   inactiva (ver LCD_setFuncionActividad() en sincroniaLCD.h).
+  *
+  * Al no tocar el PLL el cambio no espera a que se enganche, y el reloj de punto del LTDC, que sale del
+  * PLLSAI con la misma entrada HSE/PLLM, no cambia. Tampoco PCLK1, así que el I2C de la pantalla táctil
+  * no se entera. Sí hay que ajustar, y lo hace setPerfilEnergia():
+  *
+  * - El divisor de USART1 (BRR), que cuelga de PCLK2, para conservar la velocidad en baudios.
+  * - La cuenta de refresco de la SDRAM, que depende de SDCLK = HCLK/2.
+  * - La recarga del SysTick, que cuenta ciclos de HCLK, para que el tick de FreeRTOS siga siendo de 1 ms.
+  * - El prescaler de TIM6, la base de tiempos de la HAL, que ya recalcula HAL_RCC_ClockConfig().
+  *
+  * Además sustituye a la implementación de FreeRTOS del reposo sin tick, que calcula las cuentas del
+  * SysTick con la frecuencia del arranque. Cuando todas las tareas se bloquean durante varios ticks,
+  * vPortSuppressTicksAndSleep() programa el SysTick para despertar en la siguiente tarea pendiente,
+  * detiene la interrupción de TIM6, que despertaría a la CPU cada milisegundo, y al despertar, por el
+  * SysTick o por otra interrupción como TP_INT1, suma a uwTick los milisegundos dormidos para que
+  * HAL_GetTick() no se atrase. Requiere en FreeRTOSConfig.h:
+  * @code{.c}
+  * #define configUSE_TICKLESS_IDLE 2  // Implementación propia de vPortSuppressTicksAndSleep()
+  * #define configUSE_IDLE_HOOK 0  // El gancho de main.c sólo duerme sin reposo sin tick
+  * @endcode
+  *
+  * En el simulador (LCD_SIMULADOR) sólo se contabiliza el tiempo en cada perfil.
+  *
+  * Ejemplo, dentro de main.c:
+  * @code{.c}
+  * MX_USART1_UART_Init();
+  * inicializaEnergia();  // Tras inicializar el reloj, la SDRAM y USART1
+  * ...
+  * uint32_t ms = tiempoPerfilEnergia(ENERGIA_PERFIL_BAJO);
+  * @endcode
+  */
+
+
+/**
+ * @brief Perfil de reloj
+ */
+typedef enum {
+    /** @brief HCLK a la frecuencia del PLL, para dibujar y atender la pantalla táctil */
+    ENERGIA_PERFIL_ALTO,
+    /** @brief HCLK a la mitad, con la pantalla inactiva */
+    ENERGIA_PERFIL_BAJO} PerfilEnergia;
+
+
+/**
+ * @brief Parte del perfil alto y empieza a contabilizar el tiempo
+ *
+ * Hay que llamarla después de SystemClock_Config() y de inicializar la SDRAM y USART1.
+ */
+void inicializaEnergia(void);
+
+
+/**
+ * @brief Cambia el perfil de reloj
+ *
+ * Se llama desde una tarea, nunca desde una interrupción. No espera: si hay un envío de telemetría en curso
+ * por USART1 (ver telemetria.h), detiene los siguientes y el cambio se aplica desde la interrupción de fin
+ * de envío, así que perfilEnergia() puede seguir devolviendo el perfil anterior hasta entonces.
+ *
+ * @param perfil Nuevo perfil
+ */
+void setPerfilEnergia(PerfilEnergia perfil);
+
+
+/**
+ * @brief Perfil de reloj actual
+ */
+PerfilEnergia perfilEnergia(void);
+
+
+/**
+ * @brief Tiempo en ms pasado en un perfil desde inicializaEnergia(), incluido el tramo actual
+ *
+ * @param perfil Perfil
+ */
+uint32_t tiempoPerfilEnergia(PerfilEnergia perfil);
+
+
+/**
+ * @brief Tiempo en ms que la CPU ha pasado dormida en el reposo sin tick
+ */
+uint32_t tiempoDormidoEnergia(void);
+
+
+#endif /* ENERGIA_H_ */
@@ -0,0 +1,182 @@
+#include "escenaLCD.h"
+#include <stddef.h>  // Para NULL
+#include "frameLCD.h"
+#include "fondoLCD.h"
+#include "tactilLCD.h"
+#include "indiceTactilLCD.h"
+#include "perfilado.h"
+
+
+static int visibilidadPropia(const LCD_ElementoEscena * e) {
+	switch (e->tipo) {
+	case LCD_ELEMENTO_ETIQUETA: return ((LCD_Etiqueta *) e->componente)->visible;
+	case LCD_ELEMENTO_IMAGEN: return ((LCD_Imagen *) e->componente)->visible;
+	case LCD_ELEMENTO_BOTON: return ((LCD_Boton *) e->componente)->visible;
+	case LCD_ELEMENTO_INTERRUPTOR: return ((LCD_Interruptor *) e->componente)->visible;
+	case LCD_ELEMENTO_BARRA: return ((LCD_Barra *) e->componente)->visible;
+	case LCD_ELEMENTO_EDITOR: return ((LCD_Editor *) e->componente)->visible;
+	default: return 1;
+	}
+}
+
+
+static void setVisibilidadPropia(int visible, const LCD_ElementoEscena * e) {
+	switch (e->tipo) {
+	case LCD_ELEMENTO_ETIQUETA: LCD_setVisibilidadEtiqueta(visible, e->componente); break;
+	case LCD_ELEMENTO_IMAGEN: LCD_setVisibilidadImagen(visible, e->componente); break;
+	case LCD_ELEMENTO_BOTON: LCD_setVisibilidadBoton(visible, e->componente); break;
+	case LCD_ELEMENTO_INTERRUPTOR: LCD_setVisibilidadInterruptor(visible, e->componente); break;
+	case LCD_ELEMENTO_BARRA: LCD_setVisibilidadBarra(visible, e->componente); break;
+	case LCD_ELEMENTO_EDITOR: LCD_setVisibilidadEditor(visible, e->componente); break;
+	case LCD_ELEMENTO_FUNCION: LCD_invalidaRegion(e->x, e->y, e->ancho, e->alto); break;
+	default: break;
+	}
+}
+
+
+static int completaRegion(const LCD_ElementoEscena * e) {
+// Amplía las regiones inválidas a toda la zona del componente si intersecta en parte con ellas. Las
+// funciones dibujan su zona ellas mismas y deciden qué redibujar
+
+	switch (e->tipo) {
+	case LCD_ELEMENTO_ETIQUETA: {
+		const LCD_Etiqueta * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->ancho, c->alto);
+	}
+	case LCD_ELEMENTO_IMAGEN: {
+		const LCD_Imagen * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->ancho, c->alto);
+	}
+	case LCD_ELEMENTO_BOTON: {
+		const LCD_Boton * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->ancho, c->alto);
+	}
+	case LCD_ELEMENTO_INTERRUPTOR: {
+		const LCD_Interruptor * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->ancho, c->alto);
+	}
+	case LCD_ELEMENTO_BARRA: {
+		const LCD_Barra * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->largo, c->grosor);
+	}
+	case LCD_ELEMENTO_EDITOR: {
+		const LCD_Editor * c = e->componente;
+		return LCD_completaRegionInvalida(c->x, c->y, c->ancho, c->alto);
+	}
+	default: return 0;
+	}
+}
+
+
+static int anade(LCD_ElementoEscena * nuevo, LCD_Escena * pEscena) {
+// Copia el elemento al final y lo coloca en el orden detrás de los que tienen su misma profundidad
+
+	if (pEscena->numElementos == LCD_ESCENA_ELEMENTOS || nuevo->grupo >= pEscena->numElementos ||
+			(nuevo->grupo >= 0 && pEscena->elementos[nuevo->grupo].tipo != LCD_ELEMENTO_GRUPO))
+		return -1;
+	uint8_t indice = pEscena->numElementos++;
+	const LCD_ElementoEscena * grupo = nuevo->grupo >= 0 ? &pEscena->elementos[nuevo->grupo] : NULL;
+	nuevo->oculto = grupo != NULL && (grupo->oculto || !grupo->visible);
+	if (nuevo->oculto) {  // Se añade a un grupo oculto
+		nuevo->visiblePropio = visibilidadPropia(nuevo);
+		setVisibilidadPropia(0, nuevo);
+	}
+	pEscena->elementos[indice] = *nuevo;
+
+	int i = indice;
+	while (i > 0 && pEscena->elementos[pEscena->orden[i - 1]].profundidad > nuevo->profundidad) {
+		pEscena->orden[i] = pEscena->orden[i - 1];
+		i--;
+	}
+	pEscena->orden[i] = indice;
+	return indice;
+}
+
+
+void LCD_inicializaEscena(LCD_Escena * pEscena) {
+	pEscena->numElementos = 0;
+}
+
+
+int LCD_anadeElementoEscena(LCD_TipoElemento tipo, void * componente, int grupo, uint8_t profundidad,
+	LCD_Escena * pEscena) {
+	LCD_ElementoEscena nuevo = {componente, NULL, 0, 0, 0, 0, tipo, grupo, profundidad, 1, 0, 1};
+	int indice = anade(&nuevo, pEscena);
+	if (indice >= 0)
+		LCD_setProfundidadZonaTactil(componente, profundidad);  // Sólo si el componente anotó su zona
+	return indice;
+}
+
+
+int LCD_anadeFuncionEscena(void (*atiende)(void * datos), void * datos, uint16_t x, uint16_t y, uint16_t ancho,
+	uint16_t alto, int grupo, uint8_t profundidad, LCD_Escena * pEscena) {
+	LCD_ElementoEscena nuevo = {datos, atiende, x, y, ancho, alto, LCD_ELEMENTO_FUNCION, grupo, profundidad,
+		1, 0, 1};
+	return anade(&nuevo, pEscena);
+}
+
+
+int LCD_anadeGrupoEscena(int grupo, LCD_Escena * pEscena) {
+	LCD_ElementoEscena nuevo = {NULL, NULL, 0, 0, 0, 0, LCD_ELEMENTO_GRUPO, grupo, 0, 1, 0, 1};
+	return anade(&nuevo, pEscena);
+}
+
+
+void LCD_setVisibilidadGrupoEscena(int visible, int grupo, LCD_Escena * pEscena) {
+	if (grupo < 0 || grupo >= pEscena->numElementos || pEscena->elementos[grupo].tipo != LCD_ELEMENTO_GRUPO ||
+			pEscena->elementos[grupo].visible == (visible != 0))
+		return;
+	pEscena->elementos[grupo].visible = visible != 0;
+
+	for (int i = grupo + 1; i < pEscena->numElementos; i++) {
+		// Un grupo siempre está antes que sus elementos, así que ya se ha actualizado cuando se llega a ellos.
+		// Los elementos de fuera del grupo no cambian
+		LCD_ElementoEscena * e = &pEscena->elementos[i];
+		if (e->grupo < 0)
+			continue;
+		const LCD_ElementoEscena * contenedor = &pEscena->elementos[e->grupo];
+		int oculto = contenedor->oculto || !contenedor->visible;
+		if (oculto && !e->oculto) {
+			e->visiblePropio = visibilidadPropia(e);
+			setVisibilidadPropia(0, e);
+		} else if (!oculto && e->oculto)
+			setVisibilidadPropia(e->visiblePropio, e);
+		e->oculto = oculto;
+	}
+}
+
+
+void LCD_atiendeEscena(LCD_Escena * pEscena) {
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_ESCENA);
+	LCD_atiendeEventosTactiles();  // Entrega las pulsaciones a los componentes, ver indiceTactilLCD.h
+
+	// Los componentes que intersectan en parte con las regiones inválidas se redibujan enteros sobre el
+	// fondo restaurado. Cada zona añadida puede alcanzar a otros, así que se repite hasta que no cambia nada
+	int cambios = 1;
+	for (int vuelta = 0; cambios && vuelta < pEscena->numElementos; vuelta++) {
+		cambios = 0;
+		for (int i = 0; i < pEscena->numElementos; i++) {
+			const LCD_ElementoEscena * e = &pEscena->elementos[i];
+			if (!e->oculto && visibilidadPropia(e))
+				cambios |= completaRegion(e);
+		}
+	}
+	LCD_restauraFondoRegiones();
+
+	for (int i = 0; i < pEscena->numElementos; i++) {
+		const LCD_ElementoEscena * e = &pEscena->elementos[pEscena->orden[i]];
+		if (e->oculto)
+			continue;  // Su zona ya se invalidó al ocultarlo y el fondo la ha restaurado
+		switch (e->tipo) {
+		case LCD_ELEMENTO_ETIQUETA: LCD_atiendeEtiqueta(e->componente); break;
+		case LCD_ELEMENTO_IMAGEN: LCD_atiendeImagen(e->componente); break;
+		case LCD_ELEMENTO_BOTON: LCD_atiendeBoton(e->componente); break;
+		case LCD_ELEMENTO_INTERRUPTOR: LCD_atiendeInterruptor(e->componente); break;
+		case LCD_ELEMENTO_BARRA: LCD_atiendeBarra(e->componente); break;
+		case LCD_ELEMENTO_EDITOR: LCD_atiendeEditor(e->componente); break;
+		case LCD_ELEMENTO_FUNCION: e->atiende(e->componente); break;
+		default: break;
+		}
+	}
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_ESCENA);
+}
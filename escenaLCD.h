@@ -0,0 +1,203 @@
+#ifndef ESCENALCD_H_
+#define ESCENALCD_H_
+
+#include <stdint.h>
+#include "interfazLCD.h"
+
+/**
+  * @file escenaLCD.h
+  * @author EII
+  *
+  * @brief Escena: conjunto de componentes de interfazLCD que se atienden juntos en cada frame.
+  *
+  * Sin escena, la aplicación llama en cada frame a LCD_atiendeEventosTactiles(), a
+  * LCD_restauraFondoRegiones() y a la función LCD_atiende* de cada componente, en el orden en que se tienen
+  * que dibujar. Con una escena, cada componente se añade una vez con una profundidad y
+  * LCD_atiendeEscena() hace todo eso en una sola llamada: entrega los eventos táctiles, amplía las regiones
+  * inválidas a toda la zona de los componentes que intersectan en parte con ellas (ver
+  * LCD_completaRegionInvalida() en frameLCD.h), restaura el fondo de las regiones inválidas y atiende los componentes de menor a mayor profundidad, de forma que los más
+  * profundos se dibujan encima y reciben antes las pulsaciones (ver LCD_setProfundidadZonaTactil() en
+  * indiceTactilLCD.h).
+  *
+  * Los elementos se pueden agrupar en grupos, que a su vez pueden estar dentro de otros grupos. Al ocultar
+  * un grupo se ocultan todos sus componentes con su función LCD_setVisibilidad*, de modo que se invalida su
+  * zona y dejan de recibir pulsaciones, y al mostrarlo cada componente recupera la visibilidad que tenía.
+  * Mientras el grupo está oculto no conviene cambiar la visibilidad de sus componentes.
+  *
+  * Lo que no es un componente de interfazLCD, como una gráfica, se añade como una función que se llama en
+  * su turno con un puntero a sus datos.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static LCD_Escena escena;
+  *
+  * LCD_inicializaFondo(0xFF000000, dibujaFondo);
+  * LCD_inicializaIndiceTactil();
+  * LCD_inicializaEscena(&escena);
+  * LCD_inicializaEtiqueta("Bolo", 10, 10, &juegoAlpha15, 1, 150, 20, 3, 3, LCD_ALINEACION_IZQUIERDA,
+  *      0xFFFFFFFF, 0xFF000080, 1, 1, &titulo);
+  * LCD_anadeElementoEscena(LCD_ELEMENTO_ETIQUETA, &titulo, LCD_ESCENA_SIN_GRUPO, 0, &escena);
+  *
+  * int confirmacion = LCD_anadeGrupoEscena(LCD_ESCENA_SIN_GRUPO, &escena);
+  * LCD_inicializaBoton(...&aceptar);
+  * LCD_anadeElementoEscena(LCD_ELEMENTO_BOTON, &aceptar, confirmacion, 1, &escena);
+  * LCD_setVisibilidadGrupoEscena(0, confirmacion, &escena);
+  *
+  * while(1) {
+  *     LCD_atiendeEscena(&escena);
+  *     LCD_intercambiaBuffersRegiones();
+  * }
+  * @endcode
+  */
+
+
+/** @brief Número máximo de elementos de una escena, contando los grupos */
+#ifndef LCD_ESCENA_ELEMENTOS
+#define LCD_ESCENA_ELEMENTOS 32
+#endif
+
+/** @brief Grupo de los elementos que no están dentro de ningún grupo */
+#define LCD_ESCENA_SIN_GRUPO (-1)
+
+
+/**
+ * @brief Tipo de elemento de una escena
+ */
+typedef enum {
+    /** @brief LCD_Etiqueta */
+    LCD_ELEMENTO_ETIQUETA,
+    /** @brief LCD_Imagen */
+    LCD_ELEMENTO_IMAGEN,
+    /** @brief LCD_Boton */
+    LCD_ELEMENTO_BOTON,
+    /** @brief LCD_Interruptor */
+    LCD_ELEMENTO_INTERRUPTOR,
+    /** @brief LCD_Barra */
+    LCD_ELEMENTO_BARRA,
+    /** @brief LCD_Editor */
+    LCD_ELEMENTO_EDITOR,
+    /** @brief Función de la aplicación, añadida con LCD_anadeFuncionEscena() */
+    LCD_ELEMENTO_FUNCION,
+    /** @brief Grupo de elementos, añadido con LCD_anadeGrupoEscena() */
+    LCD_ELEMENTO_GRUPO} LCD_TipoElemento;
+
+
+/**
+ * @brief Elemento de una escena
+ */
+typedef struct {
+    /** @brief Puntero a la estructura del componente, o a los datos de la función */
+    void * componente;
+    /** @brief Función que atiende al elemento, sólo en los de tipo LCD_ELEMENTO_FUNCION */
+    void (*atiende)(void * datos);
+    /** @brief Zona de pantalla que se invalida al ocultar o mostrar un elemento de tipo LCD_ELEMENTO_FUNCION */
+    uint16_t x, y, ancho, alto;
+    /** @brief Tipo de elemento */
+    uint8_t tipo;
+    /** @brief Índice del grupo al que pertenece, o LCD_ESCENA_SIN_GRUPO */
+    int8_t grupo;
+    /** @brief Profundidad del elemento */
+    uint8_t profundidad;
+    /** @brief En los grupos, buleano cierto si el grupo es visible */
+    uint8_t visible;
+    /** @brief Buleano cierto si algún grupo que lo contiene está oculto */
+    uint8_t oculto;
+    /** @brief Visibilidad propia del componente cuando se ocultó su grupo */
+    uint8_t visiblePropio;
+} LCD_ElementoEscena;
+
+
+/**
+ * @brief Escena
+ *
+ * @see LCD_inicializaEscena(), LCD_anadeElementoEscena(), LCD_anadeFuncionEscena(), LCD_anadeGrupoEscena(),
+ *     LCD_setVisibilidadGrupoEscena(), LCD_atiendeEscena()
+ */
+typedef struct {
+    /** @brief Elementos en el orden en que se añadieron. Su posición es su índice */
+    LCD_ElementoEscena elementos[LCD_ESCENA_ELEMENTOS];
+    /** @brief Índices de los elementos de menor a mayor profundidad */
+    uint8_t orden[LCD_ESCENA_ELEMENTOS];
+    /** @brief Número de elementos */
+    uint8_t numElementos;
+} LCD_Escena;
+
+
+/**
+ * @brief Inicializa una escena vacía
+ *
+ * @param pEscena Puntero a la estructura que representa a la escena
+ */
+void LCD_inicializaEscena(LCD_Escena * pEscena);
+
+
+/**
+ * @brief Añade un componente ya inicializado a la escena
+ *
+ * Los componentes con la misma profundidad se atienden en el orden en que se añaden.
+ *
+ * @param tipo Tipo del componente, de LCD_ELEMENTO_ETIQUETA a LCD_ELEMENTO_EDITOR
+ * @param componente Puntero a la estructura del componente
+ * @param grupo Índice del grupo al que pertenece, o LCD_ESCENA_SIN_GRUPO
+ * @param profundidad Profundidad del componente
+ * @param pEscena Puntero a la estructura que representa a la escena
+ * @return Índice del elemento, o -1 si la escena está llena
+ */
+int LCD_anadeElementoEscena(LCD_TipoElemento tipo, void * componente, int grupo, uint8_t profundidad,
+    LCD_Escena * pEscena);
+
+
+/**
+ * @brief Añade a la escena una función de la aplicación
+ *
+ * La función tiene que dibujar sólo lo que intersecte con las regiones inválidas (ver frameLCD.h).
+ *
+ * @param atiende Función que se llama en cada LCD_atiendeEscena()
+ * @param datos Puntero que se pasa a la función
+ * @param x Coordenada X de la esquina superior izquierda de la zona que ocupa lo que dibuja
+ * @param y Coordenada Y de la esquina superior izquierda de la zona que ocupa lo que dibuja
+ * @param ancho Ancho de esa zona
+ * @param alto Alto de esa zona
+ * @param grupo Índice del grupo al que pertenece, o LCD_ESCENA_SIN_GRUPO
+ * @param profundidad Profundidad del elemento
+ * @param pEscena Puntero a la estructura que representa a la escena
+ * @return Índice del elemento, o -1 si la escena está llena
+ */
+int LCD_anadeFuncionEscena(void (*atiende)(void * datos), void * datos, uint16_t x, uint16_t y, uint16_t ancho,
+    uint16_t alto, int grupo, uint8_t profundidad, LCD_Escena * pEscena);
+
+
+/**
+ * @brief Añade a la escena un grupo vacío y visible
+ *
+ * @param grupo Índice del grupo que lo contiene, o LCD_ESCENA_SIN_GRUPO
+ * @param pEscena Puntero a la estructura que representa a la escena
+ * @return Índice del grupo, o -1 si la escena está llena
+ */
+int LCD_anadeGrupoEscena(int grupo, LCD_Escena * pEscena);
+
+
+/**
+ * @brief Muestra u oculta todos los elementos de un grupo, incluidos los de sus grupos interiores
+ *
+ * @param visible Buleano cierto para mostrar el grupo
+ * @param grupo Índice del grupo
+ * @param pEscena Puntero a la estructura que representa a la escena
+ */
+void LCD_setVisibilidadGrupoEscena(int visible, int grupo, LCD_Escena * pEscena);
+
+
+/**
+ * @brief Atiende los eventos táctiles y dibuja los elementos visibles de la escena
+ *
+ * Sustituye en el bucle de la tarea que dibuja la pantalla a las llamadas a LCD_atiendeEventosTactiles(),
+ * LCD_restauraFondoRegiones() y a las funciones LCD_atiende* de los componentes, así que antes hay que
+ * haber inicializado el fondo con LCD_inicializaFondo() (ver fondoLCD.h). Después hay que intercambiar los
+ * buffers.
+ *
+ * @param pEscena Puntero a la estructura que representa a la escena
+ */
+void LCD_atiendeEscena(LCD_Escena * pEscena);
+
+
+#endif /* ESCENALCD_H_ */
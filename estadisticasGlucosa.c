@@ -0,0 +1,96 @@
+#include "estadisticasGlucosa.h"
+
+#if 14 * PIRAMIDE_MUESTRAS_DIA > PIRAMIDE_CAPACIDAD_MUESTRAS
+#error "La pirámide no guarda las mediciones que salen de la ventana de 14 días"
+#endif
+
+
+static const uint32_t muestrasVentana[ESTADISTICAS_NUM_VENTANAS] = {PIRAMIDE_MUESTRAS_DIA,
+	7 * PIRAMIDE_MUESTRAS_DIA, 14 * PIRAMIDE_MUESTRAS_DIA};
+
+
+void inicializaEstadisticas(EstadisticasGlucosa * pEstadisticas) {
+	for (int v = 0; v < ESTADISTICAS_NUM_VENTANAS; v++)
+		pEstadisticas->ventanas[v] = (AcumuladoEstadisticas) {0};
+}
+
+
+RangoGlucosa rangoGlucosa(int valor) {
+	if (valor < ESTADISTICAS_LIMITE_MUY_BAJO)
+		return RANGO_GLUCOSA_MUY_BAJO;
+	if (valor < ESTADISTICAS_LIMITE_BAJO)
+		return RANGO_GLUCOSA_BAJO;
+	if (valor <= ESTADISTICAS_LIMITE_ALTO)
+		return RANGO_GLUCOSA_OBJETIVO;
+	if (valor <= ESTADISTICAS_LIMITE_MUY_ALTO)
+		return RANGO_GLUCOSA_ALTO;
+	return RANGO_GLUCOSA_MUY_ALTO;
+}
+
+
+static void acumula(int valor, int signo, AcumuladoEstadisticas * a) {
+	if (valor == 0)
+		return;  // Hueco sin dato
+	a->numMuestras += signo;
+	a->suma += signo * valor;
+	a->sumaCuadrados += (int64_t) signo * valor * valor;
+	a->numRango[rangoGlucosa(valor)] += signo;
+}
+
+
+void anadeEstadisticas(int valor, const PiramideGlucosa * pPiramide, EstadisticasGlucosa * pEstadisticas) {
+	uint32_t guardadas = numMuestrasPiramide(pPiramide);
+	for (int v = 0; v < ESTADISTICAS_NUM_VENTANAS; v++) {
+		AcumuladoEstadisticas * a = &pEstadisticas->ventanas[v];
+		if (guardadas >= muestrasVentana[v])  // La ventana está llena: sale su medición más antigua
+			acumula(muestraPiramide(guardadas - muestrasVentana[v], pPiramide), -1, a);
+		acumula(valor, 1, a);
+	}
+}
+
+
+void rellenaEstadisticas(uint32_t antiguedad, int valor, EstadisticasGlucosa * pEstadisticas) {
+	for (int v = 0; v < ESTADISTICAS_NUM_VENTANAS; v++)
+		if (antiguedad < muestrasVentana[v])
+			acumula(valor, 1, &pEstadisticas->ventanas[v]);
+}
+
+
+static uint32_t raiz(uint64_t x) {
+// Raíz cuadrada entera, redondeada al más cercano
+
+	uint64_t r = 0;
+	uint64_t bit = (uint64_t) 1 << 62;
+	while (bit > x)
+		bit >>= 2;
+	while (bit != 0) {
+		if (x >= r + bit) {
+			x -= r + bit;
+			r = (r >> 1) + bit;
+		} else r >>= 1;
+		bit >>= 2;
+	}
+	return x > r ? r + 1 : r;  // x es ahora el resto: el valor original menos r al cuadrado
+}
+
+
+void calculaEstadisticas(VentanaEstadisticas ventana, const EstadisticasGlucosa * pEstadisticas,
+	ValoresEstadisticas * valores) {
+	const AcumuladoEstadisticas * a = &pEstadisticas->ventanas[ventana];
+	uint32_t n = a->numMuestras;
+	*valores = (ValoresEstadisticas) {0};
+	valores->numMuestras = n;
+	if (n == 0)
+		return;
+
+	for (int r = 0; r < NUM_RANGOS_GLUCOSA; r++)
+		valores->porcentajeRango[r] = ((uint64_t) a->numRango[r] * 1000 + n / 2) / n;
+	valores->media = ((uint64_t) a->suma * 10 + n / 2) / n;
+
+	// Varianza de la población por 100, para obtener la desviación con un decimal
+	uint64_t varianza = ((uint64_t) n * a->sumaCuadrados - (uint64_t) a->suma * a->suma) * 100 / ((uint64_t) n * n);
+	valores->desviacion = raiz(varianza);
+	if (valores->media > 0)
+		valores->coeficienteVariacion = (valores->desviacion * 1000 + valores->media / 2) / valores->media;
+	valores->gmi = (3310000 + 2392 * valores->media + 50000) / 100000;
+}
@@ -0,0 +1,186 @@
+#ifndef ESTADISTICASGLUCOSA_H_
+#define ESTADISTICASGLUCOSA_H_
+
+#include <stdint.h>
+#include "piramideGlucosa.h"
+
+/**
+  * @file estadisticasGlucosa.h
+  * @author EII
+  *
+  * @brief Estadísticas de glucosa de las últimas 24 horas, 7 días y 14 días, actualizadas con cada medición.
+  *
+  * Para cada ventana se acumulan el número de mediciones, su suma, la suma de sus cuadrados y cuántas caen
+  * en cada rango de glucosa. Al añadir una medición se suma a las tres ventanas y se resta de cada una la
+  * que sale de ella, que se lee de las mediciones sin agregar de la pirámide (ver piramideGlucosa.h), así
+  * que cada medición cuesta lo mismo sea cual sea la longitud de las ventanas. Las sumas son enteras: al
+  * restar no se acumulan errores de redondeo como con las medias y varianzas en coma flotante.
+  *
+  * calculaEstadisticas() obtiene a partir de los acumulados, también en tiempo constante:
+  *
+  * - El tiempo en cada rango, en porcentaje de las mediciones de la ventana. El rango objetivo es de 70 a
+  *   180 mg/dL.
+  * - La media y la desviación típica en mg/dL.
+  * - El coeficiente de variación, desviación típica entre media, en porcentaje.
+  * - El GMI (indicador de gestión de la glucosa), una estimación de la HbA1c a partir de la media:
+  *   GMI (%) = 3,31 + 0,02392 * media (mg/dL).
+  *
+  * Las mediciones a 0 son huecos sin dato y no cuentan en ninguna ventana. Si el hueco se rellena después
+  * (ver ingestaGlucosa.h), rellenaEstadisticas() suma la medición a las ventanas en las que sigue.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * anadeEstadisticas(valor, &piramide, &estadisticas);  // Antes de añadir la medición a la pirámide
+  * anadePiramide(valor, &piramide);
+  *
+  * ValoresEstadisticas v;
+  * calculaEstadisticas(ESTADISTICAS_VENTANA_7D, &estadisticas, &v);
+  * LCD_formateaFijo(v.porcentajeRango[RANGO_GLUCOSA_OBJETIVO], 1, texto);  // Tiempo en rango, "72.5"
+  * @endcode
+  */
+
+
+/** @brief Límite inferior en mg/dL del rango bajo. Por debajo es muy bajo */
+#define ESTADISTICAS_LIMITE_MUY_BAJO 54
+
+/** @brief Límite inferior en mg/dL del rango objetivo */
+#define ESTADISTICAS_LIMITE_BAJO 70
+
+/** @brief Límite superior en mg/dL del rango objetivo */
+#define ESTADISTICAS_LIMITE_ALTO 180
+
+/** @brief Límite superior en mg/dL del rango alto. Por encima es muy alto */
+#define ESTADISTICAS_LIMITE_MUY_ALTO 250
+
+
+/**
+ * @brief Ventanas de las estadísticas
+ */
+typedef enum {
+    /** @brief Últimas 24 horas */
+    ESTADISTICAS_VENTANA_24H,
+    /** @brief Últimos 7 días */
+    ESTADISTICAS_VENTANA_7D,
+    /** @brief Últimos 14 días. No puede superar PIRAMIDE_CAPACIDAD_MUESTRAS */
+    ESTADISTICAS_VENTANA_14D,
+    /** @brief Número de ventanas */
+    ESTADISTICAS_NUM_VENTANAS} VentanaEstadisticas;
+
+
+/**
+ * @brief Rangos de glucosa
+ */
+typedef enum {
+    /** @brief Por debajo de ESTADISTICAS_LIMITE_MUY_BAJO */
+    RANGO_GLUCOSA_MUY_BAJO,
+    /** @brief Desde ESTADISTICAS_LIMITE_MUY_BAJO hasta por debajo de ESTADISTICAS_LIMITE_BAJO */
+    RANGO_GLUCOSA_BAJO,
+    /** @brief Desde ESTADISTICAS_LIMITE_BAJO hasta ESTADISTICAS_LIMITE_ALTO, ambos incluidos */
+    RANGO_GLUCOSA_OBJETIVO,
+    /** @brief Por encima de ESTADISTICAS_LIMITE_ALTO hasta ESTADISTICAS_LIMITE_MUY_ALTO incluido */
+    RANGO_GLUCOSA_ALTO,
+    /** @brief Por encima de ESTADISTICAS_LIMITE_MUY_ALTO */
+    RANGO_GLUCOSA_MUY_ALTO,
+    /** @brief Número de rangos */
+    NUM_RANGOS_GLUCOSA} RangoGlucosa;
+
+
+/**
+ * @brief Acumulados de una ventana
+ */
+typedef struct {
+    /** @brief Número de mediciones de la ventana, sin contar los huecos */
+    uint32_t numMuestras;
+    /** @brief Suma de las mediciones */
+    uint32_t suma;
+    /** @brief Suma de los cuadrados de las mediciones */
+    uint64_t sumaCuadrados;
+    /** @brief Número de mediciones en cada rango */
+    uint32_t numRango[NUM_RANGOS_GLUCOSA];
+} AcumuladoEstadisticas;
+
+
+/**
+ * @brief Estadísticas de glucosa
+ *
+ * @see inicializaEstadisticas(), anadeEstadisticas(), calculaEstadisticas()
+ */
+typedef struct {
+    /** @brief Acumulados de cada ventana */
+    AcumuladoEstadisticas ventanas[ESTADISTICAS_NUM_VENTANAS];
+} EstadisticasGlucosa;
+
+
+/**
+ * @brief Estadísticas de una ventana, en coma fija con un decimal (725 es 72,5)
+ */
+typedef struct {
+    /** @brief Número de mediciones de la ventana. Si es 0 el resto de campos valen 0 */
+    uint32_t numMuestras;
+    /** @brief Tiempo en cada rango en porcentaje, con un decimal */
+    int32_t porcentajeRango[NUM_RANGOS_GLUCOSA];
+    /** @brief Media en mg/dL, con un decimal */
+    int32_t media;
+    /** @brief Desviación típica en mg/dL, con un decimal */
+    int32_t desviacion;
+    /** @brief Coeficiente de variación en porcentaje, con un decimal */
+    int32_t coeficienteVariacion;
+    /** @brief GMI en porcentaje, con un decimal */
+    int32_t gmi;
+} ValoresEstadisticas;
+
+
+/**
+ * @brief Vacía las estadísticas
+ *
+ * @param pEstadisticas Puntero a la estructura que representa a las estadísticas
+ */
+void inicializaEstadisticas(EstadisticasGlucosa * pEstadisticas);
+
+
+/**
+ * @brief Añade una medición a todas las ventanas y descarta las que salen de ellas, en tiempo constante
+ *
+ * Hay que llamarla con cada medición justo antes de añadirla a la pirámide, que aún guarda las mediciones
+ * que salen de las ventanas.
+ *
+ * @param valor Medición de glucosa en mg/dL, o 0 si no hay dato
+ * @param pPiramide Puntero a la pirámide de la que se leen las mediciones que salen de las ventanas
+ * @param pEstadisticas Puntero a la estructura que representa a las estadísticas
+ */
+void anadeEstadisticas(int valor, const PiramideGlucosa * pPiramide, EstadisticasGlucosa * pEstadisticas);
+
+
+/**
+ * @brief Suma a las ventanas que la contienen una medición que rellena un hueco
+ *
+ * Hay que llamarla sólo si rellenaPiramide() ha rellenado el hueco, para que la medición salga después de
+ * las ventanas con su valor.
+ *
+ * @param antiguedad Posición de la medición contando desde la más reciente, que es la 0
+ * @param valor Medición de glucosa en mg/dL
+ * @param pEstadisticas Puntero a la estructura que representa a las estadísticas
+ */
+void rellenaEstadisticas(uint32_t antiguedad, int valor, EstadisticasGlucosa * pEstadisticas);
+
+
+/**
+ * @brief Rango al que pertenece una medición
+ *
+ * @param valor Medición de glucosa en mg/dL
+ */
+RangoGlucosa rangoGlucosa(int valor);
+
+
+/**
+ * @brief Calcula las estadísticas de una ventana a partir de sus acumulados, en tiempo constante
+ *
+ * @param ventana Ventana
+ * @param pEstadisticas Puntero a las estadísticas
+ * @param valores Puntero donde se escriben las estadísticas de la ventana
+ */
+void calculaEstadisticas(VentanaEstadisticas ventana, const EstadisticasGlucosa * pEstadisticas,
+    ValoresEstadisticas * valores);
+
+
+#endif /* ESTADISTICASGLUCOSA_H_ */
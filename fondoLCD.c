@@ -0,0 +1,76 @@
+#include "fondoLCD.h"
+#include "pantallaLCD.h"
+#include "frameLCD.h"
+#include "memoriaSDRAM.h"
+#include "dma2dLCD.h"
+
+
+static uint8_t * fondo = 0;  // Copia de la capa de fondo en la SDRAM, con el formato de los frame buffers
+static uint32_t colorFondo;  // Color de fondo, para redibujar si no hay copia
+static void (*dibujaFondo)(void);  // Función que dibuja la parte fija de la pantalla
+
+
+static void copiaRegionFisica(const uint8_t * origen, uint8_t * destino, const LCD_Region * r) {
+// Copia la región 'r', en coordenadas del frame buffer, desde el buffer 'origen' al buffer 'destino'
+
+	uint32_t desplazamiento = (r->y * LCD_ANCHO_FISICO + r->x) * LCD_BYTES_PUNTO;
+	LCD_copiaBloqueDMA2D(origen + desplazamiento, destino + desplazamiento, r->ancho, r->alto);
+}
+
+
+int LCD_inicializaFondo(uint32_t color, void (*funcion)(void)) {
+	colorFondo = color;
+	dibujaFondo = funcion;
+	if (fondo == 0)
+		fondo = reservaSDRAM(LCD_TAMANO_BUFFER);
+	if (fondo == 0)
+		return 0;  // Sin copia, se redibujará cada vez
+
+	LCD_setFondoColor(colorFondo);
+	dibujaFondo();
+	LCD_Region todo = {0, 0, LCD_ANCHO_FISICO, LCD_ALTO_FISICO};
+	copiaRegionFisica(LCD_direccionBufferOculto(), fondo, &todo);
+	return 1;
+}
+
+
+void LCD_restauraFondo(void) {
+	if (fondo == 0) {
+		LCD_setFondoColor(colorFondo);
+		dibujaFondo();
+		return;
+	}
+	LCD_Region todo = {0, 0, LCD_ANCHO_FISICO, LCD_ALTO_FISICO};
+	copiaRegionFisica(fondo, LCD_direccionBufferOculto(), &todo);  // Una sola copia de bloque
+}
+
+
+void LCD_restauraFondoRegion(const LCD_Region * region) {
+	if (fondo == 0) {
+		LCD_invalidaRegion(region->x, region->y, region->ancho, region->alto);
+		// Para que la función de dibujo, que sólo dibuja en las regiones inválidas, dibuje también aquí
+		LCD_rellenaRegion(region, colorFondo);
+		dibujaFondo();
+		return;
+	}
+	LCD_Region fisica;
+	LCD_regionFisica(region, &fisica);
+	copiaRegionFisica(fondo, LCD_direccionBufferOculto(), &fisica);
+}
+
+
+void LCD_restauraFondoRegiones(void) {
+	if (fondo == 0) {
+		LCD_borraRegionesInvalidas(colorFondo);
+		dibujaFondo();
+		return;
+	}
+	if (!LCD_hayRegionesInvalidas())
+		return;
+	if (LCD_numRegionesInvalidas() == 0) {  // Gestión de regiones desactivada
+		LCD_restauraFondo();
+		return;
+	}
+	for (int i = 0; i < LCD_numRegionesInvalidas(); i++)
+		LCD_restauraFondoRegion(LCD_getRegionInvalida(i));
+}
@@ -0,0 +1,75 @@
+#ifndef FONDOLCD_H_
+#define FONDOLCD_H_
+
+#include <stdint.h>
+#include "frameLCD.h"
+
+/**
+  * @file fondoLCD.h
+  * @author EII
+  *
+  * @brief Capa de fondo precalculada para la pantalla LCD.
+  *
+  * Las partes de la pantalla que nunca cambian (ejes y etiquetas de la gráfica, cabecera, umbrales...) se
+  * dibujan una sola vez en un buffer de la SDRAM. En cada frame se restauran con una copia de bloque
+  * realizada por el DMA2D, en lugar de volver a dibujar los caracteres y las líneas una y otra vez.
+  * Después sólo hay que componer encima lo que cambia.
+  *
+  * Si se utiliza la gestión de regiones inválidas (frameLCD.h), sólo se restauran esas regiones.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * LCD_inicializa2Buffers(1);
+  * LCD_inicializaRegiones(320, 240);
+  * LCD_inicializaFondo(0x00000000, inicializaGrafica);  // Dibuja una vez la parte fija de la gráfica
+  *
+  * while(1) {
+  *     LCD_restauraFondoRegiones();  // Copia el fondo en las regiones inválidas del buffer oculto
+  *     dibujaGrafica(&historial);  // Sólo la parte variable
+  *     LCD_intercambiaBuffersRegiones();
+  * }
+  * @endcode
+  */
+
+
+/**
+ * @brief Dibuja la capa de fondo y la guarda en la SDRAM
+ *
+ * Rellena el frame buffer oculto con un color, llama a una función que dibuja la parte fija de la pantalla
+ * y copia el resultado en un buffer reservado en la SDRAM. El contenido del frame buffer oculto queda
+ * indeterminado, así que hay que llamarla antes de empezar a dibujar el primer frame.
+ *
+ * Si no hay espacio en la SDRAM, LCD_restauraFondo() y LCD_restauraFondoRegiones() vuelven a dibujar el
+ * fondo con la función indicada en cada llamada.
+ *
+ * @param colorFondo Color de fondo en formato ARGB de 32 bits
+ * @param dibujaFondo Función que dibuja la parte fija de la pantalla en el frame buffer oculto
+ * @return Buleano cierto si se pudo guardar el fondo en la SDRAM
+ */
+int LCD_inicializaFondo(uint32_t colorFondo, void (*dibujaFondo)(void));
+
+
+/**
+ * @brief Copia toda la capa de fondo en el frame buffer oculto
+ */
+void LCD_restauraFondo(void);
+
+
+/**
+ * @brief Copia la capa de fondo en una zona del frame buffer oculto
+ *
+ * @param region Zona a restaurar, en coordenadas de pantalla
+ */
+void LCD_restauraFondoRegion(const LCD_Region * region);
+
+
+/**
+ * @brief Copia la capa de fondo en las regiones inválidas del frame buffer oculto
+ *
+ * Sustituye a LCD_borraRegionesInvalidas() cuando se utiliza una capa de fondo. Si no se activó la
+ * gestión de regiones, restaura toda la pantalla.
+ */
+void LCD_restauraFondoRegiones(void);
+
+
+#endif /* FONDOLCD_H_ */
@@ -0,0 +1,107 @@
+#include "formatoLCD.h"
+#include <math.h>  // Para fmaf()
+
+
+static const int32_t potencias[LCD_MAX_DECIMALES + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+
+static char * escribeDigitos(uint32_t valor, uint8_t minimo, char * destino) {
+// Escribe 'valor' en decimal con al menos 'minimo' dígitos, rellenando con ceros a la izquierda
+
+	char digitos[10];
+	int n = 0;
+	do {
+		digitos[n++] = '0' + valor % 10;
+		valor /= 10;
+	} while (valor != 0);
+	while (n < minimo)
+		digitos[n++] = '0';
+	while (n > 0)
+		*destino++ = digitos[--n];
+	*destino = '\0';
+	return destino;
+}
+
+
+char * LCD_formateaTexto(const char * texto, char * destino) {
+	while (*texto)
+		*destino++ = *texto++;
+	*destino = '\0';
+	return destino;
+}
+
+
+char * LCD_formateaEntero(int32_t valor, char * destino) {
+	return LCD_formateaFijo(valor, 0, destino);
+}
+
+
+char * LCD_formateaNatural(uint32_t valor, char * destino) {
+	return escribeDigitos(valor, 1, destino);
+}
+
+
+char * LCD_formateaFijo(int32_t valor, uint8_t decimales, char * destino) {
+	uint32_t magnitud = valor < 0 ? 0u - (uint32_t) valor : (uint32_t) valor;  // También para INT32_MIN
+	if (decimales > LCD_MAX_DECIMALES)
+		decimales = LCD_MAX_DECIMALES;
+	if (valor < 0)
+		*destino++ = '-';
+	destino = escribeDigitos(magnitud / potencias[decimales], 1, destino);
+	if (decimales > 0) {
+		*destino++ = '.';
+		destino = escribeDigitos(magnitud % potencias[decimales], decimales, destino);
+	}
+	return destino;
+}
+
+
+int32_t LCD_realAFijo(float valor, uint8_t decimales) {
+	if (decimales > LCD_MAX_DECIMALES)
+		decimales = LCD_MAX_DECIMALES;
+	float escalado = valor * potencias[decimales];
+	if (escalado >= 2147483647.0f)
+		return INT32_MAX;
+	if (escalado <= -2147483648.0f)
+		return INT32_MIN;
+	int32_t entera = (int32_t) valor;
+	float fraccion = valor - entera;
+	if (fraccion < 0)
+		fraccion = -fraccion;
+	float escalada = fraccion * potencias[decimales];
+	// Se escala sólo la parte fraccionaria, que se resta sin error. Escalando el valor completo, el
+	// producto se redondea y un valor como 273.904999 pasaría a 27390.5
+	int32_t magnitud = (entera < 0 ? -entera : entera) * potencias[decimales] + (int32_t) escalada;
+	float resto = escalada - (int32_t) escalada;
+	if (resto == 0.5f) {  // Empate aparente: el error del producto, exacto con fmaf(), decide
+		float error = fmaf(fraccion, potencias[decimales], -escalada);
+		if (error > 0 || (error == 0 && (magnitud & 1)))  // Los empates reales, al par, como printf()
+			magnitud++;
+	} else if (resto > 0.5f)
+		magnitud++;
+	return valor < 0 ? -magnitud : magnitud;
+}
+
+
+float LCD_fijoAReal(int32_t valor, uint8_t decimales) {
+	if (decimales > LCD_MAX_DECIMALES)
+		decimales = LCD_MAX_DECIMALES;
+	return (float) valor / potencias[decimales];
+}
+
+
+char * LCD_formateaReal(float valor, uint8_t decimales, char * destino) {
+	int32_t fijo = LCD_realAFijo(valor, decimales);
+	if (fijo == 0 && valor < 0)
+		*destino++ = '-';  // printf() conserva el signo de los negativos que se redondean a cero
+	return LCD_formateaFijo(fijo, decimales, destino);
+}
+
+
+char * LCD_completaEspacios(char * inicio, char * fin, uint8_t ancho) {
+	while (fin - inicio < ancho)
+		*fin++ = ' ';
+	*fin = '\0';
+	return fin;
+}
@@ -0,0 +1,141 @@
+#ifndef FORMATOLCD_H_
+#define FORMATOLCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file formatoLCD.h
+  * @author EII
+  *
+  * @brief Conversión de números a texto sin sprintf().
+  *
+  * Los componentes de la interfaz formatean sus valores en cada frame. sprintf() arrastra toda la
+  * maquinaria de printf de newlib, incluido el soporte de números reales, y en cada llamada interpreta
+  * la cadena de formato. Estas funciones escriben directamente los dígitos, sin reservar memoria, y
+  * obtienen el mismo texto que los formatos equivalentes:
+  *
+  * | Función                 | Formato equivalente |
+  * |-------------------------|---------------------|
+  * | LCD_formateaTexto()     | "%s"                |
+  * | LCD_formateaEntero()    | "%d"                |
+  * | LCD_formateaNatural()   | "%u"                |
+  * | LCD_formateaFijo()      | "%.<decimales>f" de valor / 10^decimales |
+  * | LCD_formateaReal()      | "%.<decimales>f"    |
+  * | LCD_completaEspacios()  | "%-<ancho>s"        |
+  *
+  * Cada función escribe a partir de 'destino', termina la cadena con '\0' y devuelve un puntero a ese
+  * terminador, para poder encadenar varias llamadas. El llamador tiene que reservar espacio suficiente:
+  * un entero ocupa como mucho LCD_LONGITUD_ENTERO caracteres más el terminador.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * char cadena[20];
+  * char * p = LCD_formateaEntero(nivel, cadena);  // Igual que sprintf(cadena, "%d mg/dL", nivel)
+  * LCD_formateaTexto(" mg/dL", p);
+  *
+  * p = LCD_formateaTexto("Dosis ", cadena);  // Igual que sprintf(cadena, "Dosis %-6.2f", 2.35)
+  * p = LCD_formateaFijo(235, 2, p);  // 2.35 expresado en centésimas
+  * LCD_completaEspacios(cadena + 6, p, 6);  // "Dosis 2.35  "
+  * @endcode
+  */
+
+
+/** @brief Máximo número de caracteres de un entero de 32 bits con signo, sin el terminador */
+#define LCD_LONGITUD_ENTERO 11
+
+/** @brief Máximo número de decimales de LCD_formateaFijo() y LCD_formateaReal() */
+#define LCD_MAX_DECIMALES 9
+
+
+/**
+ * @brief Copia una cadena
+ *
+ * @param texto Cadena a copiar
+ * @param destino Dirección donde se escribe
+ * @return Puntero al terminador de la cadena escrita
+ */
+char * LCD_formateaTexto(const char * texto, char * destino);
+
+
+/**
+ * @brief Escribe un entero en decimal, con signo si es negativo
+ *
+ * @param valor Entero a escribir
+ * @param destino Dirección donde se escribe
+ * @return Puntero al terminador de la cadena escrita
+ */
+char * LCD_formateaEntero(int32_t valor, char * destino);
+
+
+/**
+ * @brief Escribe un entero sin signo en decimal
+ *
+ * @param valor Entero a escribir
+ * @param destino Dirección donde se escribe
+ * @return Puntero al terminador de la cadena escrita
+ */
+char * LCD_formateaNatural(uint32_t valor, char * destino);
+
+
+/**
+ * @brief Escribe un número en coma fija decimal
+ *
+ * El número se da como un entero en unidades de 10^-decimales: con 2 decimales, 1234 se escribe como
+ * "12.34" y -5 como "-0.05". Siempre se escriben todos los decimales.
+ *
+ * @param valor Número en unidades de 10^-decimales
+ * @param decimales Número de decimales, como mucho LCD_MAX_DECIMALES. Con 0 es igual que LCD_formateaEntero()
+ * @param destino Dirección donde se escribe
+ * @return Puntero al terminador de la cadena escrita
+ */
+char * LCD_formateaFijo(int32_t valor, uint8_t decimales, char * destino);
+
+
+/**
+ * @brief Convierte un real a coma fija decimal, redondeando al más cercano
+ *
+ * Los empates se redondean al par, como printf(). Los valores que no caben en 32 bits se saturan.
+ *
+ * @param valor Número real
+ * @param decimales Número de decimales, como mucho LCD_MAX_DECIMALES
+ * @return El valor en unidades de 10^-decimales
+ */
+int32_t LCD_realAFijo(float valor, uint8_t decimales);
+
+
+/**
+ * @brief Convierte un número en coma fija decimal a real
+ *
+ * @param valor Número en unidades de 10^-decimales
+ * @param decimales Número de decimales, como mucho LCD_MAX_DECIMALES
+ * @return El valor como real, con el redondeo propio de un float
+ */
+float LCD_fijoAReal(int32_t valor, uint8_t decimales);
+
+
+/**
+ * @brief Escribe un real con un número fijo de decimales
+ *
+ * Equivale a LCD_formateaFijo(LCD_realAFijo(valor, decimales), decimales, destino), salvo que, como
+ * printf(), escribe "-0" para los negativos que se redondean a cero.
+ *
+ * @param valor Número real
+ * @param decimales Número de decimales, como mucho LCD_MAX_DECIMALES
+ * @param destino Dirección donde se escribe
+ * @return Puntero al terminador de la cadena escrita
+ */
+char * LCD_formateaReal(float valor, uint8_t decimales, char * destino);
+
+
+/**
+ * @brief Añade espacios al final de una cadena hasta que tenga un ancho mínimo
+ *
+ * @param inicio Principio de la parte de la cadena que tiene que ocupar 'ancho' caracteres
+ * @param fin Terminador de la cadena
+ * @param ancho Número mínimo de caracteres desde 'inicio'
+ * @return Puntero al nuevo terminador de la cadena
+ */
+char * LCD_completaEspacios(char * inicio, char * fin, uint8_t ancho);
+
+
+#endif /* FORMATOLCD_H_ */
@@ -0,0 +1,249 @@
+#include "frameLCD.h"
+#include "pantallaLCD.h"
+#include "dma2dLCD.h"
+#include "perfilado.h"
+
+
+static LCD_Region regiones[2][LCD_MAX_REGIONES];  // Regiones inválidas de cada frame buffer
+static int numRegiones[2];  // Número de regiones inválidas de cada frame buffer
+static int bufferOculto;  // Índice (0 o 1) del frame buffer oculto, donde se está dibujando
+static int bufferModificado = 0;  // Buleano cierto si se dibujó en el buffer oculto sin invalidar
+static int regionesActivas = 0;  // Buleano cierto si se llamó a LCD_inicializaRegiones()
+static uint16_t anchoPantalla, altoPantalla;  // Dimensiones según la orientación de la pantalla
+
+
+static int intersectan(const LCD_Region * a, uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto) {
+// Devuelve un buleano indicando si la región 'a' y el rectángulo indicado tienen algún punto en común
+
+	return a->x < x + ancho && x < a->x + a->ancho && a->y < y + alto && y < a->y + a->alto;
+}
+
+
+static int contiene(const LCD_Region * a, const LCD_Region * b) {
+// Devuelve un buleano indicando si la región 'a' contiene completamente a la región 'b'
+
+	return b->x >= a->x && b->y >= a->y && b->x + b->ancho <= a->x + a->ancho &&
+		b->y + b->alto <= a->y + a->alto;
+}
+
+
+static void envuelve(LCD_Region * a, const LCD_Region * b) {
+// Amplía la región 'a' para que sea el rectángulo envolvente de 'a' y 'b'
+
+	uint16_t x2 = a->x + a->ancho, y2 = a->y + a->alto;
+	if (b->x + b->ancho > x2) x2 = b->x + b->ancho;
+	if (b->y + b->alto > y2) y2 = b->y + b->alto;
+	if (b->x < a->x) a->x = b->x;
+	if (b->y < a->y) a->y = b->y;
+	a->ancho = x2 - a->x;
+	a->alto = y2 - a->y;
+}
+
+
+static void anadeRegion(int buffer, const LCD_Region * r) {
+// Anota la región 'r' en la lista del frame buffer indicado, evitando duplicados
+
+	LCD_Region * lista = regiones[buffer];
+	for (int i = 0; i < numRegiones[buffer]; i++) {
+		if (contiene(&lista[i], r))  // Ya estaba cubierta por otra región
+			return;
+		if (contiene(r, &lista[i])) {  // Cubre a una región anterior, la sustituye
+			lista[i] = *r;
+			return;
+		}
+	}
+	if (numRegiones[buffer] < LCD_MAX_REGIONES)
+		lista[numRegiones[buffer]++] = *r;
+	else {  // Lista llena: se fusiona todo en el rectángulo envolvente
+		for (int i = 1; i < numRegiones[buffer]; i++)
+			envuelve(&lista[0], &lista[i]);
+		envuelve(&lista[0], r);
+		numRegiones[buffer] = 1;
+	}
+}
+
+
+void LCD_inicializaRegiones(uint16_t ancho, uint16_t alto) {
+	anchoPantalla = ancho;
+	altoPantalla = alto;
+	bufferOculto = 0;
+	regionesActivas = 1;
+	LCD_invalidaPantalla();
+}
+
+
+int LCD_regionesActivas(void) {
+	return regionesActivas;
+}
+
+
+uint16_t LCD_anchoPantalla(void) {
+	return anchoPantalla;
+}
+
+
+uint16_t LCD_altoPantalla(void) {
+	return altoPantalla;
+}
+
+
+void LCD_invalidaRegion(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto) {
+	if (!regionesActivas || x >= anchoPantalla || y >= altoPantalla || ancho == 0 || alto == 0)
+		return;
+	LCD_Region r = {x, y, ancho, alto};
+	if (x + ancho > anchoPantalla) r.ancho = anchoPantalla - x;
+	if (y + alto > altoPantalla) r.alto = altoPantalla - y;
+	// Recorta la región a las dimensiones de la pantalla
+
+	anadeRegion(0, &r);
+	anadeRegion(1, &r);
+	// Los dos frame buffers tienen que redibujar la zona
+}
+
+
+void LCD_invalidaPantalla(void) {
+	LCD_Region r = {0, 0, anchoPantalla, altoPantalla};
+	for (int b = 0; b < 2; b++) {
+		regiones[b][0] = r;
+		numRegiones[b] = 1;
+	}
+}
+
+
+int LCD_intersectaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto) {
+	if (!regionesActivas)  // Sin gestión de regiones se redibuja siempre todo
+		return 1;
+	for (int i = 0; i < numRegiones[bufferOculto]; i++)
+		if (intersectan(&regiones[bufferOculto][i], x, y, ancho, alto))
+			return 1;
+	return 0;
+}
+
+
+int LCD_cubiertaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto) {
+	if (!regionesActivas)
+		return 1;
+	LCD_Region r = {x, y, ancho, alto};
+	for (int i = 0; i < numRegiones[bufferOculto]; i++)
+		if (contiene(&regiones[bufferOculto][i], &r))
+			return 1;
+	return 0;
+}
+
+
+int LCD_completaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto) {
+	if (!regionesActivas || x >= anchoPantalla || y >= altoPantalla || ancho == 0 || alto == 0)
+		return 0;
+	LCD_Region r = {x, y, ancho, alto};
+	if (x + ancho > anchoPantalla) r.ancho = anchoPantalla - x;
+	if (y + alto > altoPantalla) r.alto = altoPantalla - y;
+	if (!LCD_intersectaRegionInvalida(r.x, r.y, r.ancho, r.alto) || LCD_cubiertaRegionInvalida(r.x, r.y,
+			r.ancho, r.alto))
+		return 0;
+	anadeRegion(bufferOculto, &r);  // Sólo en el buffer oculto: el otro tiene sus propias regiones
+	return 1;
+}
+
+
+int LCD_hayRegionesInvalidas(void) {
+	return !regionesActivas || numRegiones[bufferOculto] > 0;
+}
+
+
+void LCD_marcaBufferModificado(void) {
+	bufferModificado = 1;
+}
+
+
+int LCD_hayCambiosBufferOculto(void) {
+	return bufferModificado || LCD_hayRegionesInvalidas();
+}
+
+
+int LCD_numRegionesInvalidas(void) {
+	return numRegiones[bufferOculto];
+}
+
+
+const LCD_Region * LCD_getRegionInvalida(int indice) {
+	return &regiones[bufferOculto][indice];
+}
+
+
+uint32_t LCD_areaRegionesInvalidas(void) {
+	if (!regionesActivas)
+		return LCD_ANCHO_FISICO * LCD_ALTO_FISICO;
+	uint32_t area = 0;
+	for (int i = 0; i < numRegiones[bufferOculto]; i++)
+		area += regiones[bufferOculto][i].ancho * regiones[bufferOculto][i].alto;
+	return area;
+}
+
+
+void LCD_borraRegionesInvalidas(uint32_t colorFondo) {
+	if (!regionesActivas) {
+		LCD_setFondoColor(colorFondo);
+		return;
+	}
+	for (int i = 0; i < numRegiones[bufferOculto]; i++)
+		LCD_rellenaRegion(&regiones[bufferOculto][i], colorFondo);
+}
+
+
+void LCD_rellenaRegion(const LCD_Region * region, uint32_t color) {
+	LCD_Region fisica;
+	LCD_regionFisica(region, &fisica);
+	LCD_rellenaBloqueDMA2D(color, LCD_direccionPuntoFisico(fisica.x, fisica.y), fisica.ancho, fisica.alto);
+}
+
+
+uint8_t * LCD_direccionPuntoFisico(uint16_t x, uint16_t y) {
+	return LCD_direccionBufferOculto() + (y * LCD_ANCHO_FISICO + x) * LCD_BYTES_PUNTO;
+}
+
+
+uint8_t * LCD_direccionBufferOculto(void) {
+	int indice = (bufferOculto + LCD_PRIMER_BUFFER_OCULTO) & 1;
+	return (uint8_t *) LCD_DIRECCION_BUFFERS + indice * LCD_TAMANO_BUFFER;
+}
+
+
+void LCD_regionFisica(const LCD_Region * region, LCD_Region * fisica) {
+	if (anchoPantalla > altoPantalla) {  // Horizontal: la pantalla está girada 90 grados
+		fisica->x = LCD_ANCHO_FISICO - region->y - region->alto;
+		fisica->y = region->x;
+		fisica->ancho = region->alto;
+		fisica->alto = region->ancho;
+	} else *fisica = *region;
+}
+
+
+int LCD_indiceBufferOculto(void) {
+	return bufferOculto;
+}
+
+
+void LCD_desplazaRegionIzquierda(const LCD_Region * region, uint16_t columnas) {
+	if (columnas == 0 || columnas >= region->ancho)
+		return;
+	LCD_Region origen = {region->x + columnas, region->y, region->ancho - columnas, region->alto};
+	LCD_Region destino = {region->x, region->y, region->ancho - columnas, region->alto};
+	LCD_Region fisicaOrigen, fisicaDestino;
+	LCD_regionFisica(&origen, &fisicaOrigen);
+	LCD_regionFisica(&destino, &fisicaDestino);
+	LCD_copiaBloqueDMA2D(LCD_direccionPuntoFisico(fisicaOrigen.x, fisicaOrigen.y),
+		LCD_direccionPuntoFisico(fisicaDestino.x, fisicaDestino.y), fisicaOrigen.ancho, fisicaOrigen.alto);
+	// El destino está siempre en direcciones menores que el origen, así que la copia no pisa puntos
+	// que aún no se han leído
+}
+
+
+void LCD_intercambiaBuffersRegiones(void) {
+	LCD_esperaDMA2D();  // No se puede mostrar el buffer con una transferencia a medias
+	PERFIL_INICIO(PERFIL_ZONA_INTERCAMBIA_BUFFERS);
+	LCD_intercambiaBuffers();
+	PERFIL_FIN(PERFIL_ZONA_INTERCAMBIA_BUFFERS);
+	numRegiones[bufferOculto] = 0;  // El buffer que se acaba de dibujar ya está al día
+	bufferModificado = 0;
+	bufferOculto = !bufferOculto;  // Ahora se dibuja en el otro
+}
@@ -0,0 +1,305 @@
+#ifndef FRAMELCD_H_
+#define FRAMELCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file frameLCD.h
+  * @author EII
+  *
+  * @brief Gestión de regiones inválidas (dirty rectangles) para el doble frame buffer de la pantalla LCD.
+  *
+  * En lugar de borrar y redibujar toda la pantalla en cada frame, los componentes de interfazLCD
+  * marcan como inválidas únicamente las zonas rectangulares que cambian (por ejemplo, al modificar el
+  * texto de una etiqueta o el valor de una barra). En cada frame sólo se borran y se redibujan los
+  * componentes que intersectan con esas zonas.
+  *
+  * Como se utilizan dos frame buffers, cada región inválida se anota para los dos buffers: el buffer
+  * oculto actual y el que está visible, que se convertirá en oculto tras el siguiente intercambio y
+  * todavía contiene el contenido anterior. Las regiones de un buffer se descartan cuando se intercambian
+  * los buffers después de haberlo redibujado.
+  *
+  * Si no se llama a LCD_inicializaRegiones(), todas las consultas indican que cualquier zona es inválida,
+  * de forma que las aplicaciones que redibujan toda la pantalla en cada frame siguen funcionando igual.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * LCD_inicializa2Buffers(1);  // Pantalla horizontal con doble frame buffer
+  * LCD_inicializaRegiones(320, 240);  // Activa la gestión de regiones inválidas. Toda la pantalla es inválida
+  *
+  * while(1) {
+  *     LCD_setTextoEtiqueta(cadena, &etiqueta);  // Invalida la etiqueta sólo si cambia el texto
+  *     LCD_borraRegionesInvalidas(0xFF000000);  // Borra únicamente las zonas inválidas del buffer oculto
+  *     LCD_atiendeEtiqueta(&etiqueta);  // Sólo se redibuja si intersecta con alguna zona inválida
+  *     LCD_intercambiaBuffersRegiones();  // Intercambia los buffers y descarta las regiones ya redibujadas
+  * }
+  * @endcode
+  */
+
+
+#ifdef LCD_SIMULADOR
+/** @brief SDRAM simulada, en la que pantallaLCD del simulador coloca los frame buffers */
+extern uint8_t simuladorSDRAM[];
+#define LCD_DIRECCION_BUFFERS ((uintptr_t) simuladorSDRAM)
+#endif
+
+/** @brief Dirección en la SDRAM del primer frame buffer. El segundo está a continuación */
+#ifndef LCD_DIRECCION_BUFFERS
+#define LCD_DIRECCION_BUFFERS 0xD0000000u
+#endif
+
+/** @brief Ancho físico del panel en puntos, con el panel en vertical */
+#define LCD_ANCHO_FISICO 240
+
+/** @brief Alto físico del panel en puntos, con el panel en vertical */
+#define LCD_ALTO_FISICO 320
+
+/** @brief Bytes por punto en los frame buffers: 2 si se compila con LCD_FORMATO_RGB565, el formato de la
+ *     capa del LTDC, o 4 con el formato ARGB de 32 bits */
+#ifdef LCD_FORMATO_RGB565
+#define LCD_BYTES_PUNTO 2
+#else
+#define LCD_BYTES_PUNTO 4
+#endif
+
+/** @brief Tamaño en bytes de cada frame buffer */
+#define LCD_TAMANO_BUFFER (LCD_ANCHO_FISICO * LCD_ALTO_FISICO * LCD_BYTES_PUNTO)
+
+/** @brief Índice del frame buffer oculto justo después de LCD_inicializa2Buffers(): se muestra el primero
+ *     y se dibuja en el segundo */
+#define LCD_PRIMER_BUFFER_OCULTO 1
+
+
+/** @brief Número máximo de regiones inválidas que se recuerdan por frame buffer. Si se supera, las regiones
+ *     se fusionan en su rectángulo envolvente */
+#ifndef LCD_MAX_REGIONES
+#define LCD_MAX_REGIONES 16
+#endif
+
+
+/**
+ * @brief Zona rectangular de la pantalla
+ */
+typedef struct {
+    /** @brief Coordenada X de la esquina superior izquierda */
+    uint16_t x;
+    /** @brief Coordenada Y de la esquina superior izquierda */
+    uint16_t y;
+    /** @brief Ancho en puntos */
+    uint16_t ancho;
+    /** @brief Alto en puntos */
+    uint16_t alto;
+} LCD_Region;
+
+
+/**
+ * @brief Activa la gestión de regiones inválidas
+ *
+ * Hay que llamarla después de inicializar la pantalla. Inicialmente toda la pantalla se considera inválida
+ * en los dos frame buffers.
+ *
+ * @param ancho Ancho de la pantalla en puntos según su orientación (320 en horizontal)
+ * @param alto Alto de la pantalla en puntos según su orientación (240 en horizontal)
+ */
+void LCD_inicializaRegiones(uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Indica si se activó la gestión de regiones con LCD_inicializaRegiones()
+ */
+int LCD_regionesActivas(void);
+
+
+/**
+ * @brief Ancho de la pantalla en puntos según su orientación, o 0 si no se activó la gestión de regiones
+ */
+uint16_t LCD_anchoPantalla(void);
+
+
+/**
+ * @brief Alto de la pantalla en puntos según su orientación, o 0 si no se activó la gestión de regiones
+ */
+uint16_t LCD_altoPantalla(void);
+
+
+/**
+ * @brief Marca una zona rectangular como inválida
+ *
+ * La zona se recorta a las dimensiones de la pantalla y se anota en los dos frame buffers.
+ *
+ * @param x Coordenada X de la esquina superior izquierda
+ * @param y Coordenada Y de la esquina superior izquierda
+ * @param ancho Ancho en puntos
+ * @param alto Alto en puntos
+ */
+void LCD_invalidaRegion(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Marca toda la pantalla como inválida en los dos frame buffers
+ */
+void LCD_invalidaPantalla(void);
+
+
+/**
+ * @brief Indica si una zona rectangular intersecta con alguna región inválida del buffer oculto
+ *
+ * Los componentes la utilizan para decidir si tienen que redibujarse en el frame actual.
+ *
+ * @return Buleano cierto si hay que redibujar la zona. Siempre es cierto si no se activó la gestión
+ *     de regiones con LCD_inicializaRegiones()
+ */
+int LCD_intersectaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Indica si una zona rectangular está completamente dentro de una región inválida del buffer oculto
+ *
+ * @return Buleano cierto si toda la zona se va a redibujar en el frame actual
+ */
+int LCD_cubiertaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Amplía las regiones inválidas del buffer oculto a toda una zona que intersecta en parte con ellas
+ *
+ * Los componentes se redibujan enteros en cuanto intersectan con una región inválida, pero el fondo sólo
+ * se restaura dentro de las regiones. Lo semitransparente, como los botones desactivados, los bordes de
+ * las imágenes con alfa o el texto suavizado, se mezclaría fuera de ellas con lo que ya había dibujado y
+ * se iría acumulando. Se llama con la zona de cada componente antes de LCD_restauraFondoRegiones(), como
+ * hace LCD_atiendeEscena(), hasta que ninguna llamada amplíe nada.
+ *
+ * @return Buleano cierto si se ha añadido la zona, recortada a la pantalla, como región inválida
+ */
+int LCD_completaRegionInvalida(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto);
+
+
+/**
+ * @brief Indica si hay alguna región inválida en el buffer oculto
+ *
+ * @return Buleano cierto si hay algo que redibujar en el frame actual
+ */
+int LCD_hayRegionesInvalidas(void);
+
+
+/**
+ * @brief Anota que se ha dibujado en el buffer oculto fuera de las regiones inválidas
+ *
+ * La llaman los componentes que actualizan su zona sin invalidarla, como la gráfica al desplazarse, para
+ * que el frame se muestre aunque no haya regiones inválidas. Se olvida al intercambiar los buffers.
+ */
+void LCD_marcaBufferModificado(void);
+
+
+/**
+ * @brief Indica si el buffer oculto tiene algo nuevo que mostrar
+ *
+ * @return Buleano cierto si hay regiones inválidas o se llamó a LCD_marcaBufferModificado() desde el
+ *     último intercambio
+ */
+int LCD_hayCambiosBufferOculto(void);
+
+
+/**
+ * @brief Número de regiones inválidas en el buffer oculto
+ */
+int LCD_numRegionesInvalidas(void);
+
+
+/**
+ * @brief Obtiene una de las regiones inválidas del buffer oculto
+ *
+ * @param indice Índice de la región, entre 0 y LCD_numRegionesInvalidas() - 1
+ * @return Puntero a la región
+ */
+const LCD_Region * LCD_getRegionInvalida(int indice);
+
+
+/**
+ * @brief Suma de las áreas en puntos de las regiones inválidas del buffer oculto
+ *
+ * Es el número de puntos que se redibujan en el frame actual. Las regiones pueden solaparse, así que es
+ * una cota superior. Sin gestión de regiones es el área de toda la pantalla.
+ */
+uint32_t LCD_areaRegionesInvalidas(void);
+
+
+/**
+ * @brief Rellena con un color las regiones inválidas del buffer oculto
+ *
+ * Sustituye a LCD_setFondoColor() cuando se utiliza la gestión de regiones: sólo se borran las zonas
+ * que se van a redibujar. Cada zona se rellena con el DMA2D directamente en el formato de los frame buffers.
+ *
+ * @param colorFondo Color en formato ARGB de 32 bits
+ */
+void LCD_borraRegionesInvalidas(uint32_t colorFondo);
+
+
+/**
+ * @brief Dirección del frame buffer oculto, donde se está dibujando
+ *
+ * Sólo es correcta si todos los intercambios de buffers se hacen con LCD_intercambiaBuffersRegiones().
+ */
+uint8_t * LCD_direccionBufferOculto(void);
+
+
+/**
+ * @brief Índice (0 o 1) del frame buffer oculto
+ *
+ * Permite a los componentes recordar qué han dibujado en cada uno de los dos frame buffers.
+ */
+int LCD_indiceBufferOculto(void);
+
+
+/**
+ * @brief Desplaza hacia la izquierda el contenido de una zona del frame buffer oculto
+ *
+ * Se realiza con una única copia de bloque. Las últimas columnas de la zona conservan su contenido
+ * anterior, así que hay que redibujarlas.
+ *
+ * @param region Zona a desplazar, en coordenadas de pantalla
+ * @param columnas Número de puntos que se desplaza
+ */
+void LCD_desplazaRegionIzquierda(const LCD_Region * region, uint16_t columnas);
+
+
+/**
+ * @brief Convierte una región en coordenadas de pantalla a coordenadas físicas del frame buffer
+ *
+ * En orientación vertical coinciden. En horizontal el punto (x, y) de la pantalla se guarda en la
+ * columna LCD_ANCHO_FISICO - 1 - y y en la fila x del frame buffer.
+ *
+ * @param region Región en coordenadas de pantalla
+ * @param fisica Puntero donde se copia la región en coordenadas del frame buffer
+ */
+void LCD_regionFisica(const LCD_Region * region, LCD_Region * fisica);
+
+
+/**
+ * @brief Rellena con un color una zona del frame buffer oculto
+ *
+ * @param region Zona a rellenar, en coordenadas de pantalla
+ * @param color Color en formato ARGB de 32 bits. Con frame buffers RGB565 se descarta el canal alfa
+ */
+void LCD_rellenaRegion(const LCD_Region * region, uint32_t color);
+
+
+/**
+ * @brief Dirección de un punto del frame buffer oculto
+ *
+ * @param x Columna física, entre 0 y LCD_ANCHO_FISICO - 1
+ * @param y Fila física, entre 0 y LCD_ALTO_FISICO - 1
+ */
+uint8_t * LCD_direccionPuntoFisico(uint16_t x, uint16_t y);
+
+
+/**
+ * @brief Intercambia los frame buffers y descarta las regiones ya redibujadas
+ *
+ * Sustituye a LCD_intercambiaBuffers() cuando se utiliza la gestión de regiones. Las regiones del
+ * buffer que se acaba de dibujar se descartan y pasan a consultarse las del nuevo buffer oculto.
+ */
+void LCD_intercambiaBuffersRegiones(void);
+
+
+#endif /* FRAMELCD_H_ */
@@ -0,0 +1,177 @@
+#include "historialGlucosa.h"
+
+
+void inicializaHistorial(HistorialGlucosa * pHistorial) {
+	pHistorial->cabeza = 0;
+	pHistorial->cola = 0;
+	pHistorial->numMuestras = 0;
+	pHistorial->totalMuestras = 0;
+}
+
+
+static void marcaHueco(uint32_t posicion, int hueco, HistorialGlucosa * pHistorial) {
+	if (hueco)
+		pHistorial->huecos[posicion / 32] |= 1u << (posicion % 32);
+	else pHistorial->huecos[posicion / 32] &= ~(1u << (posicion % 32));
+}
+
+
+static int esHueco(uint32_t posicion, const HistorialGlucosa * pHistorial) {
+	return (pHistorial->huecos[posicion / 32] >> (posicion % 32)) & 1;
+}
+
+
+void anadeHistorial(int valor, HistorialGlucosa * pHistorial) {
+	pHistorial->valores[pHistorial->cabeza] = valor;
+	marcaHueco(pHistorial->cabeza, 0, pHistorial);
+	pHistorial->totalMuestras++;
+	if (++pHistorial->cabeza == HISTORIAL_CAPACIDAD)
+		pHistorial->cabeza = 0;
+	if (pHistorial->numMuestras < HISTORIAL_CAPACIDAD)
+		pHistorial->numMuestras++;
+	else pHistorial->cola = pHistorial->cabeza;  // Se ha sobrescrito la medición más antigua
+}
+
+
+void anadeHuecoHistorial(HistorialGlucosa * pHistorial) {
+	uint32_t posicion = pHistorial->cabeza;
+	anadeHistorial(0, pHistorial);
+	marcaHueco(posicion, 1, pHistorial);
+}
+
+
+int rellenaHistorial(uint32_t antiguedad, int valor, HistorialGlucosa * pHistorial) {
+	if (antiguedad >= pHistorial->numMuestras)
+		return 0;
+	uint32_t posicion = (pHistorial->cabeza + HISTORIAL_CAPACIDAD - 1 - antiguedad) % HISTORIAL_CAPACIDAD;
+	if (!esHueco(posicion, pHistorial))
+		return 0;
+	pHistorial->valores[posicion] = valor;
+	marcaHueco(posicion, 0, pHistorial);
+	return 1;
+}
+
+
+uint32_t numMuestrasHistorial(const HistorialGlucosa * pHistorial) {
+	return pHistorial->numMuestras;
+}
+
+
+uint32_t totalMuestrasHistorial(const HistorialGlucosa * pHistorial) {
+	return pHistorial->totalMuestras;
+}
+
+
+int ultimaMuestraHistorial(const HistorialGlucosa * pHistorial) {
+	if (pHistorial->numMuestras == 0)
+		return 0;
+	return pHistorial->valores[pHistorial->cabeza == 0 ? HISTORIAL_CAPACIDAD - 1 : pHistorial->cabeza - 1];
+}
+
+
+void inicializaIteradorHistorial(uint32_t numUltimas, const HistorialGlucosa * pHistorial,
+	IteradorHistorial * pIterador) {
+	if (numUltimas > pHistorial->numMuestras)
+		numUltimas = pHistorial->numMuestras;
+	pIterador->historial = pHistorial;
+	pIterador->restantes = numUltimas;
+	pIterador->hueco = 0;
+	pIterador->posicion = pHistorial->cola + (pHistorial->numMuestras - numUltimas);
+	if (pIterador->posicion >= HISTORIAL_CAPACIDAD)
+		pIterador->posicion -= HISTORIAL_CAPACIDAD;
+	// Salta las mediciones más antiguas que no hay que recorrer
+}
+
+
+int siguienteHistorial(IteradorHistorial * pIterador, int * valor) {
+	if (pIterador->restantes == 0)
+		return 0;
+	*valor = pIterador->historial->valores[pIterador->posicion];
+	pIterador->hueco = esHueco(pIterador->posicion, pIterador->historial);
+	if (++pIterador->posicion == HISTORIAL_CAPACIDAD)
+		pIterador->posicion = 0;
+	pIterador->restantes--;
+	return 1;
+}
+
+
+int esHuecoHistorial(const IteradorHistorial * pIterador) {
+	return pIterador->hueco;
+}
+
+
+void inicializaResumenHistorial(uint32_t muestrasPorColumna, ResumenHistorial * pResumen) {
+	pResumen->muestrasPorColumna = muestrasPorColumna > 0 ? muestrasPorColumna : 1;
+	pResumen->cabeza = 0;
+	pResumen->numColumnas = 0;
+	pResumen->enColumna = 0;
+	pResumen->totalMuestras = 0;
+}
+
+
+void anadeResumenHistorial(int valor, ResumenHistorial * pResumen) {
+	if (pResumen->numColumnas == 0 || pResumen->enColumna == pResumen->muestrasPorColumna) {
+		// Empieza una columna nueva, sobrescribiendo la más antigua si el resumen está lleno
+		if (pResumen->numColumnas > 0 && ++pResumen->cabeza == RESUMEN_COLUMNAS)
+			pResumen->cabeza = 0;
+		if (pResumen->numColumnas < RESUMEN_COLUMNAS)
+			pResumen->numColumnas++;
+		pResumen->columnas[pResumen->cabeza] = (ColumnaResumen) {0, 0, 0, 0, 0};
+		pResumen->enColumna = 0;
+	}
+	pResumen->enColumna++;
+	pResumen->totalMuestras++;
+	if (valor == 0)
+		return;  // Hueco sin dato
+
+	ColumnaResumen * c = &pResumen->columnas[pResumen->cabeza];
+	if (c->numMuestras == 0 || valor < c->minimo)
+		c->minimo = valor;
+	if (c->numMuestras == 0 || valor > c->maximo)
+		c->maximo = valor;
+	c->ultimo = valor;
+	c->posicionUltimo = pResumen->enColumna - 1;
+	c->numMuestras++;
+}
+
+
+int rellenaResumenHistorial(uint32_t antiguedad, int valor, ResumenHistorial * pResumen) {
+	if (pResumen->numColumnas == 0 || valor == 0)
+		return 0;
+
+	// Columnas hacia atrás desde la que se está llenando y posición dentro de la columna
+	uint32_t atras = 0, posicion;
+	if (antiguedad < pResumen->enColumna)
+		posicion = pResumen->enColumna - 1 - antiguedad;
+	else {
+		uint32_t anteriores = antiguedad - pResumen->enColumna;
+		atras = 1 + anteriores / pResumen->muestrasPorColumna;
+		posicion = pResumen->muestrasPorColumna - 1 - anteriores % pResumen->muestrasPorColumna;
+	}
+	if (atras >= pResumen->numColumnas)
+		return 0;
+
+	ColumnaResumen * c = &pResumen->columnas[(pResumen->cabeza + RESUMEN_COLUMNAS - atras) % RESUMEN_COLUMNAS];
+	if (c->numMuestras == 0 || valor < c->minimo)
+		c->minimo = valor;
+	if (c->numMuestras == 0 || valor > c->maximo)
+		c->maximo = valor;
+	if (c->numMuestras == 0 || posicion > c->posicionUltimo) {
+		c->ultimo = valor;
+		c->posicionUltimo = posicion;
+	}
+	c->numMuestras++;
+	return 1;
+}
+
+
+uint32_t numColumnasResumen(const ResumenHistorial * pResumen) {
+	return pResumen->numColumnas;
+}
+
+
+const ColumnaResumen * columnaResumen(uint32_t indice, const ResumenHistorial * pResumen) {
+	uint32_t posicion = pResumen->cabeza + 1 + indice + RESUMEN_COLUMNAS - pResumen->numColumnas;
+	// La más antigua está justo detrás de la cabeza cuando el resumen está lleno, y en 0 si no
+	return &pResumen->columnas[posicion % RESUMEN_COLUMNAS];
+}
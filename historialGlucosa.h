@@ -0,0 +1,288 @@
+#ifndef HISTORIALGLUCOSA_H_
+#define HISTORIALGLUCOSA_H_
+
+#include <stdint.h>
+
+/**
+  * @file historialGlucosa.h
+  * @author EII
+  *
+  * @brief Historial circular de mediciones de glucosa.
+  *
+  * Guarda las últimas HISTORIAL_CAPACIDAD mediciones en un buffer circular con índices de cabeza y cola.
+  * Añadir una medición cuesta siempre lo mismo, independientemente de la capacidad: cuando el historial
+  * está lleno se sobrescribe la medición más antigua en lugar de desplazar todas las demás.
+  * Las mediciones se recorren en orden cronológico mediante un iterador. Los periodos sin medición se
+  * guardan como huecos, marcados aparte en un bit por posición, y se pueden rellenar después si llega la
+  * medición reenviada (ver ingestaGlucosa.h).
+  *
+  * La capacidad se fija en tiempo de compilación. Con una medición cada 5 minutos, 288 mediciones
+  * cubren 24 horas y 864 cubren 72 horas. Por ejemplo, compilando con -DHISTORIAL_CAPACIDAD=864.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static HistorialGlucosa historial;
+  * inicializaHistorial(&historial);
+  *
+  * anadeHistorial(95, &historial);  // Nueva medición
+  *
+  * IteradorHistorial it;
+  * int valor;
+  * inicializaIteradorHistorial(300, &historial, &it);  // Recorre como mucho las 300 últimas
+  * while (siguienteHistorial(&it, &valor))
+  *     if (!esHuecoHistorial(&it))
+  *         ...  // Mediciones desde la más antigua a la más reciente
+  * @endcode
+  *
+  * Para ventanas más largas que la gráfica, como 24 horas, 3 días o 14 días, el resumen del historial
+  * reparte las mediciones en RESUMEN_COLUMNAS columnas de 'muestrasPorColumna' mediciones consecutivas y
+  * guarda de cada columna el mínimo, el máximo y la última. Cada medición se añade en tiempo constante a la
+  * columna que se está llenando, así que dibujar la ventana (ver dibujaGraficaResumen() en interfazLCD.h)
+  * cuesta lo mismo sea cual sea su longitud, y un pico o una hipoglucemia breves siguen viéndose aunque
+  * caigan entre otras mediciones. Las mediciones a 0 cuentan como huecos sin dato, y
+ * rellenaResumenHistorial() añade a su columna la medición reenviada, igual que rellenaHistorial().
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static ResumenHistorial resumen14dias;
+  * inicializaResumenHistorial(RESUMEN_MUESTRAS_POR_COLUMNA(14 * 288), &resumen14dias);
+  *
+  * anadeResumenHistorial(95, &resumen14dias);  // Junto con anadeHistorial()
+  * @endcode
+  */
+
+
+/** @brief Número máximo de mediciones que se guardan en el historial */
+#ifndef HISTORIAL_CAPACIDAD
+#define HISTORIAL_CAPACIDAD 300
+#endif
+
+
+/** @brief Número de columnas del resumen, una por columna de la gráfica */
+#ifndef RESUMEN_COLUMNAS
+#define RESUMEN_COLUMNAS 300
+#endif
+
+/** @brief Mediciones por columna para que una ventana de 'muestras' mediciones ocupe todo el resumen */
+#define RESUMEN_MUESTRAS_POR_COLUMNA(muestras) (((muestras) + RESUMEN_COLUMNAS - 1) / RESUMEN_COLUMNAS)
+
+
+/**
+ * @brief Historial circular de mediciones
+ *
+ * @see inicializaHistorial(), anadeHistorial(), numMuestrasHistorial(), ultimaMuestraHistorial(),
+ *     inicializaIteradorHistorial(), siguienteHistorial()
+ */
+typedef struct {
+    /** @brief Mediciones guardadas, 0 en los huecos */
+    int valores[HISTORIAL_CAPACIDAD];
+    /** @brief Un bit por posición de 'valores', a 1 si es un hueco */
+    uint32_t huecos[(HISTORIAL_CAPACIDAD + 31) / 32];
+    /** @brief Posición donde se guardará la próxima medición */
+    uint32_t cabeza;
+    /** @brief Posición de la medición más antigua */
+    uint32_t cola;
+    /** @brief Número de mediciones guardadas, como mucho HISTORIAL_CAPACIDAD */
+    uint32_t numMuestras;
+    /** @brief Número de mediciones añadidas desde la inicialización, incluidas las descartadas */
+    uint32_t totalMuestras;
+} HistorialGlucosa;
+
+
+/**
+ * @brief Iterador para recorrer un historial en orden cronológico
+ *
+ * @see inicializaIteradorHistorial(), siguienteHistorial()
+ */
+typedef struct {
+    /** @brief Historial recorrido */
+    const HistorialGlucosa * historial;
+    /** @brief Posición de la próxima medición a devolver */
+    uint32_t posicion;
+    /** @brief Número de mediciones que quedan por devolver */
+    uint32_t restantes;
+    /** @brief Buleano cierto si la última medición devuelta es un hueco */
+    int hueco;
+} IteradorHistorial;
+
+
+/**
+ * @brief Mínimo, máximo y última de las mediciones de una columna del resumen
+ */
+typedef struct {
+    /** @brief Medición mínima de la columna en mg/dL */
+    int16_t minimo;
+    /** @brief Medición máxima de la columna en mg/dL */
+    int16_t maximo;
+    /** @brief Última medición de la columna en mg/dL */
+    int16_t ultimo;
+    /** @brief Número de mediciones distintas de 0 en la columna. Si es 0 la columna es un hueco */
+    uint16_t numMuestras;
+    /** @brief Posición de 'ultimo' en la columna, para saber si una medición rellenada es posterior */
+    uint16_t posicionUltimo;
+} ColumnaResumen;
+
+
+/**
+ * @brief Resumen por columnas de un historial, para representar ventanas de cualquier longitud
+ *
+ * @see inicializaResumenHistorial(), anadeResumenHistorial(), rellenaResumenHistorial(), numColumnasResumen(),
+ *     columnaResumen()
+ */
+typedef struct {
+    /** @brief Columnas, en un buffer circular */
+    ColumnaResumen columnas[RESUMEN_COLUMNAS];
+    /** @brief Mediciones que se acumulan en cada columna */
+    uint32_t muestrasPorColumna;
+    /** @brief Posición de la columna que se está llenando */
+    uint32_t cabeza;
+    /** @brief Número de columnas ocupadas, incluida la que se está llenando. Como mucho RESUMEN_COLUMNAS */
+    uint32_t numColumnas;
+    /** @brief Mediciones añadidas a la columna que se está llenando, incluidas las que son 0 */
+    uint32_t enColumna;
+    /** @brief Número de mediciones añadidas desde la inicialización */
+    uint32_t totalMuestras;
+} ResumenHistorial;
+
+
+/**
+ * @brief Inicializa un historial vacío
+ *
+ * @param pHistorial Puntero a la estructura que representa al historial
+ */
+void inicializaHistorial(HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Añade una medición al historial
+ *
+ * Si el historial está lleno se descarta la medición más antigua.
+ *
+ * @param valor Medición de glucosa en mg/dL
+ * @param pHistorial Puntero a la estructura que representa al historial
+ */
+void anadeHistorial(int valor, HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Añade un periodo sin medición al historial
+ *
+ * Ocupa una posición como cualquier medición, para que las demás sigan en su instante.
+ */
+void anadeHuecoHistorial(HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Rellena un hueco con la medición que ha llegado más tarde
+ *
+ * @param antiguedad Posición del hueco contando desde la más reciente, que es la 0
+ * @param valor Medición de glucosa en mg/dL
+ * @param pHistorial Puntero al historial
+ * @return Buleano cierto si la posición estaba en el historial y era un hueco
+ */
+int rellenaHistorial(uint32_t antiguedad, int valor, HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Número de mediciones guardadas en el historial
+ */
+uint32_t numMuestrasHistorial(const HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Número de mediciones añadidas desde la inicialización, incluidas las ya descartadas
+ *
+ * Permite saber cuántas mediciones nuevas hay desde la última vez que se consultó el historial.
+ */
+uint32_t totalMuestrasHistorial(const HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Medición más reciente del historial
+ *
+ * @return La última medición añadida, o 0 si el historial está vacío o es un hueco
+ */
+int ultimaMuestraHistorial(const HistorialGlucosa * pHistorial);
+
+
+/**
+ * @brief Prepara un iterador para recorrer las últimas mediciones del historial
+ *
+ * @param numUltimas Número de mediciones a recorrer. Si hay menos, se recorren todas
+ * @param pHistorial Puntero al historial
+ * @param pIterador Puntero al iterador que se inicializa
+ */
+void inicializaIteradorHistorial(uint32_t numUltimas, const HistorialGlucosa * pHistorial,
+    IteradorHistorial * pIterador);
+
+
+/**
+ * @brief Obtiene la siguiente medición en orden cronológico
+ *
+ * @param pIterador Puntero al iterador
+ * @param valor Puntero donde se copia la medición
+ * @return Buleano cierto si se obtuvo una medición, falso si ya se recorrieron todas
+ */
+int siguienteHistorial(IteradorHistorial * pIterador, int * valor);
+
+
+/**
+ * @brief Buleano cierto si la última medición obtenida con siguienteHistorial() es un hueco
+ */
+int esHuecoHistorial(const IteradorHistorial * pIterador);
+
+
+/**
+ * @brief Inicializa un resumen vacío
+ *
+ * @param muestrasPorColumna Mediciones que se acumulan en cada columna, al menos 1. La ventana representada
+ *     es de muestrasPorColumna * RESUMEN_COLUMNAS mediciones
+ * @param pResumen Puntero a la estructura que representa al resumen
+ */
+void inicializaResumenHistorial(uint32_t muestrasPorColumna, ResumenHistorial * pResumen);
+
+
+/**
+ * @brief Añade una medición al resumen, en tiempo constante
+ *
+ * Cuando la columna actual tiene muestrasPorColumna mediciones, empieza otra. Si el resumen está lleno se
+ * descarta la columna más antigua.
+ *
+ * @param valor Medición de glucosa en mg/dL, o 0 si no hay dato
+ * @param pResumen Puntero a la estructura que representa al resumen
+ */
+void anadeResumenHistorial(int valor, ResumenHistorial * pResumen);
+
+
+/**
+ * @brief Añade a su columna la medición que ha llegado tarde para un hueco
+ *
+ * El resumen no guarda qué mediciones eran huecos, así que quien lo llama tiene que saberlo, por ejemplo
+ * porque rellenaHistorial() ha devuelto cierto para la misma antigüedad.
+ *
+ * @param antiguedad Posición del hueco contando desde la medición más reciente, que es la 0
+ * @param valor Medición de glucosa en mg/dL
+ * @param pResumen Puntero al resumen
+ * @return Buleano cierto si la posición aún está en el resumen
+ */
+int rellenaResumenHistorial(uint32_t antiguedad, int valor, ResumenHistorial * pResumen);
+
+
+/**
+ * @brief Número de columnas ocupadas del resumen, incluida la que se está llenando
+ */
+uint32_t numColumnasResumen(const ResumenHistorial * pResumen);
+
+
+/**
+ * @brief Columna del resumen en orden cronológico
+ *
+ * @param indice Índice de la columna, de 0 (la más antigua) a numColumnasResumen() - 1 (la que se está
+ *     llenando)
+ * @param pResumen Puntero al resumen
+ * @return Puntero a la columna
+ */
+const ColumnaResumen * columnaResumen(uint32_t indice, const ResumenHistorial * pResumen);
+
+
+#endif /* HISTORIALGLUCOSA_H_ */
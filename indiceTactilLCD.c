@@ -0,0 +1,170 @@
+#include "indiceTactilLCD.h"
+
+
+#define LADO 320  // Lado del índice en puntos: cubre la pantalla en vertical y en horizontal
+#define CELDAS ((LADO + LCD_INDICE_TACTIL_CELDA - 1) / LCD_INDICE_TACTIL_CELDA)
+#define DESBORDADA 0xFF  // Valor de 'numEnCelda' cuando no caben todas las zonas en la celda
+
+typedef struct {
+	uint16_t x, y, ancho, alto;
+	uint8_t profundidad;
+	LCD_AtiendeZonaTactil atiende;
+	void * componente;
+} ZonaTactil;
+
+static ZonaTactil zonas[LCD_INDICE_TACTIL_ZONAS];
+static uint8_t numZonas = 0;
+static uint8_t celdas[CELDAS][CELDAS][LCD_INDICE_TACTIL_POR_CELDA];  // Índices de las zonas de cada celda
+static uint8_t numEnCelda[CELDAS][CELDAS];
+static int activo = 0;
+static int capturada = -1;  // Zona que aceptó la pulsación en curso, o -1
+
+
+static int contiene(const ZonaTactil * zona, uint16_t x, uint16_t y) {
+// Mismo criterio que usaban los componentes, con los bordes fuera de la zona
+
+	return x > zona->x && x < zona->x + zona->ancho && y > zona->y && y < zona->y + zona->alto;
+}
+
+
+static int ofrece(int i, const LCD_EventoTactil * evento) {
+	return contiene(&zonas[i], evento->x, evento->y) && zonas[i].atiende(zonas[i].componente, evento);
+}
+
+
+static int debajo(uint8_t a, uint8_t b) {
+// Buleano cierto si la zona 'a' queda por debajo de la 'b': menos profundidad o, con la misma, anotada antes
+
+	return zonas[a].profundidad < zonas[b].profundidad ||
+		(zonas[a].profundidad == zonas[b].profundidad && a < b);
+}
+
+
+static void ordena(uint8_t * lista, int n) {
+// Ordena de la zona inferior a la superior. Las listas son cortas y casi siempre ya están ordenadas
+
+	for (int i = 1; i < n; i++)
+		for (int j = i; j > 0 && debajo(lista[j], lista[j - 1]); j--) {
+			uint8_t zona = lista[j];
+			lista[j] = lista[j - 1];
+			lista[j - 1] = zona;
+		}
+}
+
+
+static int pulsa(const LCD_EventoTactil * evento) {
+// Ofrece la pulsación a las zonas que contienen el punto, de la superior a la inferior. Devuelve la que
+// la acepta, o -1
+
+	if (evento->x >= LADO || evento->y >= LADO)
+		return -1;
+	uint8_t fila = evento->y / LCD_INDICE_TACTIL_CELDA, columna = evento->x / LCD_INDICE_TACTIL_CELDA;
+	uint8_t n = numEnCelda[fila][columna];
+	if (n == DESBORDADA) {
+		uint8_t candidatas[LCD_INDICE_TACTIL_ZONAS];
+		int numCandidatas = 0;
+		for (int i = 0; i < numZonas; i++)
+			if (contiene(&zonas[i], evento->x, evento->y))
+				candidatas[numCandidatas++] = i;
+		ordena(candidatas, numCandidatas);
+		for (int i = numCandidatas - 1; i >= 0; i--)
+			if (ofrece(candidatas[i], evento))
+				return candidatas[i];
+	} else {
+		for (int i = n - 1; i >= 0; i--)
+			if (ofrece(celdas[fila][columna][i], evento))
+				return celdas[fila][columna][i];
+	}
+	return -1;
+}
+
+
+static void suelta(const LCD_EventoTactil * evento) {
+	if (capturada >= 0) {
+		LCD_EventoTactil liberacion = *evento;
+		liberacion.tipo = LCD_TACTIL_SUELTA;
+		zonas[capturada].atiende(zonas[capturada].componente, &liberacion);
+		capturada = -1;
+	}
+}
+
+
+void LCD_inicializaIndiceTactil(void) {
+	for (int fila = 0; fila < CELDAS; fila++)
+		for (int columna = 0; columna < CELDAS; columna++)
+			numEnCelda[fila][columna] = 0;
+	numZonas = 0;
+	capturada = -1;
+	activo = 1;
+}
+
+
+int LCD_indiceTactilActivo(void) {
+	return activo;
+}
+
+
+int LCD_anadeZonaTactil(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, LCD_AtiendeZonaTactil atiende,
+	void * componente) {
+	if (!activo || numZonas == LCD_INDICE_TACTIL_ZONAS || ancho == 0 || alto == 0 || x >= LADO || y >= LADO)
+		return 0;
+	zonas[numZonas] = (ZonaTactil) {x, y, ancho, alto, 0, atiende, componente};
+
+	uint16_t derecha = x + ancho - 1 < LADO ? x + ancho - 1 : LADO - 1;
+	uint16_t abajo = y + alto - 1 < LADO ? y + alto - 1 : LADO - 1;
+	for (int fila = y / LCD_INDICE_TACTIL_CELDA; fila <= abajo / LCD_INDICE_TACTIL_CELDA; fila++)
+		for (int columna = x / LCD_INDICE_TACTIL_CELDA; columna <= derecha / LCD_INDICE_TACTIL_CELDA; columna++) {
+			uint8_t * n = &numEnCelda[fila][columna];
+			if (*n == LCD_INDICE_TACTIL_POR_CELDA)
+				*n = DESBORDADA;  // A partir de ahora se resuelve recorriendo todas las zonas
+			else if (*n != DESBORDADA) {
+				celdas[fila][columna][(*n)++] = numZonas;
+				ordena(celdas[fila][columna], *n);
+			}
+		}
+	numZonas++;
+	return 1;
+}
+
+
+int LCD_setProfundidadZonaTactil(const void * componente, uint8_t profundidad) {
+	int i = 0;
+	while (i < numZonas && zonas[i].componente != componente)
+		i++;
+	if (i == numZonas)
+		return 0;
+	zonas[i].profundidad = profundidad;
+
+	const ZonaTactil * zona = &zonas[i];
+	uint16_t derecha = zona->x + zona->ancho - 1 < LADO ? zona->x + zona->ancho - 1 : LADO - 1;
+	uint16_t abajo = zona->y + zona->alto - 1 < LADO ? zona->y + zona->alto - 1 : LADO - 1;
+	for (int fila = zona->y / LCD_INDICE_TACTIL_CELDA; fila <= abajo / LCD_INDICE_TACTIL_CELDA; fila++)
+		for (int columna = zona->x / LCD_INDICE_TACTIL_CELDA; columna <= derecha / LCD_INDICE_TACTIL_CELDA;
+				columna++)
+			if (numEnCelda[fila][columna] != DESBORDADA)
+				ordena(celdas[fila][columna], numEnCelda[fila][columna]);
+	return 1;
+}
+
+
+void LCD_despachaEventoTactil(const LCD_EventoTactil * evento) {
+	switch (evento->tipo) {
+	case LCD_TACTIL_PULSA:
+		suelta(evento);  // Por si se perdió la liberación anterior
+		capturada = pulsa(evento);
+		break;
+	case LCD_TACTIL_MUEVE:
+		if (capturada >= 0 && contiene(&zonas[capturada], evento->x, evento->y))
+			zonas[capturada].atiende(zonas[capturada].componente, evento);
+		else {  // Ha salido de la zona pulsada, o ha entrado en una desde fuera de todas
+			suelta(evento);
+			LCD_EventoTactil pulsacion = *evento;
+			pulsacion.tipo = LCD_TACTIL_PULSA;
+			capturada = pulsa(&pulsacion);
+		}
+		break;
+	case LCD_TACTIL_SUELTA:
+		suelta(evento);
+		break;
+	}
+}
@@ -0,0 +1,123 @@
+#ifndef INDICETACTILLCD_H_
+#define INDICETACTILLCD_H_
+
+#include <stdint.h>
+#include "tactilLCD.h"
+
+/**
+  * @file indiceTactilLCD.h
+  * @author EII
+  *
+  * @brief Índice de las zonas táctiles de la pantalla, para entregar cada evento al componente pulsado.
+  *
+  * Sin el índice, cada componente de interfazLCD comprueba en cada frame si la última pulsación cae dentro
+  * de su rectángulo, así que atender la pantalla táctil cuesta un recorrido por todos los componentes y
+  * sólo se hace mientras se dibujan.
+  *
+  * Con el índice, cada componente pulsable anota su rectángulo al inicializarse. La pantalla se divide en
+  * celdas de LCD_INDICE_TACTIL_CELDA x LCD_INDICE_TACTIL_CELDA puntos y cada celda guarda las zonas que la
+  * tocan, como mucho LCD_INDICE_TACTIL_POR_CELDA. Para localizar el componente pulsado basta con mirar la
+  * celda del punto, en tiempo constante. Si en una celda se solapan más zonas, esa celda se resuelve
+  * recorriendo todas.
+  *
+  * LCD_atiendeEventosTactiles() (ver tactilLCD.h) entrega cada evento según llega, sin esperar a que los
+  * componentes se dibujen:
+  * - Un evento LCD_TACTIL_PULSA se ofrece a las zonas que contienen el punto, de la superior a la
+  *   inferior, hasta que una lo acepta. Por defecto queda encima la anotada la última, ver
+  *   LCD_setProfundidadZonaTactil(). Así un componente oculto o deshabilitado deja pasar la pulsación
+  *   al que tenga debajo.
+  * - Los eventos LCD_TACTIL_MUEVE van a la zona que aceptó la pulsación. Si el punto sale de ella, la zona
+  *   recibe un LCD_TACTIL_SUELTA y el punto se ofrece como una pulsación nueva.
+  * - El evento LCD_TACTIL_SUELTA va a la zona que aceptó la pulsación.
+  *
+  * Cada pantalla empieza llamando a LCD_inicializaIndiceTactil(), que vacía el índice, antes de
+  * inicializar sus componentes.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * LCD_inicializaIndiceTactil();
+  * LCD_inicializaBoton(10, 10, 80, 40, imagen, "OK", &juegoAlpha15, 1, 0xFFFFFFFF, pulsaOK, 1, 1, &boton);
+  * // El botón anota su zona y recibe las pulsaciones desde LCD_atiendeEventosTactiles()
+  * @endcode
+  */
+
+
+/** @brief Número máximo de zonas en el índice */
+#ifndef LCD_INDICE_TACTIL_ZONAS
+#define LCD_INDICE_TACTIL_ZONAS 32
+#endif
+
+/** @brief Lado en puntos de cada celda del índice */
+#ifndef LCD_INDICE_TACTIL_CELDA
+#define LCD_INDICE_TACTIL_CELDA 16
+#endif
+
+/** @brief Número de zonas que se pueden anotar en cada celda sin recurrir a recorrerlas todas */
+#ifndef LCD_INDICE_TACTIL_POR_CELDA
+#define LCD_INDICE_TACTIL_POR_CELDA 4
+#endif
+
+
+/**
+ * @brief Función que atiende los eventos de una zona
+ *
+ * @param componente Puntero indicado al anotar la zona
+ * @param evento Evento táctil
+ * @return Buleano cierto si el componente acepta el evento. Sólo se tiene en cuenta con LCD_TACTIL_PULSA
+ */
+typedef int (*LCD_AtiendeZonaTactil)(void * componente, const LCD_EventoTactil * evento);
+
+
+/**
+ * @brief Activa el índice y descarta todas las zonas anotadas
+ */
+void LCD_inicializaIndiceTactil(void);
+
+
+/**
+ * @brief Indica si se ha activado el índice con LCD_inicializaIndiceTactil()
+ */
+int LCD_indiceTactilActivo(void);
+
+
+/**
+ * @brief Anota en el índice la zona de un componente
+ *
+ * Las zonas anotadas después quedan por encima de las anteriores.
+ *
+ * @param x Coordenada X de la esquina superior izquierda de la zona
+ * @param y Coordenada Y de la esquina superior izquierda de la zona
+ * @param ancho Ancho de la zona en puntos
+ * @param alto Alto de la zona en puntos
+ * @param atiende Función que recibe los eventos de la zona
+ * @param componente Puntero que se pasa a 'atiende'
+ * @return Buleano cierto si se anotó la zona. Falso si el índice no está activo o está lleno
+ */
+int LCD_anadeZonaTactil(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, LCD_AtiendeZonaTactil atiende,
+    void * componente);
+
+
+/**
+ * @brief Cambia la profundidad de la zona de un componente
+ *
+ * Las zonas con más profundidad quedan por encima de las que tienen menos, sin importar el orden en que
+ * se anotaron. Todas las zonas se anotan con profundidad 0.
+ *
+ * @param componente Puntero indicado al anotar la zona
+ * @param profundidad Nueva profundidad
+ * @return Buleano cierto si el componente tiene una zona en el índice
+ */
+int LCD_setProfundidadZonaTactil(const void * componente, uint8_t profundidad);
+
+
+/**
+ * @brief Entrega un evento a la zona que corresponda
+ *
+ * La llama LCD_atiendeEventosTactiles() con cada evento cuando el índice está activo.
+ *
+ * @param evento Evento táctil
+ */
+void LCD_despachaEventoTactil(const LCD_EventoTactil * evento);
+
+
+#endif /* INDICETACTILLCD_H_ */
@@ -0,0 +1,153 @@
+#include "ingestaGlucosa.h"
+
+#if (INGESTA_CAPACIDAD_COLA & (INGESTA_CAPACIDAD_COLA - 1)) != 0
+#error "INGESTA_CAPACIDAD_COLA tiene que ser potencia de 2"
+#endif
+
+#if INGESTA_VENTANA_REENVIO % 32 != 0
+#error "INGESTA_VENTANA_REENVIO tiene que ser múltiplo de 32"
+#endif
+
+
+void inicializaIngesta(uint32_t periodo, IngestaGlucosa * pIngesta) {
+	pIngesta->cabeza = 0;
+	pIngesta->cola = 0;
+	pIngesta->periodo = periodo;
+	pIngesta->siguiente = 0;
+	pIngesta->hayLecturas = 0;
+	pIngesta->ultimoInstante = 0;
+	pIngesta->hayRetenida = 0;
+	pIngesta->huecosPendientes = 0;
+	for (int i = 0; i < INGESTA_VENTANA_REENVIO / 32; i++)
+		pIngesta->huecos[i] = 0;
+	pIngesta->numHuecos = 0;
+	pIngesta->numRecuperadas = 0;
+	pIngesta->numDescartadas = 0;
+}
+
+
+int publicaLecturaSensor(const LecturaSensor * lectura, IngestaGlucosa * pIngesta) {
+	uint32_t cabeza = pIngesta->cabeza;
+	if (cabeza - pIngesta->cola == INGESTA_CAPACIDAD_COLA)
+		return 0;
+	pIngesta->lecturas[cabeza % INGESTA_CAPACIDAD_COLA] = *lectura;
+	// La lectura queda escrita antes de publicarla. En la placa sólo evita que el compilador reordene; en el
+	// simulador productor y consumidor pueden ser hilos en núcleos distintos
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	pIngesta->cabeza = cabeza + 1;
+	return 1;
+}
+
+
+static int esHueco(uint32_t numero, const IngestaGlucosa * pIngesta) {
+	uint32_t bit = numero % INGESTA_VENTANA_REENVIO;
+	return (pIngesta->huecos[bit / 32] >> (bit % 32)) & 1;
+}
+
+
+static void marcaHueco(uint32_t numero, int hueco, IngestaGlucosa * pIngesta) {
+// Cada bit se reutiliza cada INGESTA_VENTANA_REENVIO periodos, y todos los periodos pasan por aquí como
+// lectura o como hueco, así que el bit siempre corresponde al último periodo de la ventana
+
+	uint32_t bit = numero % INGESTA_VENTANA_REENVIO;
+	if (hueco)
+		pIngesta->huecos[bit / 32] |= 1u << (bit % 32);
+	else pIngesta->huecos[bit / 32] &= ~(1u << (bit % 32));
+}
+
+
+static void compruebaRango(LecturaSensor * lectura) {
+	if (lectura->calidad == CALIDAD_HUECO)
+		return;
+	if (lectura->valor < INGESTA_MINIMO || lectura->valor > INGESTA_MAXIMO) {
+		lectura->valor = lectura->valor < INGESTA_MINIMO ? INGESTA_MINIMO : INGESTA_MAXIMO;
+		lectura->calidad = CALIDAD_FUERA_RANGO;
+	}
+}
+
+
+static int recibe(LecturaSensor * lectura, IngestaGlucosa * pIngesta) {
+// Saca la siguiente lectura de la cola
+
+	uint32_t cola = pIngesta->cola;
+	if (cola == pIngesta->cabeza)
+		return 0;
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	*lectura = pIngesta->lecturas[cola % INGESTA_CAPACIDAD_COLA];
+	pIngesta->cola = cola + 1;
+	return 1;
+}
+
+
+int siguienteLecturaIngesta(LecturaSensor * lectura, IngestaGlucosa * pIngesta) {
+	for (;;) {
+		// Primero los huecos que preceden a la lectura retenida, del más antiguo al más reciente
+		if (pIngesta->huecosPendientes > 0) {
+			uint32_t n = pIngesta->huecosPendientes--;
+			const LecturaSensor * r = &pIngesta->retenida;
+			*lectura = (LecturaSensor) {r->instante - n * pIngesta->periodo, r->numero - n, 0, CALIDAD_HUECO,
+				FUENTE_INGESTA};
+			marcaHueco(lectura->numero, 1, pIngesta);
+			return 1;
+		}
+		if (pIngesta->hayRetenida) {
+			*lectura = pIngesta->retenida;
+			pIngesta->ultimoInstante = lectura->instante;
+			pIngesta->hayRetenida = 0;
+			return 1;
+		}
+
+		LecturaSensor recibida;
+		if (!recibe(&recibida, pIngesta))
+			return 0;
+		compruebaRango(&recibida);
+		int32_t adelanto = recibida.numero - pIngesta->siguiente;  // Periodos que faltan antes de la recibida
+
+		if (!pIngesta->hayLecturas || adelanto >= 0) {
+			marcaHueco(recibida.numero, 0, pIngesta);
+			pIngesta->siguiente = recibida.numero + 1;
+			if (pIngesta->hayLecturas && adelanto > 0) {
+				// Se retiene tras sus huecos. Sólo los que caben en la ventana se pueden rellenar después
+				pIngesta->numHuecos += adelanto;
+				pIngesta->huecosPendientes = adelanto < INGESTA_VENTANA_REENVIO ? adelanto :
+					INGESTA_VENTANA_REENVIO - 1;
+				pIngesta->retenida = recibida;
+				pIngesta->hayRetenida = 1;
+				continue;
+			}
+			pIngesta->hayLecturas = 1;
+			pIngesta->ultimoInstante = recibida.instante;
+			*lectura = recibida;
+			return 1;
+		}
+
+		// Lectura de un periodo ya pasado: rellena su hueco si aún está en la ventana
+		if (-adelanto <= INGESTA_VENTANA_REENVIO && esHueco(recibida.numero, pIngesta)) {
+			marcaHueco(recibida.numero, 0, pIngesta);
+			recibida.fuente = FUENTE_REENVIO;
+			*lectura = recibida;
+			pIngesta->numRecuperadas++;
+			return 1;
+		}
+		pIngesta->numDescartadas++;  // Repetida o demasiado antigua
+	}
+}
+
+
+int instanteSiguienteIngesta(uint32_t * instante, const IngestaGlucosa * pIngesta) {
+	*instante = pIngesta->ultimoInstante + pIngesta->periodo;
+	return pIngesta->hayLecturas;
+}
+
+
+int huecoIngesta(LecturaSensor * lectura, IngestaGlucosa * pIngesta) {
+	if (!pIngesta->hayLecturas || pIngesta->hayRetenida || pIngesta->cola != pIngesta->cabeza)
+		return 0;
+	*lectura = (LecturaSensor) {pIngesta->ultimoInstante + pIngesta->periodo, pIngesta->siguiente, 0,
+		CALIDAD_HUECO, FUENTE_INGESTA};
+	marcaHueco(lectura->numero, 1, pIngesta);
+	pIngesta->siguiente++;  // Si llega su lectura, ya no es la siguiente sino una reenviada
+	pIngesta->ultimoInstante = lectura->instante;
+	pIngesta->numHuecos++;
+	return 1;
+}
@@ -0,0 +1,207 @@
+#ifndef INGESTAGLUCOSA_H_
+#define INGESTAGLUCOSA_H_
+
+#include <stdint.h>
+
+/**
+  * @file ingestaGlucosa.h
+  * @author EII
+  *
+  * @brief Entrada de las lecturas del sensor: cola sin bloqueos, detección de huecos y lecturas reenviadas.
+  *
+  * El transmisor del sensor numera sus lecturas con el periodo en que las tomó, contado desde que arrancó.
+  * Quien las recibe (la tarea o la interrupción de la radio) las publica con publicaLecturaSensor() en una
+  * cola circular de un único productor y un único consumidor: cada índice lo escribe sólo uno de los dos y
+  * no hacen falta mutex ni secciones críticas, así que el productor nunca espera. El consumidor las saca
+  * con siguienteLecturaIngesta(), que las devuelve en el orden de los periodos:
+  *
+  * - Si falta algún periodo antes de la lectura recibida, primero devuelve un hueco por cada uno (calidad
+  *   CALIDAD_HUECO, fuente FUENTE_INGESTA), como mucho los INGESTA_VENTANA_REENVIO - 1 más recientes.
+  *   Así quien las consume mantiene una medición por periodo.
+  * - Para no esperar a la siguiente lectura para saber que falta una, el consumidor puede esperar a cada
+  *   lectura sólo hasta el instante previsto, instanteSiguienteIngesta(), más un margen. Si no ha llegado,
+  *   huecoIngesta() devuelve ya el hueco de ese periodo, que cuenta como devuelto: si su lectura llega
+  *   después, es una lectura reenviada que lo rellena.
+  * - Si llega una lectura de un periodo que se devolvió como hueco hace menos de INGESTA_VENTANA_REENVIO
+  *   periodos, porque el transmisor la reenvía al recuperar la conexión, la devuelve con la fuente
+  *   FUENTE_REENVIO para que quien la consuma rellene el hueco. Las repetidas y las más antiguas se
+  *   descartan, así que si el transmisor vuelve a numerar desde 0 hay que llamar otra vez a
+  *   inicializaIngesta().
+  * - Las lecturas fuera del rango que mide el sensor se recortan al límite y se marcan con
+  *   CALIDAD_FUERA_RANGO.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static IngestaGlucosa ingesta;
+  * inicializaIngesta(periodoTicks, &ingesta);
+  *
+  * LecturaSensor lectura = {osKernelGetTickCount(), numero, valor, CALIDAD_VALIDA, FUENTE_SENSOR};
+  * publicaLecturaSensor(&lectura, &ingesta);  // Productor
+  * ...
+  * while (siguienteLecturaIngesta(&lectura, &ingesta))  // Consumidor
+  *     ...  // Huecos, lecturas nuevas y reenviadas
+  * ...
+  * uint32_t instante;
+  * if (instanteSiguienteIngesta(&instante, &ingesta) && (int32_t) (instante + margen - ahora) < 0 &&
+  *         huecoIngesta(&lectura, &ingesta))
+  *     ...  // La lectura del periodo no ha llegado a tiempo
+  * @endcode
+  */
+
+
+/** @brief Lecturas que caben en la cola entre el productor y el consumidor. Potencia de 2 */
+#ifndef INGESTA_CAPACIDAD_COLA
+#define INGESTA_CAPACIDAD_COLA 16
+#endif
+
+/** @brief Periodos hacia atrás en los que se aceptan lecturas reenviadas. Múltiplo de 32 */
+#ifndef INGESTA_VENTANA_REENVIO
+#define INGESTA_VENTANA_REENVIO 256
+#endif
+
+/** @brief Mínimo en mg/dL que mide el sensor */
+#define INGESTA_MINIMO 40
+
+/** @brief Máximo en mg/dL que mide el sensor */
+#define INGESTA_MAXIMO 400
+
+
+/**
+ * @brief Calidad de una lectura
+ */
+typedef enum {
+    /** @brief Lectura normal */
+    CALIDAD_VALIDA,
+    /** @brief Lectura fuera del rango del sensor, recortada a INGESTA_MINIMO o INGESTA_MAXIMO */
+    CALIDAD_FUERA_RANGO,
+    /** @brief Periodo sin lectura. El valor es 0 */
+    CALIDAD_HUECO} CalidadLectura;
+
+
+/**
+ * @brief Origen de una lectura
+ */
+typedef enum {
+    /** @brief Recibida del transmisor en su periodo */
+    FUENTE_SENSOR,
+    /** @brief Reenviada por el transmisor tras devolverse su periodo como hueco */
+    FUENTE_REENVIO,
+    /** @brief Hueco generado por la entrada al detectar periodos sin lectura */
+    FUENTE_INGESTA} FuenteLectura;
+
+
+/**
+ * @brief Lectura del sensor
+ */
+typedef struct {
+    /** @brief Instante de la lectura en ticks del sistema */
+    uint32_t instante;
+    /** @brief Periodo del transmisor en que se tomó, contado desde que arrancó */
+    uint32_t numero;
+    /** @brief Nivel de glucosa en mg/dL, 0 en los huecos */
+    int16_t valor;
+    /** @brief Calidad, CalidadLectura */
+    uint8_t calidad;
+    /** @brief Origen, FuenteLectura */
+    uint8_t fuente;
+} LecturaSensor;
+
+
+/**
+ * @brief Entrada de las lecturas del sensor
+ *
+ * @see inicializaIngesta(), publicaLecturaSensor(), siguienteLecturaIngesta()
+ */
+typedef struct {
+    /** @brief Lecturas publicadas, en un buffer circular */
+    LecturaSensor lecturas[INGESTA_CAPACIDAD_COLA];
+    /** @brief Número de lecturas publicadas. Sólo la escribe el productor */
+    volatile uint32_t cabeza;
+    /** @brief Número de lecturas sacadas. Sólo la escribe el consumidor */
+    volatile uint32_t cola;
+    /** @brief Ticks entre dos periodos, para estimar el instante de los huecos */
+    uint32_t periodo;
+    /** @brief Periodo de la siguiente lectura que se espera */
+    uint32_t siguiente;
+    /** @brief Buleano cierto si ya se ha devuelto alguna lectura */
+    int hayLecturas;
+    /** @brief Instante del último periodo devuelto, como lectura o como hueco, sin contar las reenviadas */
+    uint32_t ultimoInstante;
+    /** @brief Lectura recibida que se devuelve tras los huecos que la preceden */
+    LecturaSensor retenida;
+    /** @brief Buleano cierto si hay que devolver 'retenida' */
+    int hayRetenida;
+    /** @brief Huecos que quedan por devolver antes de 'retenida' */
+    uint32_t huecosPendientes;
+    /** @brief Un bit por periodo de la ventana, a 1 si se devolvió como hueco y aún se puede rellenar */
+    uint32_t huecos[INGESTA_VENTANA_REENVIO / 32];
+    /** @brief Número de periodos sin lectura detectados, incluidos los que no caben en la ventana */
+    uint32_t numHuecos;
+    /** @brief Número de lecturas reenviadas que han rellenado un hueco */
+    uint32_t numRecuperadas;
+    /** @brief Número de lecturas descartadas por repetidas o por llegar demasiado tarde */
+    uint32_t numDescartadas;
+} IngestaGlucosa;
+
+
+/**
+ * @brief Vacía la cola y olvida los periodos recibidos
+ *
+ * @param periodo Ticks entre dos lecturas del transmisor
+ * @param pIngesta Puntero a la estructura que representa a la entrada
+ */
+void inicializaIngesta(uint32_t periodo, IngestaGlucosa * pIngesta);
+
+
+/**
+ * @brief Publica una lectura recibida del transmisor, sin esperar
+ *
+ * Sólo la puede llamar un productor, sea una tarea o una interrupción.
+ *
+ * @param lectura Puntero a la lectura, con la calidad y la fuente que indique el transmisor
+ * @param pIngesta Puntero a la entrada
+ * @return Buleano cierto si cabía en la cola. Si no, se descarta
+ */
+int publicaLecturaSensor(const LecturaSensor * lectura, IngestaGlucosa * pIngesta);
+
+
+/**
+ * @brief Obtiene la siguiente lectura, hueco o lectura reenviada, sin esperar
+ *
+ * Sólo la puede llamar un consumidor.
+ *
+ * @param lectura Puntero donde se copia
+ * @param pIngesta Puntero a la entrada
+ * @return Buleano cierto si había alguna pendiente
+ */
+int siguienteLecturaIngesta(LecturaSensor * lectura, IngestaGlucosa * pIngesta);
+
+
+/**
+ * @brief Instante en que se espera la lectura del periodo siguiente al último devuelto
+ *
+ * Sólo la puede llamar el consumidor.
+ *
+ * @param instante Puntero donde se copia el instante, en ticks del sistema
+ * @param pIngesta Puntero a la entrada
+ * @return Buleano cierto si ya se ha devuelto alguna lectura. Si no, no se sabe cuándo llegará la primera
+ */
+int instanteSiguienteIngesta(uint32_t * instante, const IngestaGlucosa * pIngesta);
+
+
+/**
+ * @brief Devuelve como hueco el periodo siguiente al último devuelto, porque su lectura no ha llegado a tiempo
+ *
+ * Sólo la puede llamar el consumidor, después de sacar todas las lecturas pendientes con
+ * siguienteLecturaIngesta(). El hueco lleva el instante previsto del periodo. Si la lectura llega después
+ * se devuelve como reenviada.
+ *
+ * @param lectura Puntero donde se copia el hueco
+ * @param pIngesta Puntero a la entrada
+ * @return Buleano cierto si se ha devuelto el hueco. Es falso si aún no hay lecturas o si hay alguna
+ *     pendiente, que hay que sacar antes
+ */
+int huecoIngesta(LecturaSensor * lectura, IngestaGlucosa * pIngesta);
+
+
+#endif /* INGESTAGLUCOSA_H_ */
@@ -1,629 +1,1086 @@
-#include "interfazLCD.h"
-#include <stdio.h>  // Para sprintf()
-#include <string.h>  // Para strcmp()
-#include "pantallaLCD.h"
-#include "JuegoAlpha13.h"
-
-// ---------------------------------------------------------------------------------------------------
-// Etiquetas
-
-void LCD_inicializaEtiqueta(const char* texto, uint16_t x, uint16_t y, const LCD_JuegoCaracteresAlpha * juego,
-    uint16_t separacion, uint16_t ancho, uint16_t alto, uint16_t margenHorizontal, uint16_t margenVertical,
-    LCD_Alineacion alineacion, uint32_t color, uint32_t colorFondo, int visible, int habilitada,
-	LCD_Etiqueta * etiqueta) {
-    strcpy(etiqueta->texto, texto);
-    etiqueta->anchoTexto = LCD_anchoCadenaCaracteresAlpha(texto, juego, separacion);
-    etiqueta->x = x;
-    etiqueta->y = y;
-    etiqueta->juego = juego;
-    etiqueta->separacion = separacion;
-    etiqueta->margenHorizontal = margenHorizontal;
-    etiqueta->margenVertical = margenVertical;
-    etiqueta->ancho = ancho;
-    etiqueta->alto = alto;
-    etiqueta->alineacion = alineacion;
-    etiqueta->color = color;
-    etiqueta->colorFondo = colorFondo;
-    etiqueta->transparente = (colorFondo & 0xFF000000) == 0;
-    etiqueta->visible = visible;
-    etiqueta->habilitada = habilitada;
-}
-
-
-void LCD_setVisibilidadEtiqueta(int visibilidad, LCD_Etiqueta * etiqueta) {
-	etiqueta->visible = visibilidad;
-}
-
-
-void LCD_setHabilitacionEtiqueta(int habilitacion, LCD_Etiqueta * etiqueta) {
-	etiqueta->habilitada = habilitacion;
-}
-
-
-void LCD_setTextoEtiqueta(const char* texto, LCD_Etiqueta * etiqueta) {
-    if (strcmp(etiqueta->texto, texto)) {
-        strcpy(etiqueta->texto, texto);
-        etiqueta->anchoTexto = LCD_anchoCadenaCaracteresAlpha(texto, etiqueta->juego, etiqueta->separacion);
-    }
-}
-
-
-void LCD_setColorTextoEtiqueta(uint32_t color, LCD_Etiqueta * etiqueta) {
-    etiqueta->color = color;
-}
-
-
-void LCD_setColorFondoEtiqueta(uint32_t colorFondo, LCD_Etiqueta * etiqueta) {
-    if (etiqueta->colorFondo != colorFondo) {
-        etiqueta->colorFondo = colorFondo;
-        etiqueta->transparente = (colorFondo & 0xFF000000) == 0;
-    }
-}
-
-
-void LCD_setAlineacionEtiqueta(LCD_Alineacion alineacion, LCD_Etiqueta * etiqueta) {
-    etiqueta->alineacion = alineacion;
-}
-
-
-void LCD_atiendeEtiqueta(LCD_Etiqueta * etiqueta) {
-	uint16_t xTexto, yTexto;
-	if (etiqueta->visible) {
-		int enBlancoYNegro, opacidad;
-		if (etiqueta->habilitada) {
-			enBlancoYNegro = 0;
-			opacidad = 100;
-		} else {
-			enBlancoYNegro = 1;
-			opacidad = 70;
-		}
-		if (etiqueta->alineacion == LCD_ALINEACION_IZQUIERDA)
-			xTexto = etiqueta->x + etiqueta->margenHorizontal;
-		else if (etiqueta->alineacion == LCD_ALINEACION_DERECHA)
-			xTexto = etiqueta->x + etiqueta->ancho - etiqueta->margenHorizontal - etiqueta->anchoTexto;
-		else
-			xTexto = etiqueta->x + etiqueta->ancho / 2 - etiqueta->anchoTexto / 2;
-		yTexto = etiqueta->y + etiqueta->margenVertical;
-		if (!etiqueta->transparente)
-			LCD_dibujaRectanguloRelleno(etiqueta->x, etiqueta->y, etiqueta->ancho,
-				etiqueta->alto, etiqueta->colorFondo, enBlancoYNegro, opacidad);
-		LCD_dibujaCadenaCaracteresAlpha(xTexto, yTexto, etiqueta->texto, etiqueta->color,
-			etiqueta->separacion, etiqueta->juego, enBlancoYNegro, opacidad);
-	}
-}
-
-
-//-------------------------------------------------------------------------------------------------------
-// Imágenes
-
-void LCD_inicializaImagen(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
-	int visible, int habilitada, LCD_Imagen * pImagen) {
-	pImagen->x = x;
-	pImagen->y = y;
-	pImagen->ancho = ancho;
-	pImagen->alto = alto;
-	pImagen->colores = colores;
-	pImagen->visible = visible;
-	pImagen->habilitada = habilitada;
-}
-
-void LCD_setImagen(const uint8_t * colores, LCD_Imagen * pImagen) {
-    pImagen->colores = colores;
-}
-
-void LCD_setPosicionImagen(uint16_t x, uint16_t y, LCD_Imagen * pImagen) {
-	pImagen->x = x;
-	pImagen->y = y;
-}
-
-void LCD_setVisibilidadImagen(int visible, LCD_Imagen * pImagen) {
-	pImagen->visible = visible;
-}
-
-void LCD_setHabilitacionImagen(int habilitada, LCD_Imagen * pImagen) {
-	pImagen->habilitada = habilitada;
-}
-
-void LCD_atiendeImagen(LCD_Imagen * pImagen) {
-	int transparencia, enBlancoYNegro;
-	if (pImagen->visible) {
-		if (pImagen->habilitada) {
-			transparencia = 100;
-			enBlancoYNegro = 0;
-		} else {
-			transparencia = 70;
-			enBlancoYNegro = 1;
-		}
-	} else transparencia = 0;
-	LCD_dibujaImagen(pImagen->x, pImagen->y, pImagen->ancho, pImagen->alto,
-		pImagen->colores, enBlancoYNegro, transparencia);
-}
-
-
-//-------------------------------------------------------------------------------------------------------
-// Botones
-
-
-void LCD_inicializaBoton(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * imagen,
-		char * texto, const LCD_JuegoCaracteresAlpha * pJuegoCaracteres, uint8_t separacion, uint32_t colorTexto,
-		void (*funcion)(), int habilitado,
-		int visible, LCD_Boton * pBoton) {
-    // Inicializa la estructura de datos apuntada por 'pBoton' para representar a un botón que se
-    // va a mostrar en unas coordenadas 'x', 'y' con unas dimensiones 'ancho' y 'alto', visualizado
-    // con la imagen apuntada por 'imagen', de forma que ejecute la función apuntada por 'funcion'
-    // cuando se pulse e indicando si inicialmente se muestra visible y/o inicializado según los
-    // buleanos 'visible' y 'habilitado'.
-
-    pBoton->x = x;
-    pBoton->y = y;
-    // Coordenadas de la esquina superior izquierda del botón
-
-    pBoton->ancho = ancho;
-    pBoton->alto = alto;
-    // Dimensiones del botón en puntos
-
-    pBoton->imagen = imagen;
-    // Imagen utilizada para mostrar el botón
-
-    strcpy(pBoton->texto, texto);
-    pBoton->pJuegoCaracteres = pJuegoCaracteres;
-    pBoton->separacion = separacion;
-    pBoton->xTexto = (ancho - LCD_anchoCadenaCaracteresAlpha(texto, pJuegoCaracteres, separacion)) / 2;
-    pBoton->yTexto = (alto - pJuegoCaracteres->alto) / 2;
-    pBoton->colorTexto = colorTexto;
-    // Texto y juego de caracteres mostrado sobre el botón
-
-    pBoton->funcion = funcion;
-    // Función a ejecutar cuando se pulsa el botón
-
-    pBoton->habilitado = habilitado;
-    // Indica si se muestra habilitado
-
-    pBoton->pulsado = 0;
-    // Inicialmente no está pulsado
-
-    pBoton->visible = visible;
-    // Indica si hay que mostrar el botón
-}
-
-
-void LCD_setVisibilidadBoton(int visibilidad, LCD_Boton * pBoton) {
-    // Establece la visibilidad del botón representado por la estructura apuntada por 'pBoton',
-    // según el buleano 'visibilidad'
-
-    pBoton->visible = visibilidad;  // Guarda la nueva visibilidad
-}
-
-
-void LCD_setHabilitacionBoton(int habilitacion, LCD_Boton * pBoton) {
-    // Establece si el botón representado por la estructura apuntada por 'pBoton' está habilitado,
-    // según el buleano 'habilitacion'
-
-    pBoton->habilitado = habilitacion;  // Lo recuerda
-}
-
-
-void LCD_setTextoBoton(const char* texto, LCD_Boton * pBoton) {
-	strcpy(pBoton->texto, texto);
-    pBoton->xTexto = (pBoton->ancho - LCD_anchoCadenaCaracteresAlpha(texto, pBoton->pJuegoCaracteres,
-    	pBoton->separacion)) / 2;
-}
-
-
-void LCD_setColorTextoBoton(uint32_t color, LCD_Boton * pBoton) {
-    pBoton->colorTexto = color;
-}
-
-
-void LCD_setImagenBoton(const uint8_t * imagen, LCD_Boton * pBoton) {
-	pBoton->imagen = imagen;
-}
-
-
-void LCD_atiendeBoton(LCD_Boton * pBoton) {
-    // Atiende a la posible pulsación del botón representado por la estructura apuntada por 'pBoton'.
-	// También dibuja el botón en el buffer oculto.
-
-	int opacidad; // Para expresar el grado de opacidad (de 0 a 100) con el que se va a dibujar
-	int enBlancoYNegro;  // Buleano cierto si hay que dibujarlo en blanco y negro
-
-	if (pBoton->visible) {  // Si el botón tiene que ser visible ...
-		if (pBoton->habilitado) {  // Si está habilitado ...
-			opacidad = 100;  // Totalmente opaco
-			enBlancoYNegro = 0;  // Se va a mostra en color
-		}
-		else {  // Si es visible pero no está habilitado
-			opacidad = 70;  // Se muestra semitransparente
-			enBlancoYNegro = 1;  // y en niveles de gris
-		}
-	} else {  // Si no es visible
-		opacidad = 0;  // Se muestra completamente transparente
-		enBlancoYNegro = 0;
-	}
-
-	LCD_dibujaImagen(pBoton->x, pBoton->y, pBoton->ancho, pBoton->alto, pBoton->imagen, enBlancoYNegro,
-		opacidad);
-	// Finalmente dibuja la imagen para mostrar el botón con la opacidad y color establecidos
-
-	LCD_dibujaCadenaCaracteresAlpha(pBoton->x + pBoton->xTexto, pBoton->y + pBoton->yTexto, pBoton->texto,
-		pBoton->colorTexto, pBoton->separacion, pBoton->pJuegoCaracteres, enBlancoYNegro, opacidad);
-	// Dibuja el texto sobre el botón
-
-    if (pBoton->habilitado && pBoton->visible) {  // Si el botón está habilitado y es visible ...
-
-        if (LCD_pulsando() && LCD_xPulsacion() > pBoton->x && LCD_xPulsacion() < pBoton->x + pBoton->ancho &&
-                LCD_yPulsacion() > pBoton->y && LCD_yPulsacion() < pBoton->y + pBoton->alto) {
-            // Si se ha pulsado la pantalla dentro de las coordenadas de la superficie ocupada por el
-            // botón ...
-
-            if (!pBoton->pulsado)  // Si el botón no estaba pulsado previamente ...
-                pBoton->funcion();  // Ejecuta la función asociada al botón
-
-            pBoton->pulsado = 1;  // Indica que se está pulsando el botón
-
-        } else pBoton->pulsado = 0;  // Si no, indica que no se está pulsando el botón
-
-    } else pBoton->pulsado =0;  // Si no, indica que no se está pulsando el botón
-}
-
-
-//----------------------------------------------------------------------------------------------------
-// Interruptores
-
-
-void LCD_inicializaInterruptor(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto,
-    const uint8_t * imagenOn, const uint8_t * imagenOff, void (*funcion)(int),
-    int habilitado, int visible, LCD_Interruptor * pInterruptor) {
-    // Inicializa la estructura apuntada por 'pInterruptor' para representar a un interruptor mostrado
-    // en pantalla a partir de los siguientes datos:
-    // - La posición 'x' e 'y'
-    // - Las dimensiones 'ancho' y 'alto'
-    // - Las imágenes 'imagenOn' e 'imagenOff' a mostrar cuando el interruptor está en estado ON u OFF.
-    // - La función que se va a ejecutar cuando el usuario haga click sobre el botón. Se le va a pasar
-    //   por parámetro un buleano indicando si el botón está a ON o a OFF.
-    // - Un buleano 'visible' para inidicar si inicialmente el botón se muestra en pantalla.
-    // - Un buleano 'habilitado' de forma que si el botón está visible y habilitado, se muestra con sus
-    //   colores originales. Si está visible y deshabilitado, se muestra en blanco y negro y semmitransparente.
-
-    pInterruptor->x = x;
-    pInterruptor->y = y;
-    // Guarda la posición del botón en la pantalla
-
-    pInterruptor->ancho = ancho;
-    pInterruptor->alto = alto;
-    // Guarda las dimensiones del botón
-
-    pInterruptor->imagenOn = imagenOn;
-    pInterruptor->imagenOff = imagenOff;
-    // Guarda punteros a las imágenes a mostrar cuando el interruptor está en On o en OFF.
-
-    pInterruptor->funcion = funcion;
-    // Guarda un puntero a la función a ejecutar cuando se acciona el interruptor
-
-    pInterruptor->habilitado = habilitado;
-    pInterruptor->visible = visible;
-    // Guarda buleanos que indican si el interruptor está visible o habilitado
-}
-
-
-void LCD_setHabilitacionInterruptor(int habilitacion, LCD_Interruptor * pInterruptor) {
-    // Establece si el interruptor representado por la estructura apuntada por 'pInterruptor' está habilitado,
-    // según el buleano 'habilitacion'
-
-    pInterruptor->habilitado = habilitacion;  // La recuerda
-}
-
-
-void LCD_setVisibilidadInterruptor(int visibilidad, LCD_Interruptor * pInterruptor) {
-    // Establece la visibilidad del interruptor representado por la estructura apuntada por 'pInterruptor',
-    // según el buleano 'visibilidad'
-
-    pInterruptor->visible = visibilidad;  // La recuerda
-}
-
-
-void LCD_atiendeInterruptor(LCD_Interruptor * pInterruptor) {
-    // Atiende a la posible pulsación del interruptor representado por la estructura apuntada por 'pInterruptor'
-
-	int opacidad; // Para expresar el grado de opacidad (de 0 a 100) con el que se va a dibujar
-	int enBlancoYNegro;  // Buleano cierto si hay que dibujarlo en blanco y negro
-
-	if (pInterruptor->visible) {  // Si el interruptor tiene que ser visible ...
-		if (pInterruptor->habilitado) {  // Si está habilitado ...
-			opacidad = 100;  // hay que mostrarlo totalmente opaco
-			enBlancoYNegro = 0;  // se va a mostra en color
-		}
-		else {  // Si es visible pero no está habilitado ...
-			opacidad = 70;  // se muestra semitransparente
-			enBlancoYNegro = 1;  // y en niveles de gris
-		}
-	} else {  // Si no es visible
-		opacidad = 0;  // Se muestra completamente transparente
-		enBlancoYNegro = 0;
-	}
-
-	const uint8_t * imagen;  // Puntero a la imagen que se va a mostrar
-	if (pInterruptor->estado)  // Si está en estado ON ...
-		imagen = pInterruptor->imagenOn;  // se muestra la imagen ON
-	else imagen = pInterruptor->imagenOff;  // si no, se muestra la imagen OFF
-
-	LCD_dibujaImagen(pInterruptor->x, pInterruptor->y, pInterruptor->ancho, pInterruptor->alto, imagen,
-		enBlancoYNegro, opacidad);
-	// Finalmente dibuja la imagen para mostrar el interruptor con la opacidad y color establecidos
-
-    if (pInterruptor->habilitado && pInterruptor->visible) {  // Si el botón está habilitado y vible ...
-        if (LCD_pulsando() &&
-        		LCD_xPulsacion() > pInterruptor->x &&
-        		LCD_xPulsacion() < pInterruptor->x + pInterruptor->ancho &&
-                LCD_yPulsacion() > pInterruptor->y &&
-				LCD_yPulsacion() < pInterruptor->y + pInterruptor->alto) {
-            // Si se ha pulsado la pantalla dentro de las coordenadas de la superficie ocupada por el
-            // interruptor ..
-
-            if (!pInterruptor->pulsado) {  // Si el interruptor no estaba pulsado previamente ...
-                pInterruptor->estado = ! pInterruptor->estado;  // Cambia el estado del interruptor
-                pInterruptor->funcion(pInterruptor->estado);  // Ejecuta la función asociada al interruptor
-            }
-
-            pInterruptor->pulsado = 1;  // Indica que se está pulsando el interruptor
-
-        } else pInterruptor->pulsado = 0;  // si no, indica que no se está pulsando el interruptor
-
-    } else pInterruptor->pulsado =0;  // si no, indica que no se está pulsando el interruptor
-}
-
-
-int LCD_getEstadoInterruptor(LCD_Interruptor * pInterruptor) {
-// Devuelve un buleano indicando el estado actual del interruptor
-
-	return pInterruptor->estado;
-}
-
-
-void LCD_setEstadoInterruptor(int estado, LCD_Interruptor * pInterruptor) {
-// Establece el estado del interruptor a ON (con un buleano cierto en 'estado') o a OFF (con un buleano falso).
-// Si cambia el estado, entonces se ejecuta la función asociada al interruptor.
-
-    if (pInterruptor->estado != estado) {  // Si cambia el estado del interruptor ...
-        pInterruptor->funcion(estado);  // Ejecuta la función pasándole el nuevo estado
-        pInterruptor->estado = estado;  // Copia el nuevo estado en la estructura
-    }
-}
-
-
-//----------------------------------------------------------------------------------------------------
-// Barras
-
-
-void LCD_inicializaBarra(
-    const char* texto,  // Texto que se muestra antes del valor
-    float minimo, float maximo,  // Mínimo y máximo del valor a mostrar
-    uint8_t largo, uint8_t grosor, // Longitud y grosor de la barra en puntos
-    uint16_t x, uint16_t y,  // posición de la esquina superior izquierda de la barra
-    uint8_t numCaracteres,  // Número total de caracteres utilizados para visualizar el valor
-    uint8_t decimales,  // Número de decimales para visualizar el valor
-    uint32_t colorTexto,  // Color del texto donde se visualiza el valor
-    uint32_t colorBarra,  // Color para representar el valor
-    uint32_t colorFondo,   // Color restante del fondo de la barra
-    const LCD_JuegoCaracteresAlpha * pJuegoCaracteres,  // Juego de caracteres para visualizar el valor
-    uint8_t separacion,  // Separación entre caracteres consecutivos
-    LCD_Barra * pBarra) {  // Puntero a la estructura donde se copian los datos
-// Inicializa la estructura apuntada por 'pBara' para representar a una barra horizontal en la que mostrar
-// un dato numérico gráficamente y también en texto utilizando un número de decimales con un juego de
-// caracteres.
-
-    pBarra->texto = texto;
-    pBarra->minimo = minimo;
-    pBarra->valor = minimo;
-    pBarra->maximo = maximo;
-    pBarra->largo = largo;
-    pBarra->grosor = grosor;
-    pBarra->escala = largo / (maximo - minimo);
-    pBarra->x = x;
-    pBarra->y = y;
-    pBarra->colorTexto = colorTexto;
-    pBarra->colorBarra = colorBarra;
-    sprintf(pBarra->formato, "%%s%%-%d.%df", numCaracteres, decimales);
-    pBarra->colorFondo = colorFondo;
-    pBarra->juegoCaracteres = pJuegoCaracteres;
-    pBarra->separacion = separacion;
-    // Copia todos los datos en la estructura apuntada por pDial
-
-    pBarra->inicializada = 0;  // Inidica que aún no se asignó ningún valor
-    pBarra->margenTextoX = 5;
-    pBarra->margenTextoY = (pBarra->grosor - pBarra->juegoCaracteres->alto) / 2;
-}
-
-
-void LCD_setVisibilidadBarra(int visible, LCD_Barra * pBarra) {
-// Establece la visibilidad de la barra en función del buleano 'visible'
-
-    pBarra->visible = visible;  // hay que redibujarla en los dos frame lcd_buffers
-}
-
-
-void LCD_setColorTextoBarra(uint32_t color, LCD_Barra * pBarra) {
-
-    pBarra->colorTexto = color;
-}
-
-
-void LCD_setColorBarra(uint32_t color, LCD_Barra * pBarra) {
-
-    pBarra->colorBarra = color;
-}
-
-
-void LCD_setColorFondoBarra(uint32_t color, LCD_Barra * pBarra) {
-
-    pBarra->colorFondo = color;
-}
-
-
-void LCD_setValorBarra(float valor, LCD_Barra * pBarra) {
-
-    pBarra->valor = valor;
-}
-
-
-void LCD_atiendeBarra(LCD_Barra * pBarra) {
-// Actualiza la visualización del valor en la barra. Este es un método que hay que llamar
-// continuamente en un bucle en el programa para actualizar la visualización.
-
-
-	if (pBarra->visible) {
-		uint8_t puntosValor;  // Largo de la parte coloreada correspondiente al valor
-		puntosValor = (pBarra->valor - pBarra->minimo) * pBarra->escala;
-		LCD_dibujaRectanguloRellenoOpaco(pBarra->x, pBarra->y, puntosValor, pBarra->grosor,
-			pBarra->colorBarra);
-		LCD_dibujaRectanguloRellenoOpaco(pBarra->x + puntosValor, pBarra->y, pBarra->largo - puntosValor,
-			pBarra->grosor, pBarra->colorFondo);
-		char cadena[30];
-		int parteEntera, parteDecimal;
-		parteEntera = pBarra->valor;
-		parteDecimal = (pBarra->valor - parteEntera) * 10;
-		if (parteDecimal < 0) parteDecimal = -parteDecimal;
-		if (parteDecimal > 0)
-			sprintf(cadena, "%s%d.%d", pBarra->texto, parteEntera, parteDecimal);
-		else sprintf(cadena, "%s%d", pBarra->texto, parteEntera);
-		while(strlen(cadena) < 6)
-			strcat(cadena, " ");
-		LCD_dibujaCadenaCaracteresAlpha(pBarra->x + pBarra->margenTextoX,
-			pBarra->y + pBarra->margenTextoY, cadena, pBarra->colorTexto, pBarra->separacion,
-			pBarra->juegoCaracteres, 0, 100);
-	} else LCD_dibujaRectanguloRellenoOpaco(pBarra->x, pBarra->y, pBarra->largo, pBarra->grosor,
-		0x00000000);
-}
-
-
-//---------------------------------------------------------------------------------------------
-// Editor de dato
-
-void LCD_inicializaEditor(float valorInicial, float incrementoMenor, float incrementoMayor,
-	uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint16_t margenTextoX, uint16_t margenTextoY,
-	LCD_Alineacion alineacion,
-	uint32_t colorFondo, uint32_t colorTexto, const LCD_JuegoCaracteresAlpha * pJuego, uint8_t separacion,
-	uint8_t decimales, LCD_Editor * pEditor) {
-
-	pEditor->valor = valorInicial;
-	pEditor->incrementoMenor = incrementoMenor;
-	pEditor->incrementoMayor = incrementoMayor;
-	sprintf(pEditor->formato, "%%.%df", decimales);
-	pEditor->decimales = decimales;
-	pEditor->x = x;
-	pEditor->x25 = x + ancho / 4;
-	pEditor->x50 = x + ancho / 2;
-	pEditor->x75 = x + ancho * 3 / 4;
-	pEditor->x100 = x + ancho;
-	pEditor->y = y;
-	pEditor->margenTextoX = margenTextoX;
-	pEditor->margenTextoY = margenTextoY;
-	pEditor->alineacion = alineacion;
-	pEditor->ancho = ancho;
-	pEditor->alto = alto;
-	pEditor->pulsado = 0;
-	pEditor->colorFondo = colorFondo;
-	pEditor->colorTexto = colorTexto;
-	pEditor->pJuego = pJuego;
-	pEditor->separacion = separacion;
-}
-
-
-float LCD_getValorEditor(const LCD_Editor * pEditor) {
-	return pEditor->valor;
-}
-
-
-void LCD_setValorEditor(float valor, LCD_Editor * pEditor) {
-	pEditor->valor = valor;
-}
-
-
-void LCD_atiendeEditor(LCD_Editor * pEditor) {
-    uint16_t xPulsacion = LCD_xPulsacion();
-    uint16_t yPulsacion = LCD_yPulsacion();
-	if (LCD_pulsando() && yPulsacion > pEditor->y && yPulsacion < pEditor->y + pEditor->alto) {
-	    if (xPulsacion > pEditor->x && xPulsacion < pEditor->x25) {
-	        if (!pEditor->pulsado)
-	        	pEditor->valor -= pEditor->incrementoMayor;
-	        pEditor->pulsado = 1;  // Indica que se está pulsando el editor
-	    } else if (xPulsacion >= pEditor->x25 && xPulsacion < pEditor->x50) {
-	        if (!pEditor->pulsado)
-	        	pEditor->valor -= pEditor->incrementoMenor;
-	        pEditor->pulsado = 1;
-	    } else if (xPulsacion >= pEditor->x50 && xPulsacion < pEditor->x75) {
-	        if (!pEditor->pulsado)
-	        	pEditor->valor += pEditor->incrementoMenor;
-	        pEditor->pulsado = 1;
-	    } else if (xPulsacion >= pEditor->x75 && xPulsacion < pEditor->x100) {
-	        if (!pEditor->pulsado)
-	        	pEditor->valor += pEditor->incrementoMayor;
-	        pEditor->pulsado = 1;
-	    } else pEditor->pulsado = 0;
-	} else pEditor->pulsado = 0;
-
-	uint16_t xTexto, yTexto, anchoTexto;
-	char cadena[30];
-	sprintf(cadena, pEditor->formato, pEditor->valor);
-	anchoTexto = LCD_anchoCadenaCaracteresAlpha(cadena, pEditor->pJuego, pEditor->separacion);
-	if (pEditor->alineacion == LCD_ALINEACION_IZQUIERDA)
-		xTexto = pEditor->x + pEditor->margenTextoX;
-	else if (pEditor->alineacion == LCD_ALINEACION_DERECHA)
-		xTexto = pEditor->x + pEditor->ancho - pEditor->margenTextoX - anchoTexto;
-	else
-		xTexto = pEditor->x + pEditor->ancho / 2 - anchoTexto / 2;
-	yTexto = pEditor->y + pEditor->margenTextoY;
-	LCD_dibujaRectanguloRelleno(pEditor->x, pEditor->y, pEditor->ancho,
-			pEditor->alto, pEditor->colorFondo, 0, 100);
-	LCD_dibujaCadenaCaracteresAlpha(xTexto, yTexto, cadena, pEditor->colorTexto,
-			pEditor->separacion, pEditor->pJuego, 0, 100);
-}
-
-
-
-//---------------------------------------------------------------------------------------------
-// Grafica
-
-
-void inicializaGrafica() {
-
-
-
-    int spazio = 190 / 4;
-
-        LCD_dibujaCadenaCaracteresAlpha(0, 40, "200", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
-        LCD_dibujaCadenaCaracteresAlpha(0, 40 + spazio, "150", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
-        LCD_dibujaCadenaCaracteresAlpha(0, 40 + 2 * spazio, "100", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
-        LCD_dibujaCadenaCaracteresAlpha(0, 40 + 3 * spazio, "50", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
-        LCD_dibujaCadenaCaracteresAlpha(0, 30 + 4 * spazio, "0", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
-
-
-//        LCD_dibujaRectangulo(25, 40, 300, 190, 0xFFFFFFFF, 0, 100);
-
-        LCD_dibujaRectanguloRelleno(0, 0, 320, 30, 0xFFFFFFFF, 0, 100);
-
-        LCD_dibujaLinea(25, 40, 25, 230, 0xFFFFFFFF, 0, 100);
-        LCD_dibujaLinea(25, 230, 325, 230, 0xFFFFFFFF, 0, 100);
-        LCD_dibujaLinea(25, 40 + 3 * spazio, 325, 40 + 3 * spazio, 0xFFFF0000, 0, 100);
-
-
-
-}
-
-
-void dibujaGrafica(int *matriz) {
-    for (int i = 0; i < 299; i++) {
-        if (matriz[i] != 0 && matriz[i + 1] != 0) {
-            int y1 = 230 - ((matriz[i] * 190) / 200);
-            int y2 = 230 - ((matriz[i + 1] * 190) / 200);
-
-            LCD_dibujaLinea(i + 25, y1, i + 26, y2, 0xFFFFFFFF, 0, 100);
-        }
-    }
-
-    if (matriz[299] != 0) {
-        int y = 230 - ((matriz[299] * 190) / 200);
-        LCD_dibujaPunto(299 + 25, y, 0xFFFFFFFF, 0, 100);
-    }
-}
-
+#include "interfazLCD.h"
+#include <string.h>  // Para strcmp()
+#include "pantallaLCD.h"
+#include "frameLCD.h"
+#include "fondoLCD.h"
+#include "dma2dLCD.h"
+#include "textoLCD.h"
+#include "formatoLCD.h"
+#include "tactilLCD.h"
+#include "indiceTactilLCD.h"
+#include "perfilado.h"
+#include "JuegoAlpha13.h"
+
+// ---------------------------------------------------------------------------------------------------
+// Etiquetas
+
+void LCD_inicializaEtiqueta(const char* texto, uint16_t x, uint16_t y, const LCD_JuegoCaracteresAlpha * juego,
+    uint16_t separacion, uint16_t ancho, uint16_t alto, uint16_t margenHorizontal, uint16_t margenVertical,
+    LCD_Alineacion alineacion, uint32_t color, uint32_t colorFondo, int visible, int habilitada,
+	LCD_Etiqueta * etiqueta) {
+    strcpy(etiqueta->texto, texto);
+    etiqueta->anchoTexto = LCD_anchoCadenaCaracteresAlpha(texto, juego, separacion);
+    etiqueta->x = x;
+    etiqueta->y = y;
+    etiqueta->juego = juego;
+    etiqueta->separacion = separacion;
+    etiqueta->margenHorizontal = margenHorizontal;
+    etiqueta->margenVertical = margenVertical;
+    etiqueta->ancho = ancho;
+    etiqueta->alto = alto;
+    etiqueta->alineacion = alineacion;
+    etiqueta->color = color;
+    etiqueta->colorFondo = colorFondo;
+    etiqueta->transparente = (colorFondo & 0xFF000000) == 0;
+    etiqueta->visible = visible;
+    etiqueta->habilitada = habilitada;
+    LCD_invalidaRegion(x, y, ancho, alto);
+}
+
+
+static void invalidaEtiqueta(const LCD_Etiqueta * etiqueta) {
+	LCD_invalidaRegion(etiqueta->x, etiqueta->y, etiqueta->ancho, etiqueta->alto);
+}
+
+
+void LCD_setVisibilidadEtiqueta(int visibilidad, LCD_Etiqueta * etiqueta) {
+	if (etiqueta->visible != visibilidad) {
+		etiqueta->visible = visibilidad;
+		invalidaEtiqueta(etiqueta);
+	}
+}
+
+
+void LCD_setHabilitacionEtiqueta(int habilitacion, LCD_Etiqueta * etiqueta) {
+	if (etiqueta->habilitada != habilitacion) {
+		etiqueta->habilitada = habilitacion;
+		invalidaEtiqueta(etiqueta);
+	}
+}
+
+
+void LCD_setTextoEtiqueta(const char* texto, LCD_Etiqueta * etiqueta) {
+    if (strcmp(etiqueta->texto, texto)) {
+        strcpy(etiqueta->texto, texto);
+        etiqueta->anchoTexto = LCD_anchoCadenaCaracteresAlpha(texto, etiqueta->juego, etiqueta->separacion);
+        invalidaEtiqueta(etiqueta);
+    }
+}
+
+
+void LCD_setColorTextoEtiqueta(uint32_t color, LCD_Etiqueta * etiqueta) {
+    if (etiqueta->color != color) {
+        etiqueta->color = color;
+        invalidaEtiqueta(etiqueta);
+    }
+}
+
+
+void LCD_setColorFondoEtiqueta(uint32_t colorFondo, LCD_Etiqueta * etiqueta) {
+    if (etiqueta->colorFondo != colorFondo) {
+        etiqueta->colorFondo = colorFondo;
+        etiqueta->transparente = (colorFondo & 0xFF000000) == 0;
+        invalidaEtiqueta(etiqueta);
+    }
+}
+
+
+void LCD_setAlineacionEtiqueta(LCD_Alineacion alineacion, LCD_Etiqueta * etiqueta) {
+    if (etiqueta->alineacion != alineacion) {
+        etiqueta->alineacion = alineacion;
+        invalidaEtiqueta(etiqueta);
+    }
+}
+
+
+void LCD_atiendeEtiqueta(LCD_Etiqueta * etiqueta) {
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_ETIQUETA);
+	uint16_t xTexto, yTexto;
+	if (etiqueta->visible &&
+			LCD_intersectaRegionInvalida(etiqueta->x, etiqueta->y, etiqueta->ancho, etiqueta->alto)) {
+		int enBlancoYNegro, opacidad;
+		if (etiqueta->habilitada) {
+			enBlancoYNegro = 0;
+			opacidad = 100;
+		} else {
+			enBlancoYNegro = 1;
+			opacidad = 70;
+		}
+		if (etiqueta->alineacion == LCD_ALINEACION_IZQUIERDA)
+			xTexto = etiqueta->x + etiqueta->margenHorizontal;
+		else if (etiqueta->alineacion == LCD_ALINEACION_DERECHA)
+			xTexto = etiqueta->x + etiqueta->ancho - etiqueta->margenHorizontal - etiqueta->anchoTexto;
+		else
+			xTexto = etiqueta->x + etiqueta->ancho / 2 - etiqueta->anchoTexto / 2;
+		yTexto = etiqueta->y + etiqueta->margenVertical;
+		if (!etiqueta->transparente)
+			LCD_dibujaRectanguloRellenoDMA2D(etiqueta->x, etiqueta->y, etiqueta->ancho,
+				etiqueta->alto, etiqueta->colorFondo, enBlancoYNegro, opacidad);
+		LCD_dibujaCadenaCaracteresAlphaCache(xTexto, yTexto, etiqueta->texto, etiqueta->color,
+			etiqueta->separacion, etiqueta->juego, enBlancoYNegro, opacidad);
+	}
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_ETIQUETA);
+}
+
+
+//-------------------------------------------------------------------------------------------------------
+// Imágenes
+
+void LCD_inicializaImagen(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
+	int visible, int habilitada, LCD_Imagen * pImagen) {
+	pImagen->x = x;
+	pImagen->y = y;
+	pImagen->ancho = ancho;
+	pImagen->alto = alto;
+	pImagen->colores = colores;
+	pImagen->imagen16 = NULL;
+	pImagen->visible = visible;
+	pImagen->habilitada = habilitada;
+	LCD_invalidaRegion(x, y, ancho, alto);
+}
+
+static void invalidaImagen(const LCD_Imagen * pImagen) {
+	LCD_invalidaRegion(pImagen->x, pImagen->y, pImagen->ancho, pImagen->alto);
+}
+
+void LCD_setImagen(const uint8_t * colores, LCD_Imagen * pImagen) {
+	if (pImagen->colores != colores) {
+		pImagen->colores = colores;
+		invalidaImagen(pImagen);
+	}
+}
+
+void LCD_setImagen16(const LCD_Imagen16 * imagen16, LCD_Imagen * pImagen) {
+	if (pImagen->imagen16 != imagen16) {
+		pImagen->imagen16 = imagen16;
+		invalidaImagen(pImagen);
+	}
+}
+
+void LCD_setPosicionImagen(uint16_t x, uint16_t y, LCD_Imagen * pImagen) {
+	if (pImagen->x != x || pImagen->y != y) {
+		invalidaImagen(pImagen);  // Zona que deja libre
+		pImagen->x = x;
+		pImagen->y = y;
+		invalidaImagen(pImagen);  // Zona que pasa a ocupar
+	}
+}
+
+void LCD_setVisibilidadImagen(int visible, LCD_Imagen * pImagen) {
+	if (pImagen->visible != visible) {
+		pImagen->visible = visible;
+		invalidaImagen(pImagen);
+	}
+}
+
+void LCD_setHabilitacionImagen(int habilitada, LCD_Imagen * pImagen) {
+	if (pImagen->habilitada != habilitada) {
+		pImagen->habilitada = habilitada;
+		invalidaImagen(pImagen);
+	}
+}
+
+void LCD_atiendeImagen(LCD_Imagen * pImagen) {
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_IMAGEN);
+	int transparencia, enBlancoYNegro;
+	if (!LCD_intersectaRegionInvalida(pImagen->x, pImagen->y, pImagen->ancho, pImagen->alto)) {
+		PERFIL_FIN(PERFIL_ZONA_ATIENDE_IMAGEN);
+		return;  // No ha cambiado nada en la zona de la imagen
+	}
+	if (pImagen->visible) {
+		if (pImagen->habilitada) {
+			transparencia = 100;
+			enBlancoYNegro = 0;
+		} else {
+			transparencia = 70;
+			enBlancoYNegro = 1;
+		}
+	} else {
+		transparencia = 0;
+		enBlancoYNegro = 0;
+	}
+	if (pImagen->imagen16 != NULL)  // Ya está en el formato de la pantalla
+		LCD_dibujaImagen16(pImagen->x, pImagen->y, transparencia, pImagen->imagen16);
+	else LCD_dibujaImagenDMA2D(pImagen->x, pImagen->y, pImagen->ancho, pImagen->alto,
+		pImagen->colores, enBlancoYNegro, transparencia);
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_IMAGEN);
+}
+
+
+//-------------------------------------------------------------------------------------------------------
+// Botones
+
+
+static int tocaBoton(void * componente, const LCD_EventoTactil * evento) {
+    // Atiende los eventos del índice táctil dirigidos al botón. Lo rechaza si no está habilitado y visible
+
+    LCD_Boton * pBoton = componente;
+    if (evento->tipo == LCD_TACTIL_SUELTA || !pBoton->habilitado || !pBoton->visible) {
+        pBoton->pulsado = 0;
+        return 0;
+    }
+    if (evento->tipo == LCD_TACTIL_PULSA && !pBoton->pulsado)
+        pBoton->funcion();  // Ejecuta la función asociada al botón
+    pBoton->pulsado = 1;
+    return 1;
+}
+
+
+void LCD_inicializaBoton(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * imagen,
+		char * texto, const LCD_JuegoCaracteresAlpha * pJuegoCaracteres, uint8_t separacion, uint32_t colorTexto,
+		void (*funcion)(), int habilitado,
+		int visible, LCD_Boton * pBoton) {
+    // Inicializa la estructura de datos apuntada por 'pBoton' para representar a un botón que se
+    // va a mostrar en unas coordenadas 'x', 'y' con unas dimensiones 'ancho' y 'alto', visualizado
+    // con la imagen apuntada por 'imagen', de forma que ejecute la función apuntada por 'funcion'
+    // cuando se pulse e indicando si inicialmente se muestra visible y/o inicializado según los
+    // buleanos 'visible' y 'habilitado'.
+
+    pBoton->x = x;
+    pBoton->y = y;
+    // Coordenadas de la esquina superior izquierda del botón
+
+    pBoton->ancho = ancho;
+    pBoton->alto = alto;
+    // Dimensiones del botón en puntos
+
+    pBoton->imagen = imagen;
+    // Imagen utilizada para mostrar el botón
+
+    strcpy(pBoton->texto, texto);
+    pBoton->pJuegoCaracteres = pJuegoCaracteres;
+    pBoton->separacion = separacion;
+    pBoton->xTexto = (ancho - LCD_anchoCadenaCaracteresAlpha(texto, pJuegoCaracteres, separacion)) / 2;
+    pBoton->yTexto = (alto - pJuegoCaracteres->alto) / 2;
+    pBoton->colorTexto = colorTexto;
+    // Texto y juego de caracteres mostrado sobre el botón
+
+    pBoton->funcion = funcion;
+    // Función a ejecutar cuando se pulsa el botón
+
+    pBoton->habilitado = habilitado;
+    // Indica si se muestra habilitado
+
+    pBoton->pulsado = 0;
+    // Inicialmente no está pulsado
+
+    pBoton->visible = visible;
+    // Indica si hay que mostrar el botón
+
+    pBoton->indexado = LCD_anadeZonaTactil(x, y, ancho, alto, tocaBoton, pBoton);
+    // Si el índice táctil está activo, las pulsaciones llegan a tocaBoton()
+
+    LCD_invalidaRegion(x, y, ancho, alto);
+    // Hay que dibujarlo en el próximo frame
+}
+
+
+static void invalidaBoton(const LCD_Boton * pBoton) {
+    // Marca como inválida la zona de pantalla ocupada por el botón para que se redibuje
+
+    LCD_invalidaRegion(pBoton->x, pBoton->y, pBoton->ancho, pBoton->alto);
+}
+
+
+void LCD_setVisibilidadBoton(int visibilidad, LCD_Boton * pBoton) {
+    // Establece la visibilidad del botón representado por la estructura apuntada por 'pBoton',
+    // según el buleano 'visibilidad'
+
+    if (pBoton->visible != visibilidad) {
+        pBoton->visible = visibilidad;  // Guarda la nueva visibilidad
+        invalidaBoton(pBoton);  // y hay que redibujar su zona
+    }
+}
+
+
+void LCD_setHabilitacionBoton(int habilitacion, LCD_Boton * pBoton) {
+    // Establece si el botón representado por la estructura apuntada por 'pBoton' está habilitado,
+    // según el buleano 'habilitacion'
+
+    if (pBoton->habilitado != habilitacion) {
+        pBoton->habilitado = habilitacion;  // Lo recuerda
+        invalidaBoton(pBoton);  // y hay que redibujarlo con otros colores
+    }
+}
+
+
+void LCD_setTextoBoton(const char* texto, LCD_Boton * pBoton) {
+	if (strcmp(pBoton->texto, texto)) {
+		strcpy(pBoton->texto, texto);
+		pBoton->xTexto = (pBoton->ancho - LCD_anchoCadenaCaracteresAlpha(texto, pBoton->pJuegoCaracteres,
+			pBoton->separacion)) / 2;
+		invalidaBoton(pBoton);
+	}
+}
+
+
+void LCD_setColorTextoBoton(uint32_t color, LCD_Boton * pBoton) {
+	if (pBoton->colorTexto != color) {
+		pBoton->colorTexto = color;
+		invalidaBoton(pBoton);
+	}
+}
+
+
+void LCD_setImagenBoton(const uint8_t * imagen, LCD_Boton * pBoton) {
+	if (pBoton->imagen != imagen) {
+		pBoton->imagen = imagen;
+		invalidaBoton(pBoton);
+	}
+}
+
+
+void LCD_atiendeBoton(LCD_Boton * pBoton) {
+    // Atiende a la posible pulsación del botón representado por la estructura apuntada por 'pBoton'.
+	// También dibuja el botón en el buffer oculto.
+
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_BOTON);
+	int opacidad; // Para expresar el grado de opacidad (de 0 a 100) con el que se va a dibujar
+	int enBlancoYNegro;  // Buleano cierto si hay que dibujarlo en blanco y negro
+
+	if (pBoton->visible) {  // Si el botón tiene que ser visible ...
+		if (pBoton->habilitado) {  // Si está habilitado ...
+			opacidad = 100;  // Totalmente opaco
+			enBlancoYNegro = 0;  // Se va a mostra en color
+		}
+		else {  // Si es visible pero no está habilitado
+			opacidad = 70;  // Se muestra semitransparente
+			enBlancoYNegro = 1;  // y en niveles de gris
+		}
+	} else {  // Si no es visible
+		opacidad = 0;  // Se muestra completamente transparente
+		enBlancoYNegro = 0;
+	}
+
+	if (LCD_intersectaRegionInvalida(pBoton->x, pBoton->y, pBoton->ancho, pBoton->alto)) {
+		// Sólo se redibuja si ha cambiado algo en la zona que ocupa
+
+		LCD_dibujaImagenDMA2D(pBoton->x, pBoton->y, pBoton->ancho, pBoton->alto, pBoton->imagen, enBlancoYNegro,
+			opacidad);
+		// Finalmente dibuja la imagen para mostrar el botón con la opacidad y color establecidos
+
+		LCD_dibujaCadenaCaracteresAlphaCache(pBoton->x + pBoton->xTexto, pBoton->y + pBoton->yTexto, pBoton->texto,
+			pBoton->colorTexto, pBoton->separacion, pBoton->pJuegoCaracteres, enBlancoYNegro, opacidad);
+		// Dibuja el texto sobre el botón
+	}
+
+    if (pBoton->indexado) {  // Las pulsaciones llegan desde el índice táctil
+        if (!pBoton->habilitado || !pBoton->visible)
+            pBoton->pulsado = 0;
+
+    } else if (pBoton->habilitado && pBoton->visible) {  // Si el botón está habilitado y es visible ...
+
+        if (LCD_tactilPulsando() && LCD_tactilX() > pBoton->x && LCD_tactilX() < pBoton->x + pBoton->ancho &&
+                LCD_tactilY() > pBoton->y && LCD_tactilY() < pBoton->y + pBoton->alto) {
+            // Si se ha pulsado la pantalla dentro de las coordenadas de la superficie ocupada por el
+            // botón ...
+
+            if (!pBoton->pulsado)  // Si el botón no estaba pulsado previamente ...
+                pBoton->funcion();  // Ejecuta la función asociada al botón
+
+            pBoton->pulsado = 1;  // Indica que se está pulsando el botón
+
+        } else pBoton->pulsado = 0;  // Si no, indica que no se está pulsando el botón
+
+    } else pBoton->pulsado =0;  // Si no, indica que no se está pulsando el botón
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_BOTON);
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Interruptores
+
+
+static void invalidaInterruptor(const LCD_Interruptor * pInterruptor) {
+    // Marca como inválida la zona de pantalla ocupada por el interruptor para que se redibuje
+
+    LCD_invalidaRegion(pInterruptor->x, pInterruptor->y, pInterruptor->ancho, pInterruptor->alto);
+}
+
+
+static int tocaInterruptor(void * componente, const LCD_EventoTactil * evento) {
+    // Atiende los eventos del índice táctil dirigidos al interruptor. Lo rechaza si no está habilitado y
+    // visible
+
+    LCD_Interruptor * pInterruptor = componente;
+    if (evento->tipo == LCD_TACTIL_SUELTA || !pInterruptor->habilitado || !pInterruptor->visible) {
+        pInterruptor->pulsado = 0;
+        return 0;
+    }
+    if (evento->tipo == LCD_TACTIL_PULSA && !pInterruptor->pulsado) {
+        pInterruptor->estado = ! pInterruptor->estado;  // Cambia el estado del interruptor
+        invalidaInterruptor(pInterruptor);  // Hay que mostrar la otra imagen
+        pInterruptor->funcion(pInterruptor->estado);  // Ejecuta la función asociada al interruptor
+    }
+    pInterruptor->pulsado = 1;
+    return 1;
+}
+
+
+void LCD_inicializaInterruptor(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto,
+    const uint8_t * imagenOn, const uint8_t * imagenOff, void (*funcion)(int),
+    int habilitado, int visible, LCD_Interruptor * pInterruptor) {
+    // Inicializa la estructura apuntada por 'pInterruptor' para representar a un interruptor mostrado
+    // en pantalla a partir de los siguientes datos:
+    // - La posición 'x' e 'y'
+    // - Las dimensiones 'ancho' y 'alto'
+    // - Las imágenes 'imagenOn' e 'imagenOff' a mostrar cuando el interruptor está en estado ON u OFF.
+    // - La función que se va a ejecutar cuando el usuario haga click sobre el botón. Se le va a pasar
+    //   por parámetro un buleano indicando si el botón está a ON o a OFF.
+    // - Un buleano 'visible' para inidicar si inicialmente el botón se muestra en pantalla.
+    // - Un buleano 'habilitado' de forma que si el botón está visible y habilitado, se muestra con sus
+    //   colores originales. Si está visible y deshabilitado, se muestra en blanco y negro y semmitransparente.
+
+    pInterruptor->x = x;
+    pInterruptor->y = y;
+    // Guarda la posición del botón en la pantalla
+
+    pInterruptor->ancho = ancho;
+    pInterruptor->alto = alto;
+    // Guarda las dimensiones del botón
+
+    pInterruptor->imagenOn = imagenOn;
+    pInterruptor->imagenOff = imagenOff;
+    // Guarda punteros a las imágenes a mostrar cuando el interruptor está en On o en OFF.
+
+    pInterruptor->funcion = funcion;
+    // Guarda un puntero a la función a ejecutar cuando se acciona el interruptor
+
+    pInterruptor->habilitado = habilitado;
+    pInterruptor->visible = visible;
+    // Guarda buleanos que indican si el interruptor está visible o habilitado
+
+    pInterruptor->indexado = LCD_anadeZonaTactil(x, y, ancho, alto, tocaInterruptor, pInterruptor);
+    // Si el índice táctil está activo, las pulsaciones llegan a tocaInterruptor()
+
+    LCD_invalidaRegion(x, y, ancho, alto);
+    // Hay que dibujarlo en el próximo frame
+}
+
+
+
+void LCD_setHabilitacionInterruptor(int habilitacion, LCD_Interruptor * pInterruptor) {
+    // Establece si el interruptor representado por la estructura apuntada por 'pInterruptor' está habilitado,
+    // según el buleano 'habilitacion'
+
+    if (pInterruptor->habilitado != habilitacion) {
+        pInterruptor->habilitado = habilitacion;  // La recuerda
+        invalidaInterruptor(pInterruptor);
+    }
+}
+
+
+void LCD_setVisibilidadInterruptor(int visibilidad, LCD_Interruptor * pInterruptor) {
+    // Establece la visibilidad del interruptor representado por la estructura apuntada por 'pInterruptor',
+    // según el buleano 'visibilidad'
+
+    if (pInterruptor->visible != visibilidad) {
+        pInterruptor->visible = visibilidad;  // La recuerda
+        invalidaInterruptor(pInterruptor);
+    }
+}
+
+
+void LCD_atiendeInterruptor(LCD_Interruptor * pInterruptor) {
+    // Atiende a la posible pulsación del interruptor representado por la estructura apuntada por 'pInterruptor'
+
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_INTERRUPTOR);
+	int opacidad; // Para expresar el grado de opacidad (de 0 a 100) con el que se va a dibujar
+	int enBlancoYNegro;  // Buleano cierto si hay que dibujarlo en blanco y negro
+
+	if (pInterruptor->visible) {  // Si el interruptor tiene que ser visible ...
+		if (pInterruptor->habilitado) {  // Si está habilitado ...
+			opacidad = 100;  // hay que mostrarlo totalmente opaco
+			enBlancoYNegro = 0;  // se va a mostra en color
+		}
+		else {  // Si es visible pero no está habilitado ...
+			opacidad = 70;  // se muestra semitransparente
+			enBlancoYNegro = 1;  // y en niveles de gris
+		}
+	} else {  // Si no es visible
+		opacidad = 0;  // Se muestra completamente transparente
+		enBlancoYNegro = 0;
+	}
+
+	const uint8_t * imagen;  // Puntero a la imagen que se va a mostrar
+	if (pInterruptor->estado)  // Si está en estado ON ...
+		imagen = pInterruptor->imagenOn;  // se muestra la imagen ON
+	else imagen = pInterruptor->imagenOff;  // si no, se muestra la imagen OFF
+
+	if (LCD_intersectaRegionInvalida(pInterruptor->x, pInterruptor->y, pInterruptor->ancho, pInterruptor->alto))
+		LCD_dibujaImagenDMA2D(pInterruptor->x, pInterruptor->y, pInterruptor->ancho, pInterruptor->alto, imagen,
+			enBlancoYNegro, opacidad);
+	// Finalmente dibuja la imagen para mostrar el interruptor con la opacidad y color establecidos, sólo
+	// si ha cambiado algo en la zona que ocupa
+
+    if (pInterruptor->indexado) {  // Las pulsaciones llegan desde el índice táctil
+        if (!pInterruptor->habilitado || !pInterruptor->visible)
+            pInterruptor->pulsado = 0;
+
+    } else if (pInterruptor->habilitado && pInterruptor->visible) {  // Si el botón está habilitado y vible ...
+        if (LCD_tactilPulsando() &&
+        		LCD_tactilX() > pInterruptor->x &&
+        		LCD_tactilX() < pInterruptor->x + pInterruptor->ancho &&
+                LCD_tactilY() > pInterruptor->y &&
+				LCD_tactilY() < pInterruptor->y + pInterruptor->alto) {
+            // Si se ha pulsado la pantalla dentro de las coordenadas de la superficie ocupada por el
+            // interruptor ..
+
+            if (!pInterruptor->pulsado) {  // Si el interruptor no estaba pulsado previamente ...
+                pInterruptor->estado = ! pInterruptor->estado;  // Cambia el estado del interruptor
+                invalidaInterruptor(pInterruptor);  // Hay que mostrar la otra imagen
+                pInterruptor->funcion(pInterruptor->estado);  // Ejecuta la función asociada al interruptor
+            }
+
+            pInterruptor->pulsado = 1;  // Indica que se está pulsando el interruptor
+
+        } else pInterruptor->pulsado = 0;  // si no, indica que no se está pulsando el interruptor
+
+    } else pInterruptor->pulsado =0;  // si no, indica que no se está pulsando el interruptor
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_INTERRUPTOR);
+}
+
+
+int LCD_getEstadoInterruptor(LCD_Interruptor * pInterruptor) {
+// Devuelve un buleano indicando el estado actual del interruptor
+
+	return pInterruptor->estado;
+}
+
+
+void LCD_setEstadoInterruptor(int estado, LCD_Interruptor * pInterruptor) {
+// Establece el estado del interruptor a ON (con un buleano cierto en 'estado') o a OFF (con un buleano falso).
+// Si cambia el estado, entonces se ejecuta la función asociada al interruptor.
+
+    if (pInterruptor->estado != estado) {  // Si cambia el estado del interruptor ...
+        pInterruptor->funcion(estado);  // Ejecuta la función pasándole el nuevo estado
+        pInterruptor->estado = estado;  // Copia el nuevo estado en la estructura
+        invalidaInterruptor(pInterruptor);  // Hay que mostrar la otra imagen
+    }
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Barras
+
+
+void LCD_inicializaBarraFija(
+    const char* texto,  // Texto que se muestra antes del valor
+    int32_t minimo, int32_t maximo,  // Mínimo y máximo del valor a mostrar, en unidades de 10^-decimales
+    uint8_t largo, uint8_t grosor, // Longitud y grosor de la barra en puntos
+    uint16_t x, uint16_t y,  // posición de la esquina superior izquierda de la barra
+    uint8_t numCaracteres,  // Número total de caracteres utilizados para visualizar el valor
+    uint8_t decimales,  // Número de decimales para visualizar el valor
+    uint32_t colorTexto,  // Color del texto donde se visualiza el valor
+    uint32_t colorBarra,  // Color para representar el valor
+    uint32_t colorFondo,   // Color restante del fondo de la barra
+    const LCD_JuegoCaracteresAlpha * pJuegoCaracteres,  // Juego de caracteres para visualizar el valor
+    uint8_t separacion,  // Separación entre caracteres consecutivos
+    LCD_Barra * pBarra) {  // Puntero a la estructura donde se copian los datos
+// Inicializa la estructura apuntada por 'pBara' para representar a una barra horizontal en la que mostrar
+// un dato numérico gráficamente y también en texto utilizando un número de decimales con un juego de
+// caracteres.
+
+    pBarra->texto = texto;
+    pBarra->minimo = minimo;
+    pBarra->valor = minimo;
+    pBarra->maximo = maximo;
+    pBarra->largo = largo;
+    pBarra->grosor = grosor;
+    uint32_t rango = maximo > minimo ? (uint32_t) maximo - (uint32_t) minimo : 1;
+    pBarra->escala = (((uint32_t) largo << 16) + rango - 1) / rango;
+    // Puntos por unidad con 16 bits decimales, redondeado por exceso para que el máximo llene la barra
+    pBarra->x = x;
+    pBarra->y = y;
+    pBarra->colorTexto = colorTexto;
+    pBarra->colorBarra = colorBarra;
+    pBarra->numCaracteres = numCaracteres;
+    pBarra->decimales = decimales;
+    pBarra->colorFondo = colorFondo;
+    pBarra->juegoCaracteres = pJuegoCaracteres;
+    pBarra->separacion = separacion;
+    // Copia todos los datos en la estructura apuntada por pDial
+
+    pBarra->inicializada = 0;  // Inidica que aún no se asignó ningún valor
+    pBarra->visible = 1;
+    pBarra->margenTextoX = 5;
+    pBarra->margenTextoY = (pBarra->grosor - pBarra->juegoCaracteres->alto) / 2;
+
+    LCD_invalidaRegion(x, y, largo, grosor);
+}
+
+
+void LCD_inicializaBarra(
+    const char* texto, float minimo, float maximo, uint8_t largo, uint8_t grosor, uint16_t x, uint16_t y,
+    uint8_t numCaracteres, uint8_t decimales, uint32_t colorTexto, uint32_t colorBarra, uint32_t colorFondo,
+    const LCD_JuegoCaracteresAlpha * pJuegoCaracteres, uint8_t separacion, LCD_Barra * pBarra) {
+// Igual que LCD_inicializaBarraFija(), convirtiendo el mínimo y el máximo a coma fija
+
+    LCD_inicializaBarraFija(texto, LCD_realAFijo(minimo, decimales), LCD_realAFijo(maximo, decimales), largo,
+        grosor, x, y, numCaracteres, decimales, colorTexto, colorBarra, colorFondo, pJuegoCaracteres,
+        separacion, pBarra);
+}
+
+
+static void invalidaBarra(const LCD_Barra * pBarra) {
+// Marca como inválida la zona de pantalla ocupada por la barra para que se redibuje
+
+    LCD_invalidaRegion(pBarra->x, pBarra->y, pBarra->largo, pBarra->grosor);
+}
+
+
+void LCD_setVisibilidadBarra(int visible, LCD_Barra * pBarra) {
+// Establece la visibilidad de la barra en función del buleano 'visible'
+
+    if (pBarra->visible != visible) {
+        pBarra->visible = visible;
+        invalidaBarra(pBarra);  // hay que redibujarla en los dos frame lcd_buffers
+    }
+}
+
+
+void LCD_setColorTextoBarra(uint32_t color, LCD_Barra * pBarra) {
+
+    if (pBarra->colorTexto != color) {
+        pBarra->colorTexto = color;
+        invalidaBarra(pBarra);
+    }
+}
+
+
+void LCD_setColorBarra(uint32_t color, LCD_Barra * pBarra) {
+
+    if (pBarra->colorBarra != color) {
+        pBarra->colorBarra = color;
+        invalidaBarra(pBarra);
+    }
+}
+
+
+void LCD_setColorFondoBarra(uint32_t color, LCD_Barra * pBarra) {
+
+    if (pBarra->colorFondo != color) {
+        pBarra->colorFondo = color;
+        invalidaBarra(pBarra);
+    }
+}
+
+
+void LCD_setValorFijoBarra(int32_t valor, LCD_Barra * pBarra) {
+
+    if (pBarra->valor != valor) {
+        pBarra->valor = valor;
+        invalidaBarra(pBarra);
+    }
+}
+
+
+void LCD_setValorBarra(float valor, LCD_Barra * pBarra) {
+
+    LCD_setValorFijoBarra(LCD_realAFijo(valor, pBarra->decimales), pBarra);
+}
+
+
+void LCD_atiendeBarra(LCD_Barra * pBarra) {
+// Actualiza la visualización del valor en la barra. Este es un método que hay que llamar
+// continuamente en un bucle en el programa para actualizar la visualización.
+
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_BARRA);
+	if (!LCD_intersectaRegionInvalida(pBarra->x, pBarra->y, pBarra->largo, pBarra->grosor)) {
+		PERFIL_FIN(PERFIL_ZONA_ATIENDE_BARRA);
+		return;  // No ha cambiado nada en la zona de la barra
+	}
+
+	if (pBarra->visible) {
+		uint8_t puntosValor;  // Largo de la parte coloreada correspondiente al valor
+		uint32_t desplazamiento = 0;  // Distancia del valor al mínimo, limitada a la longitud de la barra
+		if (pBarra->valor >= pBarra->maximo)
+			desplazamiento = (uint32_t) pBarra->maximo - (uint32_t) pBarra->minimo;
+		else if (pBarra->valor > pBarra->minimo)
+			desplazamiento = (uint32_t) pBarra->valor - (uint32_t) pBarra->minimo;
+		uint32_t puntos = ((uint64_t) desplazamiento * pBarra->escala) >> 16;
+		puntosValor = puntos < pBarra->largo ? puntos : pBarra->largo;
+		LCD_dibujaRectanguloRellenoOpacoDMA2D(pBarra->x, pBarra->y, puntosValor, pBarra->grosor,
+			pBarra->colorBarra);
+		LCD_dibujaRectanguloRellenoOpacoDMA2D(pBarra->x + puntosValor, pBarra->y, pBarra->largo - puntosValor,
+			pBarra->grosor, pBarra->colorFondo);
+		char cadena[40];
+		char * valor = LCD_formateaTexto(pBarra->texto, cadena);
+		char * fin = LCD_formateaFijo(pBarra->valor, pBarra->decimales, valor);
+		LCD_completaEspacios(valor, fin, pBarra->numCaracteres);
+		// Lo mismo que el formato "%s%-<numCaracteres>.<decimales>f"
+		LCD_esperaDMA2D();
+		LCD_dibujaCadenaCaracteresAlpha(pBarra->x + pBarra->margenTextoX,
+			pBarra->y + pBarra->margenTextoY, cadena, pBarra->colorTexto, pBarra->separacion,
+			pBarra->juegoCaracteres, 0, 100);
+	} else LCD_dibujaRectanguloRellenoOpacoDMA2D(pBarra->x, pBarra->y, pBarra->largo, pBarra->grosor,
+		0x00000000);
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_BARRA);
+}
+
+
+//---------------------------------------------------------------------------------------------
+// Editor de dato
+
+
+static void invalidaEditor(const LCD_Editor * pEditor) {
+	LCD_invalidaRegion(pEditor->x, pEditor->y, pEditor->ancho, pEditor->alto);
+}
+
+
+static int32_t incrementoEditor(uint16_t xPulsacion, const LCD_Editor * pEditor) {
+	// Incremento que corresponde a pulsar en 'xPulsacion', según la cuarta parte del editor
+
+	if (xPulsacion > pEditor->x && xPulsacion < pEditor->x25)
+		return -pEditor->incrementoMayor;
+	else if (xPulsacion >= pEditor->x25 && xPulsacion < pEditor->x50)
+		return -pEditor->incrementoMenor;
+	else if (xPulsacion >= pEditor->x50 && xPulsacion < pEditor->x75)
+		return pEditor->incrementoMenor;
+	else if (xPulsacion >= pEditor->x75 && xPulsacion < pEditor->x100)
+		return pEditor->incrementoMayor;
+	return 0;
+}
+
+
+static int tocaEditor(void * componente, const LCD_EventoTactil * evento) {
+	// Atiende los eventos del índice táctil dirigidos al editor. Aplica el incremento al pulsar
+
+	LCD_Editor * pEditor = componente;
+	if (!pEditor->visible) {
+		pEditor->pulsado = 0;
+		return 0;
+	}
+	if (evento->tipo == LCD_TACTIL_PULSA && !pEditor->pulsado) {
+		int32_t incremento = incrementoEditor(evento->x, pEditor);
+		if (incremento != 0) {
+			pEditor->valor += incremento;
+			invalidaEditor(pEditor);  // Hay que mostrar el nuevo valor
+		}
+	}
+	pEditor->pulsado = evento->tipo != LCD_TACTIL_SUELTA;
+	return 1;
+}
+
+void LCD_inicializaEditorFijo(int32_t valorInicial, int32_t incrementoMenor, int32_t incrementoMayor,
+	uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint16_t margenTextoX, uint16_t margenTextoY,
+	LCD_Alineacion alineacion,
+	uint32_t colorFondo, uint32_t colorTexto, const LCD_JuegoCaracteresAlpha * pJuego, uint8_t separacion,
+	uint8_t decimales, LCD_Editor * pEditor) {
+
+	pEditor->valor = valorInicial;
+	pEditor->incrementoMenor = incrementoMenor;
+	pEditor->incrementoMayor = incrementoMayor;
+	pEditor->decimales = decimales;
+	pEditor->x = x;
+	pEditor->x25 = x + ancho / 4;
+	pEditor->x50 = x + ancho / 2;
+	pEditor->x75 = x + ancho * 3 / 4;
+	pEditor->x100 = x + ancho;
+	pEditor->y = y;
+	pEditor->margenTextoX = margenTextoX;
+	pEditor->margenTextoY = margenTextoY;
+	pEditor->alineacion = alineacion;
+	pEditor->ancho = ancho;
+	pEditor->alto = alto;
+	pEditor->pulsado = 0;
+	pEditor->visible = 1;
+	pEditor->colorFondo = colorFondo;
+	pEditor->colorTexto = colorTexto;
+	pEditor->pJuego = pJuego;
+	pEditor->separacion = separacion;
+	pEditor->indexado = LCD_anadeZonaTactil(x, y, ancho, alto, tocaEditor, pEditor);
+	LCD_invalidaRegion(x, y, ancho, alto);
+}
+
+
+void LCD_inicializaEditor(float valorInicial, float incrementoMenor, float incrementoMayor,
+	uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint16_t margenTextoX, uint16_t margenTextoY,
+	LCD_Alineacion alineacion,
+	uint32_t colorFondo, uint32_t colorTexto, const LCD_JuegoCaracteresAlpha * pJuego, uint8_t separacion,
+	uint8_t decimales, LCD_Editor * pEditor) {
+// Igual que LCD_inicializaEditorFijo(). Los incrementos se redondean a 'decimales' decimales
+
+	LCD_inicializaEditorFijo(LCD_realAFijo(valorInicial, decimales), LCD_realAFijo(incrementoMenor, decimales),
+		LCD_realAFijo(incrementoMayor, decimales), x, y, ancho, alto, margenTextoX, margenTextoY, alineacion,
+		colorFondo, colorTexto, pJuego, separacion, decimales, pEditor);
+}
+
+
+
+void LCD_setVisibilidadEditor(int visible, LCD_Editor * pEditor) {
+	if (pEditor->visible != visible) {
+		pEditor->visible = visible;
+		invalidaEditor(pEditor);
+	}
+}
+
+
+int32_t LCD_getValorFijoEditor(const LCD_Editor * pEditor) {
+	return pEditor->valor;
+}
+
+
+void LCD_setValorFijoEditor(int32_t valor, LCD_Editor * pEditor) {
+	if (pEditor->valor != valor) {
+		pEditor->valor = valor;
+		invalidaEditor(pEditor);
+	}
+}
+
+
+float LCD_getValorEditor(const LCD_Editor * pEditor) {
+	return LCD_fijoAReal(pEditor->valor, pEditor->decimales);
+}
+
+
+void LCD_setValorEditor(float valor, LCD_Editor * pEditor) {
+	LCD_setValorFijoEditor(LCD_realAFijo(valor, pEditor->decimales), pEditor);
+}
+
+
+void LCD_atiendeEditor(LCD_Editor * pEditor) {
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_EDITOR);
+    uint16_t xPulsacion = LCD_tactilX();
+    uint16_t yPulsacion = LCD_tactilY();
+    int32_t valorAnterior = pEditor->valor;
+	if (!pEditor->visible)
+		pEditor->pulsado = 0;
+	else if (!pEditor->indexado) {  // Si no, las pulsaciones llegan desde el índice táctil
+		if (LCD_tactilPulsando() && yPulsacion > pEditor->y && yPulsacion < pEditor->y + pEditor->alto) {
+			int32_t incremento = incrementoEditor(xPulsacion, pEditor);
+			if (incremento != 0) {
+				if (!pEditor->pulsado)
+					pEditor->valor += incremento;
+				pEditor->pulsado = 1;  // Indica que se está pulsando el editor
+			} else pEditor->pulsado = 0;
+		} else pEditor->pulsado = 0;
+	}
+
+	if (pEditor->valor != valorAnterior)
+		invalidaEditor(pEditor);  // Hay que mostrar el nuevo valor
+	if (!pEditor->visible || !LCD_intersectaRegionInvalida(pEditor->x, pEditor->y, pEditor->ancho, pEditor->alto)) {
+		PERFIL_FIN(PERFIL_ZONA_ATIENDE_EDITOR);
+		return;
+	}
+
+	uint16_t xTexto, yTexto, anchoTexto;
+	char cadena[30];
+	LCD_formateaFijo(pEditor->valor, pEditor->decimales, cadena);  // Como "%.<decimales>f"
+	anchoTexto = LCD_anchoCadenaCaracteresAlpha(cadena, pEditor->pJuego, pEditor->separacion);
+	if (pEditor->alineacion == LCD_ALINEACION_IZQUIERDA)
+		xTexto = pEditor->x + pEditor->margenTextoX;
+	else if (pEditor->alineacion == LCD_ALINEACION_DERECHA)
+		xTexto = pEditor->x + pEditor->ancho - pEditor->margenTextoX - anchoTexto;
+	else
+		xTexto = pEditor->x + pEditor->ancho / 2 - anchoTexto / 2;
+	yTexto = pEditor->y + pEditor->margenTextoY;
+	LCD_dibujaRectanguloRellenoDMA2D(pEditor->x, pEditor->y, pEditor->ancho,
+			pEditor->alto, pEditor->colorFondo, 0, 100);
+	LCD_esperaDMA2D();
+	LCD_dibujaCadenaCaracteresAlpha(xTexto, yTexto, cadena, pEditor->colorTexto,
+			pEditor->separacion, pEditor->pJuego, 0, 100);
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_EDITOR);
+}
+
+
+
+//---------------------------------------------------------------------------------------------
+// Grafica
+
+
+void inicializaGrafica() {
+
+
+
+    PERFIL_INICIO(PERFIL_ZONA_INICIALIZA_GRAFICA);
+    int spazio = 190 / 4;
+
+    if (LCD_intersectaRegionInvalida(0, 40, 25, 200)) {  // Etiquetas del eje vertical
+        LCD_dibujaCadenaCaracteresAlphaCache(0, 40, "200", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
+        LCD_dibujaCadenaCaracteresAlphaCache(0, 40 + spazio, "150", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
+        LCD_dibujaCadenaCaracteresAlphaCache(0, 40 + 2 * spazio, "100", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
+        LCD_dibujaCadenaCaracteresAlphaCache(0, 40 + 3 * spazio, "50", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
+        LCD_dibujaCadenaCaracteresAlphaCache(0, 30 + 4 * spazio, "0", 0xFFFFFFFF, 1, &juegoAlpha13, 0, 100);
+    }
+
+
+//        LCD_dibujaRectangulo(25, 40, 300, 190, 0xFFFFFFFF, 0, 100);
+
+    if (LCD_intersectaRegionInvalida(0, 0, 320, 30))  // Cabecera
+        LCD_dibujaRectanguloRellenoDMA2D(0, 0, 320, 30, 0xFFFFFFFF, 0, 100);
+
+    if (LCD_intersectaRegionInvalida(25, 40, 301, 191)) {  // Ejes y umbral de 50 mg/dL
+        LCD_esperaDMA2D();
+        LCD_dibujaLinea(25, 40, 25, 230, 0xFFFFFFFF, 0, 100);
+        LCD_dibujaLinea(25, 230, 325, 230, 0xFFFFFFFF, 0, 100);
+        LCD_dibujaLinea(25, 40 + 3 * spazio, 325, 40 + 3 * spazio, 0xFFFF0000, 0, 100);
+    }
+    PERFIL_FIN(PERFIL_ZONA_INICIALIZA_GRAFICA);
+
+
+
+}
+
+
+#define GRAFICA_X 25  // Coordenada X de la primera columna de la gráfica
+#define GRAFICA_COLUMNAS 300  // Número de mediciones representadas, una por columna
+#define GRAFICA_VISIBLES 295  // Columnas que caben en pantalla, de x = 25 a x = 319
+
+
+static int yGrafica(int valor) {
+    return 230 - ((valor * 190) / 200);
+}
+
+
+static void dibujaSegmentos(uint32_t desde, uint32_t hasta, uint32_t columnas,
+        const HistorialGlucosa * historial) {
+    // Dibuja los segmentos que unen las mediciones de las columnas 'desde' a 'hasta' - 1 de la gráfica,
+    // siendo 'columnas' el número de columnas ocupadas: en la columna 'columnas' - 1 está la última
+    // medición del historial
+
+    IteradorHistorial it;
+    int anterior, actual;
+    uint32_t i = desde;
+    LCD_esperaDMA2D();  // Las líneas se dibujan con la CPU, quizá sobre una zona recién restaurada
+    inicializaIteradorHistorial(columnas - desde, historial, &it);
+    if (!siguienteHistorial(&it, &anterior))
+        return;  // Historial vacío
+    int huecoAnterior = esHuecoHistorial(&it);
+    for (; i + 1 < hasta && siguienteHistorial(&it, &actual); i++) {
+        // Junto a un hueco la medición se dibuja como un punto, para que se vea aunque esté aislada
+        int hueco = esHuecoHistorial(&it);
+        if (!huecoAnterior && !hueco)
+            LCD_dibujaLinea(i + GRAFICA_X, yGrafica(anterior), i + GRAFICA_X + 1, yGrafica(actual),
+                0xFFFFFFFF, 0, 100);
+        else if (!huecoAnterior)
+            LCD_dibujaPunto(i + GRAFICA_X, yGrafica(anterior), 0xFFFFFFFF, 0, 100);
+        else if (!hueco)
+            LCD_dibujaPunto(i + GRAFICA_X + 1, yGrafica(actual), 0xFFFFFFFF, 0, 100);
+        anterior = actual;
+        huecoAnterior = hueco;
+    }
+
+    if (i == GRAFICA_COLUMNAS - 1 && !huecoAnterior)  // La última columna sólo se ocupa con el historial completo
+        LCD_dibujaPunto(i + GRAFICA_X, yGrafica(anterior), 0xFFFFFFFF, 0, 100);
+}
+
+
+static uint32_t columnasOcupadas(uint32_t numMuestras) {
+    // Número de columnas de la gráfica ocupadas con 'numMuestras' mediciones en el historial
+
+    if (numMuestras > HISTORIAL_CAPACIDAD)
+        numMuestras = HISTORIAL_CAPACIDAD;
+    return numMuestras < GRAFICA_COLUMNAS ? numMuestras : GRAFICA_COLUMNAS;
+}
+
+
+void dibujaGrafica(const HistorialGlucosa * historial) {
+    PERFIL_INICIO(PERFIL_ZONA_DIBUJA_GRAFICA);
+    if (!LCD_intersectaRegionInvalida(GRAFICA_X, 30, GRAFICA_COLUMNAS + 1, 210)) {
+        PERFIL_FIN(PERFIL_ZONA_DIBUJA_GRAFICA);
+        return;  // La gráfica no ha cambiado
+    }
+
+    uint32_t columnas = columnasOcupadas(numMuestrasHistorial(historial));
+    dibujaSegmentos(0, columnas, columnas, historial);
+    PERFIL_FIN(PERFIL_ZONA_DIBUJA_GRAFICA);
+}
+
+
+void dibujaGraficaResumen(const ResumenHistorial * resumen) {
+    PERFIL_INICIO(PERFIL_ZONA_DIBUJA_RESUMEN);
+    if (!LCD_intersectaRegionInvalida(GRAFICA_X, 30, GRAFICA_COLUMNAS + 1, 210)) {
+        PERFIL_FIN(PERFIL_ZONA_DIBUJA_RESUMEN);
+        return;  // La gráfica no ha cambiado
+    }
+
+    // Una línea vertical por columna del mínimo al máximo, alargada hasta la última medición de la
+    // columna anterior para que la curva quede unida
+    uint32_t columnas = numColumnasResumen(resumen);
+    int anterior = 0;
+    LCD_esperaDMA2D();
+    for (uint32_t i = 0; i < columnas && i < GRAFICA_COLUMNAS; i++) {
+        const ColumnaResumen * columna = columnaResumen(i, resumen);
+        if (columna->numMuestras == 0) {
+            anterior = 0;  // Hueco sin mediciones
+            continue;
+        }
+        int minimo = columna->minimo, maximo = columna->maximo;
+        if (anterior != 0 && anterior < minimo)
+            minimo = anterior;
+        if (anterior > maximo)
+            maximo = anterior;
+        LCD_dibujaLinea(i + GRAFICA_X, yGrafica(maximo), i + GRAFICA_X, yGrafica(minimo), 0xFFFFFFFF, 0, 100);
+        anterior = columna->ultimo;
+    }
+    PERFIL_FIN(PERFIL_ZONA_DIBUJA_RESUMEN);
+}
+
+
+static uint32_t muestrasDibujadas[2];  // Total de mediciones del historial al dibujar cada frame buffer
+
+
+static void desplazaGrafica(const HistorialGlucosa * historial) {
+    LCD_Region zona = {GRAFICA_X, 30, GRAFICA_VISIBLES, 210};  // Zona de pantalla ocupada por la gráfica
+    int buffer = LCD_indiceBufferOculto();
+    uint32_t total = totalMuestrasHistorial(historial);
+    uint32_t previas = muestrasDibujadas[buffer];
+    uint32_t nuevas = total - previas;  // Mediciones añadidas desde que se dibujó este frame buffer
+    uint32_t columnas = columnasOcupadas(numMuestrasHistorial(historial));
+    muestrasDibujadas[buffer] = total;
+
+    if (LCD_cubiertaRegionInvalida(zona.x, zona.y, zona.ancho, zona.alto)) {
+        // Toda la zona es inválida y ya se restauró el fondo, puede que con algo dibujado encima
+        dibujaSegmentos(0, columnas, columnas, historial);
+        return;
+    }
+    if (LCD_intersectaRegionInvalida(zona.x, zona.y, zona.ancho, zona.alto) || previas > total ||
+            nuevas + 2 > columnas) {
+        // Si se ha invalidado parte de la zona o si hay demasiadas mediciones nuevas, se redibuja toda
+        // la gráfica sobre el fondo
+
+        LCD_marcaBufferModificado();  // La zona puede no estar invalidada
+        LCD_restauraFondoRegion(&zona);
+        dibujaSegmentos(0, columnas, columnas, historial);
+        return;
+    }
+    if (nuevas == 0)
+        return;  // Nada nuevo desde que se dibujó este frame buffer
+    LCD_marcaBufferModificado();  // El desplazamiento no invalida la zona, pero el frame se tiene que mostrar
+
+    uint32_t desplazamiento = columnasOcupadas(previas) + nuevas - columnas;
+    // Columnas que hay que desplazar la gráfica para que la última medición quede en su sitio
+
+    uint32_t primera = columnas - nuevas;  // Columna de la primera medición nueva
+    if (desplazamiento > 0) {
+        if (desplazamiento + 2 > GRAFICA_VISIBLES) {  // Desplazamiento mayor que la zona visible
+            LCD_restauraFondoRegion(&zona);
+            dibujaSegmentos(0, columnas, columnas, historial);
+            return;
+        }
+        LCD_desplazaRegionIzquierda(&zona, desplazamiento);  // Una sola copia de bloque
+
+        LCD_Region eje = {GRAFICA_X, zona.y, 1, zona.alto};
+        LCD_restauraFondoRegion(&eje);
+        dibujaSegmentos(0, 2, columnas, historial);
+        // La primera columna tiene el eje vertical y restos del segmento que ha salido de la gráfica
+
+        if (primera > GRAFICA_VISIBLES - desplazamiento)
+            primera = GRAFICA_VISIBLES - desplazamiento;
+        LCD_Region restaurar = {GRAFICA_X + primera, zona.y, GRAFICA_VISIBLES - primera, zona.alto};
+        LCD_restauraFondoRegion(&restaurar);
+        // Las últimas columnas visibles conservan su contenido anterior y hay que redibujarlas
+    }
+    // Sin desplazamiento, las columnas a la derecha de la última medición ya muestran el fondo
+
+    dibujaSegmentos(primera - 1, columnas, columnas, historial);
+    // También el segmento que llega a la columna 'primera', por si esa columna se ha restaurado
+}
+
+
+void dibujaGraficaDesplazando(const HistorialGlucosa * historial) {
+    PERFIL_INICIO(PERFIL_ZONA_DESPLAZA_GRAFICA);
+    desplazaGrafica(historial);
+    PERFIL_FIN(PERFIL_ZONA_DESPLAZA_GRAFICA);
+}
@@ -26,8 +26,15 @@
 
 #include "pantallaLCD.h"
 #include "interfazLCD.h"
+#include "tactilLCD.h"
+#include "sincroniaLCD.h"
+#include "energia.h"
+#include "perfilado.h"
+#include "telemetria.h"
+#include "tareas.h"
 #include "alarma9_60x60.h"
-#include "JuegoAlpha17.h"
+#include "rendimiento.h"
+#include <string.h>
 
 /* USER CODE END Includes */
 
@@ -94,6 +101,14 @@ void StartDefaultTask(void *argument);
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
+#ifdef RENDIMIENTO
+static void escribeRendimiento(const char * linea)
+{
+  // Benchmark results are sent as CSV lines through USART1
+  HAL_UART_Transmit(&huart1, (uint8_t *) linea, strlen(linea), HAL_MAX_DELAY);
+}
+#endif
+
 /* USER CODE END 0 */
 
 /**
@@ -134,6 +149,14 @@ int main(void)
   MX_TIM1_Init();
   MX_USART1_UART_Init();
   /* USER CODE BEGIN 2 */
+  /* Clock profiles and tickless idle, see energia.h */
+  inicializaEnergia();
+#ifdef PERFILADO
+  /* DWT zones and FreeRTOS run-time stats on TIM1, see perfilado.h */
+  inicializaPerfilado();
+#endif
+  /* Binary telemetry through USART1 with DMA, see telemetria.h */
+  inicializaTelemetria();
 
   /* USER CODE END 2 */
 
@@ -162,6 +185,9 @@ int main(void)
 
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
+#ifndef RENDIMIENTO
+  inicializaTareas();
+#endif
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
@@ -287,6 +313,15 @@ static void MX_DMA2D_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN DMA2D_Init 2 */
+#ifdef LCD_FORMATO_RGB565
+  /* Frame buffers in the RGB565 format of the LTDC layer */
+  hdma2d.Init.ColorMode = DMA2D_OUTPUT_RGB565;
+  hdma2d.LayerCfg[1].InputColorMode = DMA2D_INPUT_RGB565;
+  if (HAL_DMA2D_Init(&hdma2d) != HAL_OK || HAL_DMA2D_ConfigLayer(&hdma2d, 1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
 
   /* USER CODE END DMA2D_Init 2 */
 
@@ -397,6 +432,9 @@ static void MX_LTDC_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN LTDC_Init 2 */
+  /* Line event at the start of the vertical blanking, see sincroniaLCD.h */
+  HAL_NVIC_SetPriority(LTDC_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(LTDC_IRQn);
 
   /* USER CODE END LTDC_Init 2 */
 
@@ -652,6 +690,17 @@ static void MX_GPIO_Init(void)
   HAL_GPIO_Init(GPIOG, &GPIO_InitStruct);
 
 /* USER CODE BEGIN MX_GPIO_Init_2 */
+
+  /*Configure GPIO pin : TP_INT1_Pin as interrupt, it wakes up the touch task */
+  GPIO_InitStruct.Pin = TP_INT1_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  HAL_GPIO_Init(TP_INT1_GPIO_Port, &GPIO_InitStruct);
+
+  /* EXTI interrupt init: priority allowed to call FreeRTOS functions */
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
 /* USER CODE END MX_GPIO_Init_2 */
 }
 
@@ -662,6 +711,99 @@ void fBoton(){
 	contador=0;
 }
 
+/**
+  * @brief  EXTI lines 10 to 15 interrupt handler (TP_INT1 from the touch controller)
+  * @retval None
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  HAL_GPIO_EXTI_IRQHandler(TP_INT1_Pin);
+}
+
+/**
+  * @brief  EXTI line detection callback
+  * @param  GPIO_Pin: pin that raised the interrupt
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == TP_INT1_Pin)
+    LCD_interrupcionTactil();
+}
+
+#if configUSE_TICKLESS_IDLE == 0
+/**
+  * @brief  FreeRTOS idle hook (configUSE_IDLE_HOOK = 1): sleeps until the next interrupt, either the
+  *         FreeRTOS tick or TP_INT1, while every task is blocked. Only used without tickless idle: the
+  *         idle task calls the hook before vPortSuppressTicksAndSleep() in energia.c, so a WFI here
+  *         would first sleep until the next tick on every idle pass
+  * @retval None
+  */
+void vApplicationIdleHook(void)
+{
+  __WFI();
+}
+#endif
+
+#ifdef PERFILADO
+/**
+  * @brief  TIM1 update interrupt handler, extends the run-time stats counter to 32 bits
+  * @retval None
+  */
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+  HAL_TIM_IRQHandler(&htim1);
+}
+#endif
+
+/**
+  * @brief  LTDC global interrupt handler
+  * @retval None
+  */
+void LTDC_IRQHandler(void)
+{
+  HAL_LTDC_IRQHandler(&hltdc);
+}
+
+/**
+  * @brief  LTDC line event callback, programmed at the first line of the vertical blanking
+  * @param  hltdc: LTDC handle
+  * @retval None
+  */
+void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+  LCD_interrupcionLineaLTDC();
+}
+
+/**
+  * @brief  DMA2 stream 7 interrupt handler (USART1_TX, telemetry)
+  * @retval None
+  */
+void DMA2_Stream7_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(huart1.hdmatx);
+}
+
+/**
+  * @brief  USART1 global interrupt handler, signals the end of a DMA transmission
+  * @retval None
+  */
+void USART1_IRQHandler(void)
+{
+  HAL_UART_IRQHandler(&huart1);
+}
+
+/**
+  * @brief  UART transmission complete callback
+  * @param  huart: UART handle
+  * @retval None
+  */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart == &huart1)
+    finTransmisionTelemetria();
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartDefaultTask */
@@ -793,68 +935,15 @@ void StartDefaultTask(void *argument)
     /* init code for USB_HOST */
     MX_USB_HOST_Init();
 
-    // Initialize the LCD with two buffers, in horizontal mode
-    LCD_inicializa2Buffers(1);
-
-    srand(time(0));
-
-    // Set the background color to dark gray
-    LCD_setFondoColor(0x00000000);
-
-    int matriz[300] = {0};
-
-    // Draw initial text
-    LCD_dibujaCadenaCaracteresAlpha(10, 10, "Nivel Glucosa:", 0xFFFFFFFF, 2, &juegoAlpha17, 0, 100);
-
-    // Display the changes
-    LCD_intercambiaBuffers();
-
-    int k = 0;
-    int t = 0; // Variable for time
-
-
-    char nivelTexto[20]; // Buffer per il testo del valore
-    int nivelActual;
-
+#ifdef RENDIMIENTO
+    // Benchmark build: only the default task runs, so no other task preempts the measured frames
+    ejecutaRendimiento(RENDIMIENTO_ITERACIONES, escribeRendimiento);
     for(;;)
-    {
-        // Actualización de la matriz
-        LCD_setFondoColor(0x00000000);
-        inicializaGrafica();
-
-        // Disegna la scritta principale
-        LCD_dibujaCadenaCaracteresAlpha(10, 10, "Nivel Glucosa ", 0x00000000, 2, &juegoAlpha17, 0, 100);
-
-        if(k > 300) {
-            for (int i = 0; i < 300 - 1; i++) {
-                matriz[i] = matriz[i+1];
-            }
-
-
-            matriz[299] = 80 + (int)(40 * sin(0.02 * t));
-            nivelActual = matriz[299];
-        } else {
-            matriz[k] = 80 + (int)(40 * sin(0.02 * t));
-            nivelActual = matriz[k];
-        }
-
-        sprintf(nivelTexto, "%d mg/dL", nivelActual);
-        LCD_dibujaCadenaCaracteresAlpha(200, 10, nivelTexto, 0x00000000, 2, &juegoAlpha17, 0, 100);
-
-        if(nivelActual < 50) {
-        	LCD_dibujaRectanguloRelleno(45, 35, 230, 25, 0xFFFF0000, 0, 100);
-              LCD_dibujaCadenaCaracteresAlpha(50, 40, "Nivel bajo de glucosa!", 0xFFFFFFFF, 2, &juegoAlpha17, 0, 100);
-           }
-
-        // Draw the graph
-        dibujaGrafica(matriz);
-        LCD_intercambiaBuffers();
-
-        k++;
-        t++;
-
-        osDelay(50);
-    }
+      osDelay(1000);
+#else
+    // The default task renders the screen; sensor, control and logging run in their own tasks
+    tareaPantalla(argument);
+#endif
 }
 
 
@@ -877,6 +966,11 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
+#ifdef PERFILADO
+  if (htim->Instance == TIM1) {
+    desbordamientoPerfilado();
+  }
+#endif
 
   /* USER CODE END Callback 1 */
 }
@@ -0,0 +1,23 @@
+#include "memoriaSDRAM.h"
+#include <stddef.h>
+
+
+static uintptr_t siguiente = 0;  // Primera dirección sin reservar, 0 antes de la primera reserva
+
+
+void * reservaSDRAM(uint32_t bytes) {
+	if (siguiente == 0)
+		siguiente = SDRAM_DIRECCION_LIBRE;
+	uintptr_t direccion = (siguiente + 31) & ~(uintptr_t) 31;  // Alineación a 32 bytes
+	if (direccion + bytes > SDRAM_DIRECCION_FIN || direccion + bytes < direccion)
+		return NULL;
+	siguiente = direccion + bytes;
+	return (void *) direccion;
+}
+
+
+uint32_t libreSDRAM(void) {
+	if (siguiente == 0)
+		return SDRAM_DIRECCION_FIN - SDRAM_DIRECCION_LIBRE;
+	return SDRAM_DIRECCION_FIN - siguiente;
+}
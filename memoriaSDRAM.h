@@ -0,0 +1,53 @@
+#ifndef MEMORIASDRAM_H_
+#define MEMORIASDRAM_H_
+
+#include <stdint.h>
+#include "frameLCD.h"
+
+/**
+  * @file memoriaSDRAM.h
+  * @author EII
+  *
+  * @brief Reserva de memoria en la SDRAM externa de la placa STM32F429I-DISC1.
+  *
+  * La SDRAM de 8 MB se accede a través del FMC a partir de la dirección 0xD0000000. Al principio están
+  * los dos frame buffers de la pantalla y el resto se reparte con reservaSDRAM() para buffers que no
+  * caben en la RAM interna (fondos precalculados, historiales, cachés...). Las reservas no se liberan:
+  * están pensadas para hacerse durante la inicialización.
+  *
+  * En el simulador (LCD_SIMULADOR) la SDRAM es un vector del programa, ver frameLCD.h.
+  */
+
+
+/** @brief Dirección de la primera posición de la SDRAM que no ocupan los frame buffers */
+#ifndef SDRAM_DIRECCION_LIBRE
+#define SDRAM_DIRECCION_LIBRE (LCD_DIRECCION_BUFFERS + 2 * LCD_TAMANO_BUFFER)
+#endif
+
+/** @brief Tamaño de la SDRAM en bytes */
+#define SDRAM_TAMANO 0x00800000u
+
+/** @brief Dirección siguiente a la última posición de la SDRAM */
+#ifndef SDRAM_DIRECCION_FIN
+#define SDRAM_DIRECCION_FIN (LCD_DIRECCION_BUFFERS + SDRAM_TAMANO)
+#endif
+
+
+/**
+ * @brief Reserva una zona de la SDRAM
+ *
+ * La zona queda alineada a 32 bytes, lo que permite utilizarla como origen o destino del DMA2D.
+ *
+ * @param bytes Tamaño de la zona en bytes
+ * @return Puntero a la zona reservada, o NULL si no queda espacio suficiente
+ */
+void * reservaSDRAM(uint32_t bytes);
+
+
+/**
+ * @brief Número de bytes de la SDRAM que quedan sin reservar
+ */
+uint32_t libreSDRAM(void);
+
+
+#endif /* MEMORIASDRAM_H_ */
@@ -0,0 +1,202 @@
+#include "perfilado.h"
+
+#ifdef PERFILADO
+
+#include <stdio.h>
+#include "cmsis_os.h"
+
+#ifdef LCD_SIMULADOR
+#include <time.h>
+
+#define UNIDAD "ns"
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define UNIDAD "ciclos"
+
+extern TIM_HandleTypeDef htim1;  // Inicializado en main.c
+#endif
+
+
+typedef struct {
+	uint32_t llamadas;
+	uint64_t total;
+	uint32_t maximo;
+} AcumuladoZona;
+
+typedef struct {
+	osThreadId_t id;  // NULL si la entrada está libre
+	AcumuladoZona zonas[PERFIL_NUM_ZONAS];
+	MuestraPerfil muestras[PERFIL_MUESTRAS];
+	volatile uint32_t cabeza;  // Sólo la escribe la tarea medida
+	volatile uint32_t cola;  // Sólo la escribe quien lee las medidas
+	uint32_t perdidas;
+} PerfilTarea;
+
+static PerfilTarea tareas[PERFIL_TAREAS];
+static uint32_t tareasDescartadas = 0;  // Medidas de tareas que no caben en la tabla
+
+static const char * const nombresZonas[PERFIL_NUM_ZONAS] = {
+	"intercambiaBuffers", "inicializaGrafica", "dibujaGrafica", "dibujaGraficaResumen", "dibujaGraficaDesplazando",
+	"LCD_atiendeEtiqueta", "LCD_atiendeImagen", "LCD_atiendeBoton", "LCD_atiendeInterruptor",
+	"LCD_atiendeBarra", "LCD_atiendeEditor", "LCD_atiendeEventosTactiles", "LCD_atiendeEscena"};
+
+#ifndef LCD_SIMULADOR
+static volatile uint32_t desbordamientosTIM1 = 0;  // Bits altos del contador de las estadísticas
+#endif
+
+
+#ifdef LCD_SIMULADOR
+uint32_t contadorPerfilado(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint32_t) t.tv_sec * 1000000000u + t.tv_nsec;  // Las diferencias son correctas aunque desborde
+}
+#endif
+
+
+static PerfilTarea * tareaActual(void) {
+// Entrada de la tarea que llama. La primera vez ocupa una libre sin bloquear a las demás
+
+	osThreadId_t id = osThreadGetId();
+	for (int i = 0; i < PERFIL_TAREAS; i++) {
+		if (tareas[i].id == id)
+			return &tareas[i];
+		osThreadId_t libre = NULL;
+		if (tareas[i].id == NULL && __atomic_compare_exchange_n(&tareas[i].id, &libre, id, 0, __ATOMIC_SEQ_CST,
+				__ATOMIC_SEQ_CST))
+			return &tareas[i];
+	}
+	return NULL;
+}
+
+
+void inicializaPerfilado(void) {
+#ifndef LCD_SIMULADOR
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // Habilita el DWT
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+	for (int i = 0; i < PERFIL_TAREAS; i++)
+		tareas[i] = (PerfilTarea) {0};
+	tareasDescartadas = 0;
+}
+
+
+void anotaPerfilado(ZonaPerfil zona, uint32_t inicio) {
+	uint32_t duracion = contadorPerfilado() - inicio;
+	PerfilTarea * t = tareaActual();
+	if (t == NULL) {
+		tareasDescartadas++;
+		return;
+	}
+
+	AcumuladoZona * z = &t->zonas[zona];
+	z->llamadas++;
+	z->total += duracion;
+	if (duracion > z->maximo)
+		z->maximo = duracion;
+
+	uint32_t cabeza = t->cabeza;
+	if (cabeza - t->cola == PERFIL_MUESTRAS) {
+		t->perdidas++;
+		return;
+	}
+	t->muestras[cabeza % PERFIL_MUESTRAS] = (MuestraPerfil) {zona, inicio, duracion};
+	__atomic_signal_fence(__ATOMIC_RELEASE);  // La medida queda escrita antes de publicarla
+	t->cabeza = cabeza + 1;
+}
+
+
+int leeMuestraPerfilado(uint32_t tarea, MuestraPerfil * muestra) {
+	if (tarea >= PERFIL_TAREAS)
+		return 0;
+	PerfilTarea * t = &tareas[tarea];
+	uint32_t cola = t->cola;
+	if (cola == t->cabeza)
+		return 0;
+	__atomic_signal_fence(__ATOMIC_ACQUIRE);
+	*muestra = t->muestras[cola % PERFIL_MUESTRAS];
+	t->cola = cola + 1;
+	return 1;
+}
+
+
+static const char * nombreTarea(const PerfilTarea * t) {
+	const char * nombre = osThreadGetName(t->id);
+	return nombre != NULL ? nombre : "?";
+}
+
+
+void informePerfilado(void (*escribe)(const char * linea)) {
+	char linea[120];
+	escribe("tarea,zona,llamadas,unidad,medio,maximo,perdidas_tarea\n");
+	for (int i = 0; i < PERFIL_TAREAS && tareas[i].id != NULL; i++) {
+		const PerfilTarea * t = &tareas[i];
+		for (int z = 0; z < PERFIL_NUM_ZONAS; z++) {
+			const AcumuladoZona * acumulado = &t->zonas[z];
+			if (acumulado->llamadas == 0)
+				continue;
+			snprintf(linea, sizeof(linea), "%s,%s,%lu,%s,%lu,%lu,%lu\n", nombreTarea(t), nombresZonas[z],
+				(unsigned long) acumulado->llamadas, UNIDAD,
+				(unsigned long) (acumulado->total / acumulado->llamadas), (unsigned long) acumulado->maximo,
+				(unsigned long) t->perdidas);
+			escribe(linea);
+		}
+	}
+
+#ifndef LCD_SIMULADOR
+	TaskStatus_t estados[PERFIL_TAREAS * 2];
+	uint32_t total;
+	UBaseType_t n = uxTaskGetSystemState(estados, PERFIL_TAREAS * 2, &total);
+	escribe("tarea,cpu,porcentaje\n");
+	for (UBaseType_t i = 0; i < n && total > 0; i++) {
+		snprintf(linea, sizeof(linea), "%s,cpu,%lu\n", estados[i].pcTaskName,
+			(unsigned long) ((uint64_t) estados[i].ulRunTimeCounter * 100 / total));
+		escribe(linea);
+	}
+#endif
+}
+
+
+#ifdef LCD_SIMULADOR
+
+void ajustaRelojPerfilado(void) {
+}
+
+#else
+
+void ajustaRelojPerfilado(void) {
+	__HAL_TIM_SET_PRESCALER(&htim1, HAL_RCC_GetPCLK2Freq() / PERFIL_FRECUENCIA_TIM1 - 1);
+	// APB2 sin divisor en los dos perfiles de energia.h, así que TIM1 cuenta a PCLK2
+}
+
+
+void desbordamientoPerfilado(void) {
+	desbordamientosTIM1++;
+}
+
+
+void configureTimerForRunTimeStats(void) {
+	ajustaRelojPerfilado();
+	HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+	HAL_TIM_Base_Start_IT(&htim1);
+}
+
+
+unsigned long getRunTimeCounterValue(void) {
+// Contador de 32 bits con los 16 de TIM1. Se llama con las interrupciones enmascaradas, así que un
+// desbordamiento puede no estar contado aún
+
+	uint32_t alto = desbordamientosTIM1;
+	uint32_t bajo = __HAL_TIM_GET_COUNTER(&htim1);
+	if (__HAL_TIM_GET_FLAG(&htim1, TIM_FLAG_UPDATE) && bajo < 0x8000)
+		alto++;
+	return (alto << 16) | bajo;
+}
+
+#endif
+
+#endif /* PERFILADO */
@@ -0,0 +1,196 @@
+#ifndef PERFILADO_H_
+#define PERFILADO_H_
+
+#include <stdint.h>
+
+/**
+  * @file perfilado.h
+  * @author EII
+  *
+  * @brief Medida del tiempo que pasa cada tarea en las zonas de código marcadas, y de la CPU por tarea.
+  *
+  * Una zona empieza con PERFIL_INICIO(zona) y termina con PERFIL_FIN(zona) en la misma función, antes de
+  * cada return. Sólo existen al compilar con -DPERFILADO: si no, las macros no generan código y este
+  * módulo queda vacío.
+  *
+  * Las zonas se miden en ciclos con el contador DWT->CYCCNT; en el simulador (LCD_SIMULADOR) en
+  * nanosegundos. Cada tarea que pasa por una zona ocupa una entrada de la tabla de tareas, hasta
+  * PERFIL_TAREAS, donde acumula las llamadas, el total y el máximo de cada zona y guarda cada medida en un
+  * buffer circular propio. Como en cada entrada sólo escribe su tarea, no hacen falta mutex ni secciones
+  * críticas. Si el buffer está lleno, la medida sólo se acumula y se cuenta como perdida.
+  *
+  * Ya están marcadas LCD_intercambiaBuffersRegiones() alrededor de LCD_intercambiaBuffers(),
+  * inicializaGrafica(), dibujaGrafica(), dibujaGraficaResumen(), dibujaGraficaDesplazando() y todas las
+  * funciones LCD_atiende*.
+  *
+  * En la placa también da las estadísticas de tiempo de ejecución de FreeRTOS, contadas con TIM1 a
+  * PERFIL_FRECUENCIA_TIM1 Hz y extendido a 32 bits con su interrupción de desbordamiento. Requiere en
+  * FreeRTOSConfig.h:
+  * @code{.c}
+  * #define configGENERATE_RUN_TIME_STATS 1
+  * #define configUSE_TRACE_FACILITY 1
+  * #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+  * #define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+  * @endcode
+  *
+  * informePerfilado() escribe todo en CSV, una línea por zona y tarea y otra por tarea:
+  * @code
+  * tarea,zona,llamadas,unidad,medio,maximo,perdidas_tarea
+  * defaultTask,dibujaGraficaDesplazando,812,ciclos,20431,96012,0
+  * tarea,cpu,porcentaje
+  * defaultTask,cpu,37
+  * @endcode
+  *
+  * Ejemplo:
+  * @code{.c}
+  * void dibujaMenu(void) {
+  *     PERFIL_INICIO(PERFIL_ZONA_ATIENDE_ESCENA);
+  *     ...
+  *     PERFIL_FIN(PERFIL_ZONA_ATIENDE_ESCENA);
+  * }
+  * @endcode
+  */
+
+
+/** @brief Número máximo de tareas que pueden pasar por zonas medidas */
+#ifndef PERFIL_TAREAS
+#define PERFIL_TAREAS 8
+#endif
+
+/** @brief Medidas que caben en el buffer circular de cada tarea. Potencia de 2 */
+#ifndef PERFIL_MUESTRAS
+#define PERFIL_MUESTRAS 64
+#endif
+
+/** @brief Frecuencia en Hz de TIM1 para las estadísticas de FreeRTOS */
+#ifndef PERFIL_FRECUENCIA_TIM1
+#define PERFIL_FRECUENCIA_TIM1 100000
+#endif
+
+
+/**
+ * @brief Zonas medidas
+ */
+typedef enum {
+    /** @brief LCD_intercambiaBuffers() */
+    PERFIL_ZONA_INTERCAMBIA_BUFFERS,
+    /** @brief inicializaGrafica() */
+    PERFIL_ZONA_INICIALIZA_GRAFICA,
+    /** @brief dibujaGrafica() */
+    PERFIL_ZONA_DIBUJA_GRAFICA,
+    /** @brief dibujaGraficaResumen() */
+    PERFIL_ZONA_DIBUJA_RESUMEN,
+    /** @brief dibujaGraficaDesplazando() */
+    PERFIL_ZONA_DESPLAZA_GRAFICA,
+    /** @brief LCD_atiendeEtiqueta() */
+    PERFIL_ZONA_ATIENDE_ETIQUETA,
+    /** @brief LCD_atiendeImagen() */
+    PERFIL_ZONA_ATIENDE_IMAGEN,
+    /** @brief LCD_atiendeBoton() */
+    PERFIL_ZONA_ATIENDE_BOTON,
+    /** @brief LCD_atiendeInterruptor() */
+    PERFIL_ZONA_ATIENDE_INTERRUPTOR,
+    /** @brief LCD_atiendeBarra() */
+    PERFIL_ZONA_ATIENDE_BARRA,
+    /** @brief LCD_atiendeEditor() */
+    PERFIL_ZONA_ATIENDE_EDITOR,
+    /** @brief LCD_atiendeEventosTactiles() */
+    PERFIL_ZONA_ATIENDE_EVENTOS_TACTILES,
+    /** @brief LCD_atiendeEscena() */
+    PERFIL_ZONA_ATIENDE_ESCENA,
+    /** @brief Número de zonas */
+    PERFIL_NUM_ZONAS} ZonaPerfil;
+
+
+/**
+ * @brief Medida de una zona
+ */
+typedef struct {
+    /** @brief Zona medida */
+    uint8_t zona;
+    /** @brief Valor del contador al entrar en la zona */
+    uint32_t inicio;
+    /** @brief Duración en ciclos, o en ns en el simulador */
+    uint32_t duracion;
+} MuestraPerfil;
+
+
+#ifdef PERFILADO
+
+#ifdef LCD_SIMULADOR
+uint32_t contadorPerfilado(void);
+#else
+#include "main.h"
+#define contadorPerfilado() (DWT->CYCCNT)
+#endif
+
+/** @brief Empieza a medir una zona */
+#define PERFIL_INICIO(zona) uint32_t perfilInicio##zona = contadorPerfilado()
+
+/** @brief Termina de medir una zona empezada en la misma función */
+#define PERFIL_FIN(zona) anotaPerfilado(zona, perfilInicio##zona)
+
+
+/**
+ * @brief Habilita el contador de ciclos del DWT y vacía las medidas
+ *
+ * Hay que llamarla antes de crear las tareas.
+ */
+void inicializaPerfilado(void);
+
+
+/**
+ * @brief Anota una medida de la tarea actual. La llama PERFIL_FIN()
+ *
+ * @param zona Zona medida
+ * @param inicio Valor del contador al entrar en la zona
+ */
+void anotaPerfilado(ZonaPerfil zona, uint32_t inicio);
+
+
+/**
+ * @brief Extrae la medida más antigua del buffer circular de una tarea
+ *
+ * Sólo la puede llamar una tarea a la vez, que no tiene por qué ser la medida.
+ *
+ * @param tarea Índice de la tarea en la tabla, de 0 a PERFIL_TAREAS - 1
+ * @param muestra Puntero donde se copia la medida
+ * @return Buleano cierto si había alguna medida
+ */
+int leeMuestraPerfilado(uint32_t tarea, MuestraPerfil * muestra);
+
+
+/**
+ * @brief Escribe en CSV las medidas acumuladas de cada zona y tarea y la CPU usada por cada tarea
+ *
+ * @param escribe Función que recibe cada línea, terminada en '\\n'
+ */
+void informePerfilado(void (*escribe)(const char * linea));
+
+
+/**
+ * @brief Ajusta el prescaler de TIM1 a la frecuencia actual de PCLK2
+ *
+ * La llama setPerfilEnergia() (ver energia.h) tras cambiar el reloj.
+ */
+void ajustaRelojPerfilado(void);
+
+
+#ifndef LCD_SIMULADOR
+/**
+ * @brief Cuenta un desbordamiento de TIM1
+ *
+ * Se llama desde HAL_TIM_PeriodElapsedCallback() cuando la interrupción es de TIM1.
+ */
+void desbordamientoPerfilado(void);
+#endif
+
+#else
+
+#define PERFIL_INICIO(zona)
+#define PERFIL_FIN(zona)
+
+#endif /* PERFILADO */
+
+
+#endif /* PERFILADO_H_ */
@@ -0,0 +1,134 @@
+#include "piramideGlucosa.h"
+#include <stddef.h>
+#include "memoriaSDRAM.h"
+
+
+static const uint32_t capacidadNivel[PIRAMIDE_NUM_NIVELES] = {PIRAMIDE_CAPACIDAD_HORAS, PIRAMIDE_CAPACIDAD_DIAS};
+static const uint32_t periodosNivel[PIRAMIDE_NUM_NIVELES] = {PIRAMIDE_MUESTRAS_HORA, PIRAMIDE_MUESTRAS_DIA};
+
+
+int inicializaPiramide(PiramideGlucosa * pPiramide) {
+	if (pPiramide->muestras == NULL)
+		pPiramide->muestras = reservaSDRAM(PIRAMIDE_CAPACIDAD_MUESTRAS * sizeof(int16_t));
+	pPiramide->cabeza = 0;
+	pPiramide->numMuestras = 0;
+	pPiramide->totalMuestras = 0;
+
+	int reservada = pPiramide->muestras != NULL;
+	for (int n = 0; n < PIRAMIDE_NUM_NIVELES; n++) {
+		NivelAgregados * nivel = &pPiramide->niveles[n];
+		if (nivel->agregados == NULL)
+			nivel->agregados = reservaSDRAM(capacidadNivel[n] * sizeof(AgregadoGlucosa));
+		nivel->capacidad = capacidadNivel[n];
+		nivel->periodosAgregado = periodosNivel[n];
+		nivel->cabeza = 0;
+		nivel->numAgregados = 0;
+		reservada = reservada && nivel->agregados != NULL;
+	}
+	return reservada;
+}
+
+
+static void acumulaAgregado(int valor, AgregadoGlucosa * agregado) {
+	if (agregado->numMuestras == 0 || valor < agregado->minimo)
+		agregado->minimo = valor;
+	if (agregado->numMuestras == 0 || valor > agregado->maximo)
+		agregado->maximo = valor;
+	agregado->suma += valor;
+	agregado->numMuestras++;
+}
+
+
+static void anadeNivel(int valor, NivelAgregados * nivel) {
+	AgregadoGlucosa * agregado = &nivel->agregados[nivel->cabeza];
+	if (nivel->numAgregados == 0 || agregado->periodos == nivel->periodosAgregado) {
+		// Empieza un agregado nuevo, sobrescribiendo el más antiguo si el buffer está lleno
+		if (nivel->numAgregados > 0 && ++nivel->cabeza == nivel->capacidad)
+			nivel->cabeza = 0;
+		if (nivel->numAgregados < nivel->capacidad)
+			nivel->numAgregados++;
+		agregado = &nivel->agregados[nivel->cabeza];
+		*agregado = (AgregadoGlucosa) {0, 0, 0, 0, 0};
+	}
+	agregado->periodos++;
+	if (valor != 0)  // Los huecos sólo cuentan como periodo
+		acumulaAgregado(valor, agregado);
+}
+
+
+void anadePiramide(int valor, PiramideGlucosa * pPiramide) {
+	if (pPiramide->muestras == NULL)
+		return;  // Sin SDRAM reservada
+
+	pPiramide->muestras[pPiramide->cabeza] = valor;
+	if (++pPiramide->cabeza == PIRAMIDE_CAPACIDAD_MUESTRAS)
+		pPiramide->cabeza = 0;
+	if (pPiramide->numMuestras < PIRAMIDE_CAPACIDAD_MUESTRAS)
+		pPiramide->numMuestras++;
+	pPiramide->totalMuestras++;
+
+	for (int n = 0; n < PIRAMIDE_NUM_NIVELES; n++)
+		if (pPiramide->niveles[n].agregados != NULL)
+			anadeNivel(valor, &pPiramide->niveles[n]);
+}
+
+
+int rellenaPiramide(uint32_t antiguedad, int valor, PiramideGlucosa * pPiramide) {
+	if (pPiramide->muestras == NULL || antiguedad >= pPiramide->numMuestras)
+		return 0;
+	uint32_t posicion = (pPiramide->cabeza + PIRAMIDE_CAPACIDAD_MUESTRAS - 1 - antiguedad) %
+		PIRAMIDE_CAPACIDAD_MUESTRAS;
+	if (pPiramide->muestras[posicion] != 0)
+		return 0;
+	pPiramide->muestras[posicion] = valor;
+
+	// Los agregados empiezan cada 'periodosAgregado' mediciones desde la primera, así que el de la
+	// medición está tantos agregados antes del que está en curso como indique su número de orden
+	uint32_t orden = pPiramide->totalMuestras - 1 - antiguedad;
+	for (int n = 0; n < PIRAMIDE_NUM_NIVELES; n++) {
+		NivelAgregados * nivel = &pPiramide->niveles[n];
+		if (nivel->agregados == NULL)
+			continue;
+		uint32_t periodos = nivel->periodosAgregado;
+		uint32_t atras = (pPiramide->totalMuestras - 1) / periodos - orden / periodos;
+		if (atras < nivel->numAgregados)
+			acumulaAgregado(valor, &nivel->agregados[(nivel->cabeza + nivel->capacidad - atras) % nivel->capacidad]);
+	}
+	return 1;
+}
+
+
+uint32_t numMuestrasPiramide(const PiramideGlucosa * pPiramide) {
+	return pPiramide->numMuestras;
+}
+
+
+uint32_t totalMuestrasPiramide(const PiramideGlucosa * pPiramide) {
+	return pPiramide->totalMuestras;
+}
+
+
+int muestraPiramide(uint32_t indice, const PiramideGlucosa * pPiramide) {
+	uint32_t posicion = pPiramide->cabeza + indice + PIRAMIDE_CAPACIDAD_MUESTRAS - pPiramide->numMuestras;
+	return pPiramide->muestras[posicion % PIRAMIDE_CAPACIDAD_MUESTRAS];
+}
+
+
+uint32_t numAgregadosPiramide(NivelPiramide nivel, const PiramideGlucosa * pPiramide) {
+	return pPiramide->niveles[nivel].numAgregados;
+}
+
+
+const AgregadoGlucosa * agregadoPiramide(NivelPiramide nivel, uint32_t indice, const PiramideGlucosa * pPiramide) {
+	const NivelAgregados * n = &pPiramide->niveles[nivel];
+	uint32_t posicion = n->cabeza + 1 + indice + n->capacidad - n->numAgregados;
+	// El más antiguo está justo detrás del que está en curso cuando el buffer está lleno, y en 0 si no
+	return &n->agregados[posicion % n->capacidad];
+}
+
+
+int mediaAgregado(const AgregadoGlucosa * agregado) {
+	if (agregado->numMuestras == 0)
+		return 0;
+	return (agregado->suma + agregado->numMuestras / 2) / agregado->numMuestras;
+}
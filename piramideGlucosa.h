@@ -0,0 +1,208 @@
+#ifndef PIRAMIDEGLUCOSA_H_
+#define PIRAMIDEGLUCOSA_H_
+
+#include <stdint.h>
+
+/**
+  * @file piramideGlucosa.h
+  * @author EII
+  *
+  * @brief Historial de glucosa a varias resoluciones: mediciones cada 5 minutos, agregados por hora y por día.
+  *
+  * Cada medición ocupa un periodo de 5 minutos. La pirámide guarda las últimas PIRAMIDE_CAPACIDAD_MUESTRAS
+  * mediciones tal cual y, por encima, dos niveles de agregados con el mínimo, el máximo, la suma y el número
+  * de mediciones de cada hora (PIRAMIDE_MUESTRAS_HORA periodos) y de cada día (PIRAMIDE_MUESTRAS_DIA
+  * periodos). Cada medición se suma en tiempo constante a la hora y al día en curso, que se pueden
+  * consultar mientras se llenan, así que una gráfica o unas estadísticas de una semana o de un mes leen
+  * directamente los agregados del nivel que les conviene en lugar de recorrer todas las mediciones.
+  *
+  * Las mediciones a 0 son huecos sin dato: ocupan su periodo pero no cuentan en los agregados.
+  *
+  * Los tres buffers circulares están en la SDRAM (ver memoriaSDRAM.h), que se reserva la primera vez que
+  * se inicializa la pirámide. La estructura sólo guarda los punteros y los índices, y tiene que empezar a
+  * cero, como una variable global o estática. No tiene protección para varias tareas: se usa desde la
+  * tarea de la pantalla, igual que HistorialGlucosa.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static PiramideGlucosa piramide;
+  * if (!inicializaPiramide(&piramide))
+  *     ...  // No queda SDRAM
+  *
+  * anadePiramide(95, &piramide);
+  * uint32_t n = numAgregadosPiramide(PIRAMIDE_NIVEL_HORA, &piramide);
+  * for (uint32_t i = n > 24 * 7 ? n - 24 * 7 : 0; i < n; i++)  // La última semana, hora a hora
+  *     ...  mediaAgregado(agregadoPiramide(PIRAMIDE_NIVEL_HORA, i, &piramide)) ...
+  * @endcode
+  */
+
+
+/** @brief Mediciones (periodos de 5 minutos) de cada agregado por hora */
+#define PIRAMIDE_MUESTRAS_HORA 12
+
+/** @brief Mediciones (periodos de 5 minutos) de cada agregado por día */
+#define PIRAMIDE_MUESTRAS_DIA (24 * PIRAMIDE_MUESTRAS_HORA)
+
+/** @brief Mediciones que se guardan sin agregar. 14 días */
+#ifndef PIRAMIDE_CAPACIDAD_MUESTRAS
+#define PIRAMIDE_CAPACIDAD_MUESTRAS (14 * PIRAMIDE_MUESTRAS_DIA)
+#endif
+
+/** @brief Agregados por hora que se guardan. 90 días */
+#ifndef PIRAMIDE_CAPACIDAD_HORAS
+#define PIRAMIDE_CAPACIDAD_HORAS (90 * 24)
+#endif
+
+/** @brief Agregados por día que se guardan. 2 años */
+#ifndef PIRAMIDE_CAPACIDAD_DIAS
+#define PIRAMIDE_CAPACIDAD_DIAS 730
+#endif
+
+
+/**
+ * @brief Niveles de agregados de la pirámide
+ */
+typedef enum {
+    /** @brief Un agregado por hora */
+    PIRAMIDE_NIVEL_HORA,
+    /** @brief Un agregado por día */
+    PIRAMIDE_NIVEL_DIA,
+    /** @brief Número de niveles */
+    PIRAMIDE_NUM_NIVELES} NivelPiramide;
+
+
+/**
+ * @brief Mediciones de una hora o de un día
+ */
+typedef struct {
+    /** @brief Suma de las mediciones en mg/dL */
+    uint32_t suma;
+    /** @brief Medición mínima en mg/dL */
+    int16_t minimo;
+    /** @brief Medición máxima en mg/dL */
+    int16_t maximo;
+    /** @brief Número de mediciones distintas de 0. Si es 0 el agregado no tiene datos */
+    uint16_t numMuestras;
+    /** @brief Número de periodos transcurridos, incluidos los huecos. Es menor que el del nivel mientras
+     * el agregado está en curso */
+    uint16_t periodos;
+} AgregadoGlucosa;
+
+
+/**
+ * @brief Buffer circular de agregados de un nivel
+ */
+typedef struct {
+    /** @brief Agregados, en la SDRAM */
+    AgregadoGlucosa * agregados;
+    /** @brief Número máximo de agregados */
+    uint32_t capacidad;
+    /** @brief Periodos de cada agregado */
+    uint32_t periodosAgregado;
+    /** @brief Posición del agregado en curso */
+    uint32_t cabeza;
+    /** @brief Número de agregados guardados, incluido el que está en curso */
+    uint32_t numAgregados;
+} NivelAgregados;
+
+
+/**
+ * @brief Historial de glucosa a varias resoluciones
+ *
+ * @see inicializaPiramide(), anadePiramide(), muestraPiramide(), agregadoPiramide()
+ */
+typedef struct {
+    /** @brief Mediciones sin agregar, en la SDRAM */
+    int16_t * muestras;
+    /** @brief Posición donde se guardará la próxima medición */
+    uint32_t cabeza;
+    /** @brief Número de mediciones guardadas. Como mucho PIRAMIDE_CAPACIDAD_MUESTRAS */
+    uint32_t numMuestras;
+    /** @brief Número de mediciones añadidas desde la inicialización */
+    uint32_t totalMuestras;
+    /** @brief Niveles de agregados */
+    NivelAgregados niveles[PIRAMIDE_NUM_NIVELES];
+} PiramideGlucosa;
+
+
+/**
+ * @brief Vacía la pirámide, reservando sus buffers en la SDRAM si aún no los tiene
+ *
+ * @param pPiramide Puntero a la estructura que representa a la pirámide, a cero la primera vez
+ * @return Buleano cierto si tiene los buffers reservados. Si no queda SDRAM, la pirámide no se puede usar
+ */
+int inicializaPiramide(PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Añade una medición a la pirámide y a los agregados en curso, en tiempo constante
+ *
+ * Cuando un agregado completa sus periodos, la siguiente medición empieza otro. Si un buffer está lleno
+ * se sobrescribe su elemento más antiguo.
+ *
+ * @param valor Medición de glucosa en mg/dL, o 0 si no hay dato
+ * @param pPiramide Puntero a la estructura que representa a la pirámide
+ */
+void anadePiramide(int valor, PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Rellena un hueco con la medición que ha llegado más tarde, y la suma a sus agregados
+ *
+ * Los agregados que ya se han sobrescrito no cambian. Cuesta lo mismo sea cual sea la antigüedad.
+ *
+ * @param antiguedad Posición del hueco contando desde la medición más reciente, que es la 0
+ * @param valor Medición de glucosa en mg/dL
+ * @param pPiramide Puntero a la pirámide
+ * @return Buleano cierto si la medición estaba en la pirámide y era un hueco
+ */
+int rellenaPiramide(uint32_t antiguedad, int valor, PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Número de mediciones sin agregar guardadas
+ */
+uint32_t numMuestrasPiramide(const PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Número de mediciones añadidas desde la inicialización
+ */
+uint32_t totalMuestrasPiramide(const PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Medición sin agregar en orden cronológico
+ *
+ * @param indice Índice de la medición, de 0 (la más antigua) a numMuestrasPiramide() - 1 (la última)
+ * @param pPiramide Puntero a la pirámide
+ * @return Medición en mg/dL, o 0 si es un hueco
+ */
+int muestraPiramide(uint32_t indice, const PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Número de agregados guardados de un nivel, incluido el que está en curso
+ */
+uint32_t numAgregadosPiramide(NivelPiramide nivel, const PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Agregado de un nivel en orden cronológico
+ *
+ * @param nivel Nivel de agregados
+ * @param indice Índice del agregado, de 0 (el más antiguo) a numAgregadosPiramide() - 1 (el que está en
+ *     curso)
+ * @param pPiramide Puntero a la pirámide
+ * @return Puntero al agregado, en la SDRAM
+ */
+const AgregadoGlucosa * agregadoPiramide(NivelPiramide nivel, uint32_t indice, const PiramideGlucosa * pPiramide);
+
+
+/**
+ * @brief Media de las mediciones de un agregado en mg/dL, redondeada, o 0 si no tiene datos
+ */
+int mediaAgregado(const AgregadoGlucosa * agregado);
+
+
+#endif /* PIRAMIDEGLUCOSA_H_ */
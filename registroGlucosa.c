@@ -0,0 +1,233 @@
+#include "registroGlucosa.h"
+#include <stddef.h>
+#include "memoriaSDRAM.h"
+
+#ifndef LCD_SIMULADOR
+#include "main.h"
+
+extern CRC_HandleTypeDef hcrc;  // Inicializado en main.c
+#endif
+
+
+#define PALABRAS_CRC ((REGISTRO_BLOQUE_BYTES - 4) / 4)  // Todo el bloque menos el CRC
+
+
+static uint32_t calculaCRC(const BloqueRegistro * bloque) {
+#ifdef LCD_SIMULADOR
+	// Como la unidad CRC: polinomio 0x04C11DB7, valor inicial 0xFFFFFFFF, palabra a palabra desde el bit alto
+	const uint32_t * palabras = (const uint32_t *) bloque;
+	uint32_t crc = 0xFFFFFFFF;
+	for (int i = 0; i < PALABRAS_CRC; i++) {
+		crc ^= palabras[i];
+		for (int b = 0; b < 32; b++)
+			crc = crc & 0x80000000u ? (crc << 1) ^ 0x04C11DB7u : crc << 1;
+	}
+	return crc;
+#else
+	return HAL_CRC_Calculate(&hcrc, (uint32_t *) bloque, PALABRAS_CRC);
+#endif
+}
+
+
+static BloqueRegistro * bloque(uint32_t indice, const RegistroGlucosa * pRegistro) {
+	uint32_t posicion = pRegistro->cabeza + 1 + indice + REGISTRO_BLOQUES - pRegistro->numBloques;
+	// El más antiguo está justo detrás del que se está llenando cuando el buffer está lleno, y en 0 si no
+	return &pRegistro->bloques[posicion % REGISTRO_BLOQUES];
+}
+
+
+int inicializaRegistroGlucosa(uint32_t periodo, RegistroGlucosa * pRegistro) {
+	if (pRegistro->bloques == NULL)
+		pRegistro->bloques = reservaSDRAM(REGISTRO_BLOQUES * sizeof(BloqueRegistro));
+	pRegistro->periodo = periodo;
+	pRegistro->cabeza = 0;
+	pRegistro->numBloques = 0;
+	pRegistro->ultimo = 0;
+	return pRegistro->bloques != NULL;
+}
+
+
+static uint32_t codifica(int diferencia, uint8_t * bytes) {
+// Escribe una diferencia en zig-zag y varint y devuelve el número de bytes
+
+	uint32_t zigzag = ((uint32_t) diferencia << 1) ^ (uint32_t) (diferencia >> 31);
+	uint32_t n = 0;
+	while (zigzag >= 0x80) {
+		bytes[n++] = (zigzag & 0x7F) | 0x80;
+		zigzag >>= 7;
+	}
+	bytes[n++] = zigzag;
+	return n;
+}
+
+
+static int decodifica(const BloqueRegistro * b, uint32_t * posicion) {
+// Lee la diferencia que empieza en 'posicion' y la deja apuntando a la siguiente
+
+	uint32_t zigzag = 0;
+	for (int desplazamiento = 0; *posicion < b->numBytes && desplazamiento < 32; desplazamiento += 7) {
+		uint8_t byte = b->datos[(*posicion)++];
+		zigzag |= (uint32_t) (byte & 0x7F) << desplazamiento;
+		if ((byte & 0x80) == 0)
+			break;
+	}
+	return (int) (zigzag >> 1) ^ -(int) (zigzag & 1);
+}
+
+
+void anadeRegistroGlucosa(uint32_t instante, int valor, RegistroGlucosa * pRegistro) {
+	if (pRegistro->bloques == NULL)
+		return;  // Sin SDRAM reservada
+
+	uint8_t bytes[5];
+	uint32_t n = codifica(valor - pRegistro->ultimo, bytes);
+	BloqueRegistro * b = &pRegistro->bloques[pRegistro->cabeza];
+	pRegistro->ultimo = valor;
+	if (pRegistro->numBloques > 0 && b->numMuestras < 255 && b->numBytes + n <= REGISTRO_BYTES_DATOS &&
+			instante == b->instante + b->numMuestras * pRegistro->periodo) {
+		for (uint32_t i = 0; i < n; i++)
+			b->datos[b->numBytes++] = bytes[i];
+		b->numMuestras++;
+		return;
+	}
+
+	// Cierra el bloque actual y empieza otro, sobrescribiendo el más antiguo si el buffer está lleno
+	if (pRegistro->numBloques > 0) {
+		b->crc = calculaCRC(b);
+		if (++pRegistro->cabeza == REGISTRO_BLOQUES)
+			pRegistro->cabeza = 0;
+		b = &pRegistro->bloques[pRegistro->cabeza];
+	}
+	if (pRegistro->numBloques < REGISTRO_BLOQUES)
+		pRegistro->numBloques++;
+	b->instante = instante;
+	b->primerValor = valor;
+	b->numMuestras = 1;
+	b->numBytes = 0;
+	b->crc = 0;
+}
+
+
+uint32_t numBloquesRegistroGlucosa(const RegistroGlucosa * pRegistro) {
+	return pRegistro->numBloques;
+}
+
+
+const BloqueRegistro * bloqueRegistroGlucosa(uint32_t indice, const RegistroGlucosa * pRegistro) {
+	return bloque(indice, pRegistro);
+}
+
+
+int compruebaBloqueRegistroGlucosa(uint32_t indice, const RegistroGlucosa * pRegistro) {
+	if (indice + 1 == pRegistro->numBloques)
+		return 1;  // Se está llenando, aún sin CRC
+	const BloqueRegistro * b = bloque(indice, pRegistro);
+	return b->crc == calculaCRC(b);
+}
+
+
+static uint32_t buscaBloque(uint32_t instante, const RegistroGlucosa * pRegistro) {
+// Índice del último bloque que empieza en el instante o antes, por búsqueda binaria. Si no hay ninguno, 0
+
+	uint32_t inferior = 0, superior = pRegistro->numBloques;
+	while (superior - inferior > 1) {
+		uint32_t medio = (inferior + superior) / 2;
+		if (bloque(medio, pRegistro)->instante <= instante)
+			inferior = medio;
+		else superior = medio;
+	}
+	return inferior;
+}
+
+
+int rellenaRegistroGlucosa(uint32_t instante, int valor, RegistroGlucosa * pRegistro) {
+	if (pRegistro->numBloques == 0)
+		return 0;
+	uint32_t indice = buscaBloque(instante, pRegistro);
+	BloqueRegistro * b = bloque(indice, pRegistro);
+	uint32_t posicion = (instante - b->instante) / pRegistro->periodo;
+	if (instante < b->instante || posicion >= b->numMuestras || instante != b->instante + posicion *
+			pRegistro->periodo || !compruebaBloqueRegistroGlucosa(indice, pRegistro))
+		return 0;  // No está guardado, o el bloque está estropeado y no se le puede dar un CRC nuevo
+
+	// Se decodifica y se vuelve a codificar en una pasada: con el hueco relleno cambian las diferencias con
+	// la medición anterior y la siguiente
+	uint8_t datos[REGISTRO_BYTES_DATOS + 5];  // Con sitio para la diferencia que ya no cabe
+	uint32_t leido = 0, n = 0;
+	int original = b->primerValor, anterior = 0;  // Medición guardada y medición nueva de la anterior
+	for (uint32_t i = 0; i < b->numMuestras; i++) {
+		if (i > 0)
+			original += decodifica(b, &leido);
+		int nueva = original;
+		if (i == posicion) {
+			if (original != 0)
+				return 0;  // Sólo se rellenan los huecos
+			nueva = valor;
+		}
+		if (i > 0) {
+			n += codifica(nueva - anterior, &datos[n]);
+			if (n > REGISTRO_BYTES_DATOS)
+				return 0;  // Ya no cabe en el bloque
+		}
+		anterior = nueva;
+	}
+	if (posicion == 0)
+		b->primerValor = valor;
+	for (uint32_t i = 0; i < n; i++)
+		b->datos[i] = datos[i];
+	b->numBytes = n;
+	if (indice + 1 < pRegistro->numBloques)
+		b->crc = calculaCRC(b);
+	else if (posicion + 1 == b->numMuestras)
+		pRegistro->ultimo = valor;  // Referencia de la diferencia de la siguiente medición
+	return 1;
+}
+
+
+int buscaRegistroGlucosa(uint32_t instante, const RegistroGlucosa * pRegistro, IteradorRegistro * pIterador) {
+	pIterador->registro = pRegistro;
+	pIterador->bloque = buscaBloque(instante, pRegistro);
+	pIterador->muestra = 0;
+	pIterador->posicion = 0;
+	pIterador->valor = 0;
+	pIterador->bloquesErroneos = 0;
+
+	// Se saltan las mediciones anteriores al instante dentro del bloque
+	IteradorRegistro anterior;
+	MuestraRegistro muestra;
+	do {
+		anterior = *pIterador;
+		if (!siguienteRegistroGlucosa(pIterador, &muestra))
+			return 0;
+	} while (muestra.instante < instante);
+	*pIterador = anterior;
+	return 1;
+}
+
+
+int siguienteRegistroGlucosa(IteradorRegistro * pIterador, MuestraRegistro * muestra) {
+	const RegistroGlucosa * r = pIterador->registro;
+	while (pIterador->bloque < r->numBloques) {
+		const BloqueRegistro * b = bloque(pIterador->bloque, r);
+		if (pIterador->muestra == 0) {
+			if (!compruebaBloqueRegistroGlucosa(pIterador->bloque, r)) {
+				pIterador->bloquesErroneos++;
+				pIterador->bloque++;
+				continue;
+			}
+			pIterador->valor = b->primerValor;
+		} else if (pIterador->muestra < b->numMuestras)
+			pIterador->valor += decodifica(b, &pIterador->posicion);
+		else {
+			pIterador->bloque++;
+			pIterador->muestra = 0;
+			pIterador->posicion = 0;
+			continue;
+		}
+		muestra->instante = b->instante + pIterador->muestra * r->periodo;
+		muestra->valor = pIterador->valor;
+		pIterador->muestra++;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,225 @@
+#ifndef REGISTROGLUCOSA_H_
+#define REGISTROGLUCOSA_H_
+
+#include <stdint.h>
+
+/**
+  * @file registroGlucosa.h
+  * @author EII
+  *
+  * @brief Registro comprimido de mediciones de glucosa, en bloques de tamaño fijo con CRC.
+  *
+  * Las mediciones consecutivas se diferencian en pocos mg/dL, así que en lugar de guardar cada una en un
+  * int se guarda la diferencia con la anterior codificada en zig-zag (0, -1, 1, -2, 2... pasan a ser 0, 1,
+  * 2, 3, 4...) y en varint (7 bits por byte, con el bit alto a 1 si siguen más bytes). Una diferencia de
+  * -64 a 63 mg/dL ocupa un byte, y cualquier otra como mucho tres.
+  *
+  * Las mediciones se reparten en bloques de REGISTRO_BLOQUE_BYTES bytes. Cada bloque lleva en la cabecera
+  * el instante y el valor de su primera medición y el número de mediciones, y se cierra con un CRC-32 de
+  * todo lo anterior, calculado con la unidad CRC del microcontrolador (hcrc, inicializado en main.c). En
+  * el simulador (LCD_SIMULADOR) se calcula por software con el mismo polinomio (0x04C11DB7), valor inicial
+  * 0xFFFFFFFF y palabras de 32 bits, así que los bloques son idénticos. Las mediciones de un bloque están
+  * separadas exactamente un periodo; si una llega en otro instante, por un hueco o porque el reloj salta,
+  * empieza un bloque nuevo. Los huecos que se añaden con valor 0 ocupan su sitio en el bloque, y
+  * rellenaRegistroGlucosa() les pone después la medición que llegue tarde. Con diferencias de un byte caben 53 mediciones por bloque: a 5 minutos por
+  * medición, los REGISTRO_BLOQUES bloques de la SDRAM guardan más de seis meses.
+  *
+  * Los bloques forman un buffer circular en la SDRAM (ver memoriaSDRAM.h) en orden cronológico, así que
+  * buscaRegistroGlucosa() encuentra por búsqueda binaria el bloque de un instante y sólo decodifica ese
+  * bloque desde el principio. El bloque que se está llenando no tiene CRC hasta que se cierra. Al leer se
+  * saltan los bloques cerrados cuyo CRC no coincide.
+  *
+  * El instante se mide en la unidad que elija la aplicación, creciente y sin desbordar: con un periodo de
+  * 5 minutos, por ejemplo, segundos o número de periodo. No tiene protección para varias tareas.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static RegistroGlucosa registro;
+  * inicializaRegistroGlucosa(1, &registro);  // Instantes en número de periodo
+  * anadeRegistroGlucosa(n, 95, &registro);
+  * ...
+  * IteradorRegistro it;
+  * MuestraRegistro m;
+  * buscaRegistroGlucosa(n - 288, &registro, &it);  // Último día
+  * while (siguienteRegistroGlucosa(&it, &m))
+  *     ...  // m.instante, m.valor
+  * @endcode
+  */
+
+
+/** @brief Tamaño en bytes de cada bloque. Múltiplo de 4 para calcular el CRC por palabras */
+#ifndef REGISTRO_BLOQUE_BYTES
+#define REGISTRO_BLOQUE_BYTES 64
+#endif
+
+/** @brief Número de bloques del buffer circular */
+#ifndef REGISTRO_BLOQUES
+#define REGISTRO_BLOQUES 1024
+#endif
+
+/** @brief Bytes de cada bloque para las diferencias, descontando la cabecera y el CRC */
+#define REGISTRO_BYTES_DATOS (REGISTRO_BLOQUE_BYTES - 12)
+
+
+/**
+ * @brief Bloque del registro
+ */
+typedef struct {
+    /** @brief Instante de la primera medición */
+    uint32_t instante;
+    /** @brief Primera medición en mg/dL */
+    int16_t primerValor;
+    /** @brief Número de mediciones, incluida la primera */
+    uint8_t numMuestras;
+    /** @brief Bytes ocupados de 'datos' */
+    uint8_t numBytes;
+    /** @brief Diferencias de las mediciones siguientes a la primera, en zig-zag y varint */
+    uint8_t datos[REGISTRO_BYTES_DATOS];
+    /** @brief CRC-32 de los campos anteriores. Sólo es válido cuando el bloque se ha cerrado */
+    uint32_t crc;
+} BloqueRegistro;
+
+
+/**
+ * @brief Registro comprimido
+ *
+ * @see inicializaRegistroGlucosa(), anadeRegistroGlucosa(), buscaRegistroGlucosa()
+ */
+typedef struct {
+    /** @brief Bloques, en un buffer circular en la SDRAM */
+    BloqueRegistro * bloques;
+    /** @brief Tiempo entre dos mediciones consecutivas de un bloque */
+    uint32_t periodo;
+    /** @brief Posición del bloque que se está llenando */
+    uint32_t cabeza;
+    /** @brief Número de bloques guardados, incluido el que se está llenando */
+    uint32_t numBloques;
+    /** @brief Última medición añadida, de la que se calcula la diferencia de la siguiente */
+    int ultimo;
+} RegistroGlucosa;
+
+
+/**
+ * @brief Medición leída del registro
+ */
+typedef struct {
+    /** @brief Instante de la medición */
+    uint32_t instante;
+    /** @brief Medición en mg/dL, 0 si era un hueco sin dato */
+    int valor;
+} MuestraRegistro;
+
+
+/**
+ * @brief Recorrido del registro desde un instante
+ *
+ * @see buscaRegistroGlucosa(), siguienteRegistroGlucosa()
+ */
+typedef struct {
+    /** @brief Registro recorrido */
+    const RegistroGlucosa * registro;
+    /** @brief Índice cronológico del bloque actual */
+    uint32_t bloque;
+    /** @brief Índice en el bloque de la siguiente medición */
+    uint32_t muestra;
+    /** @brief Posición en los datos del bloque de la diferencia de la siguiente medición */
+    uint32_t posicion;
+    /** @brief Última medición decodificada */
+    int valor;
+    /** @brief Número de bloques saltados porque su CRC no coincidía */
+    uint32_t bloquesErroneos;
+} IteradorRegistro;
+
+
+/**
+ * @brief Vacía el registro, reservando sus bloques en la SDRAM si aún no los tiene
+ *
+ * @param periodo Tiempo entre dos mediciones consecutivas, en la unidad de los instantes
+ * @param pRegistro Puntero a la estructura que representa al registro, a cero la primera vez
+ * @return Buleano cierto si tiene los bloques reservados. Si no queda SDRAM, el registro no se puede usar
+ */
+int inicializaRegistroGlucosa(uint32_t periodo, RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Añade una medición al registro
+ *
+ * Si no cabe en el bloque actual o no llega un periodo después de la anterior, cierra el bloque con su
+ * CRC y empieza otro. Si el buffer está lleno se sobrescribe el bloque más antiguo.
+ *
+ * @param instante Instante de la medición, no anterior al de la medición anterior
+ * @param valor Medición en mg/dL, o 0 si no hay dato
+ * @param pRegistro Puntero a la estructura que representa al registro
+ */
+void anadeRegistroGlucosa(uint32_t instante, int valor, RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Rellena un hueco ya guardado con la medición que ha llegado tarde
+ *
+ * Busca el bloque por búsqueda binaria, vuelve a codificar sus diferencias con la medición nueva y, si el
+ * bloque está cerrado, recalcula su CRC. No rellena bloques cuyo CRC no coincide, para no dar por buenos
+ * sus datos.
+ *
+ * @param instante Instante del hueco
+ * @param valor Medición en mg/dL
+ * @param pRegistro Puntero al registro
+ * @return Buleano cierto si se ha rellenado. Es falso si el instante no está guardado o no era un hueco,
+ *     si el bloque está estropeado o si las diferencias nuevas no caben en el bloque
+ */
+int rellenaRegistroGlucosa(uint32_t instante, int valor, RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Número de bloques guardados, incluido el que se está llenando
+ */
+uint32_t numBloquesRegistroGlucosa(const RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Bloque del registro en orden cronológico
+ *
+ * @param indice Índice del bloque, de 0 (el más antiguo) a numBloquesRegistroGlucosa() - 1 (el que se está
+ *     llenando)
+ * @param pRegistro Puntero al registro
+ * @return Puntero al bloque, en la SDRAM
+ */
+const BloqueRegistro * bloqueRegistroGlucosa(uint32_t indice, const RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Comprueba el CRC de un bloque
+ *
+ * @param indice Índice cronológico del bloque
+ * @param pRegistro Puntero al registro
+ * @return Buleano cierto si el CRC coincide o si es el bloque que se está llenando
+ */
+int compruebaBloqueRegistroGlucosa(uint32_t indice, const RegistroGlucosa * pRegistro);
+
+
+/**
+ * @brief Prepara un recorrido desde la primera medición guardada en un instante igual o posterior
+ *
+ * Busca el bloque por búsqueda binaria y decodifica sólo ese bloque.
+ *
+ * @param instante Instante desde el que se recorre
+ * @param pRegistro Puntero al registro
+ * @param pIterador Puntero al recorrido
+ * @return Buleano cierto si hay alguna medición desde ese instante
+ */
+int buscaRegistroGlucosa(uint32_t instante, const RegistroGlucosa * pRegistro, IteradorRegistro * pIterador);
+
+
+/**
+ * @brief Obtiene la siguiente medición de un recorrido
+ *
+ * El registro no se puede modificar mientras se recorre.
+ *
+ * @param pIterador Puntero al recorrido
+ * @param muestra Puntero donde se copia la medición
+ * @return Buleano cierto si había otra medición
+ */
+int siguienteRegistroGlucosa(IteradorRegistro * pIterador, MuestraRegistro * muestra);
+
+
+#endif /* REGISTROGLUCOSA_H_ */
@@ -0,0 +1,320 @@
+#include "rendimiento.h"
+#include <math.h>
+#include "pantallaLCD.h"
+#include "interfazLCD.h"
+#include "frameLCD.h"
+#include "fondoLCD.h"
+#include "dma2dLCD.h"
+#include "textoLCD.h"
+#include "formatoLCD.h"
+#include "tactilLCD.h"
+#include "indiceTactilLCD.h"
+#include "escenaLCD.h"
+#include "memoriaSDRAM.h"
+#include "historialGlucosa.h"
+#include "tareas.h"
+#include "JuegoAlpha15.h"
+
+#ifdef LCD_SIMULADOR
+#include <time.h>
+#include "simulador.h"
+
+#define UNIDAD "ns"
+#else
+#include "main.h"
+
+#define UNIDAD "ciclos"
+#endif
+
+
+#define BOTONES_COLUMNAS 4  // Botones de la pantalla llena de botones
+#define BOTONES_FILAS 4
+#define BOTON_ANCHO 76
+#define BOTON_ALTO 56
+
+
+typedef struct {
+	uint32_t iteraciones;
+	uint64_t total;  // Suma de los tiempos de todos los frames
+	uint32_t minimo, maximo;
+	uint64_t redibujados, dma2d, cpu;  // Suma de los puntos de todos los frames
+	uint32_t inicio, dma2dInicio, cpuInicio;  // Valores de los contadores al empezar el frame actual
+} Medida;
+
+static PantallaGlucosa pantalla;
+static HistorialGlucosa historial;
+static ResumenHistorial resumen;
+static LCD_Boton botones[BOTONES_FILAS * BOTONES_COLUMNAS];
+static uint8_t * imagenBoton = 0;  // Imagen ARGB de los botones, en la SDRAM
+static LCD_Barra barra;
+static LCD_Editor editor;
+static LCD_Escena escena;  // Componentes del escenario actual
+
+
+// ---------------------------------------------------------------------------------------------------
+// Contadores
+
+#ifdef LCD_SIMULADOR
+
+static void inicializaContador(void) {
+}
+
+
+static uint32_t contador(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint32_t) t.tv_sec * 1000000000u + t.tv_nsec;  // Las diferencias son correctas aunque desborde
+}
+
+
+static uint32_t puntosCPU(void) {
+	return simuladorPuntosEscritos();
+}
+
+#else
+
+static void inicializaContador(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // Habilita el DWT
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+static uint32_t contador(void) {
+	return DWT->CYCCNT;
+}
+
+
+static uint32_t puntosCPU(void) {
+	return 0;  // pantallaLCD no los cuenta
+}
+
+#endif
+
+
+// ---------------------------------------------------------------------------------------------------
+// Medidas
+
+static void iniciaFrame(Medida * pMedida) {
+	pMedida->dma2dInicio = LCD_puntosDMA2D();
+	pMedida->cpuInicio = puntosCPU();
+	pMedida->inicio = contador();
+}
+
+
+static void terminaFrame(Medida * pMedida) {
+// Anota el frame y lo muestra. El intercambio de buffers queda fuera de la medida
+
+	LCD_esperaDMA2D();
+	uint32_t tiempo = contador() - pMedida->inicio;
+	if (pMedida->iteraciones == 0 || tiempo < pMedida->minimo)
+		pMedida->minimo = tiempo;
+	if (tiempo > pMedida->maximo)
+		pMedida->maximo = tiempo;
+	pMedida->total += tiempo;
+	pMedida->redibujados += LCD_areaRegionesInvalidas();
+	pMedida->dma2d += LCD_puntosDMA2D() - pMedida->dma2dInicio;
+	pMedida->cpu += puntosCPU() - pMedida->cpuInicio;
+	pMedida->iteraciones++;
+	LCD_intercambiaBuffersRegiones();
+}
+
+
+static void mide(const char * nombre, uint32_t iteraciones, void (*dibujaFrame)(uint32_t),
+	void (*escribe)(const char *)) {
+// Dibuja dos frames sin medir, para que los dos buffers estén al día, y después mide 'iteraciones' frames
+
+	Medida medida = {0};
+	char linea[120];
+	for (uint32_t i = 0; i < 2; i++) {
+		dibujaFrame(i);
+		LCD_intercambiaBuffersRegiones();
+	}
+	for (uint32_t i = 2; i < iteraciones + 2; i++) {
+		iniciaFrame(&medida);
+		dibujaFrame(i);
+		terminaFrame(&medida);
+	}
+	if (medida.iteraciones == 0)
+		return;
+
+	uint32_t n = medida.iteraciones;
+	uint32_t campos[] = {medida.total / n, medida.minimo, medida.maximo, medida.redibujados / n,
+		medida.dma2d / n};
+	char * p = LCD_formateaTexto(nombre, linea);
+	p = LCD_formateaNatural(n, LCD_formateaTexto(",", p));
+	p = LCD_formateaTexto(UNIDAD, LCD_formateaTexto(",", p));
+	for (uint32_t i = 0; i < sizeof(campos) / sizeof(campos[0]); i++)
+		p = LCD_formateaNatural(campos[i], LCD_formateaTexto(",", p));
+	p = LCD_formateaTexto(",", p);
+#ifdef LCD_SIMULADOR
+	p = LCD_formateaNatural((uint32_t) (medida.cpu / n), p);
+#endif
+	LCD_formateaTexto("\n", p);
+	escribe(linea);
+}
+
+
+static int valorSimulado(uint32_t i) {
+// La misma curva que el sensor simulado de tareas.c
+
+	return 80 + (int)(40 * sin(0.02 * i));
+}
+
+
+static void dibujaNada(void) {
+}
+
+
+static void preparaPantalla(uint32_t colorFondo, void (*dibujaFondo)(void)) {
+	LCD_inicializa2Buffers(1);
+	LCD_inicializaRegiones(320, 240);
+	LCD_inicializaCacheTexto(LCD_CACHE_TEXTO_BYTES);
+	LCD_inicializaIndiceTactil();  // Sin los componentes del escenario anterior
+	LCD_inicializaEscena(&escena);
+	LCD_inicializaFondo(colorFondo, dibujaFondo);
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Escenarios
+
+static void frameGlucosa(uint32_t i) {
+	EstadoControl estado = {.instante = i, .valor = valorSimulado(i), .alarma = 0, .calidad = CALIDAD_VALIDA,
+		.fuente = FUENTE_SENSOR, .numero = i};
+	actualizaPantallaGlucosa(&estado, &pantalla);
+	dibujaPantallaGlucosa(&pantalla);
+}
+
+
+static void frameGlucosaAlarma(uint32_t i) {
+	EstadoControl estado = {.instante = i, .valor = UMBRAL_HIPOGLUCEMIA - 10 + i % 5, .alarma = 1,
+		.calidad = CALIDAD_VALIDA, .fuente = FUENTE_SENSOR, .numero = i};
+	actualizaPantallaGlucosa(&estado, &pantalla);
+	dibujaPantallaGlucosa(&pantalla);
+}
+
+
+static void frameBotonesCompleta(uint32_t i) {
+	(void) i;  // Todos los frames redibujan lo mismo
+	LCD_invalidaPantalla();
+	LCD_atiendeEscena(&escena);
+}
+
+
+static void frameBotonesUno(uint32_t i) {
+	LCD_setHabilitacionBoton(i & 1, &botones[BOTONES_COLUMNAS + 1]);
+	LCD_atiendeEscena(&escena);
+}
+
+
+static void frameBarra(uint32_t i) {
+	LCD_setValorFijoBarra((i * 37) % 400 * 10 + 5, &barra);
+	LCD_atiendeEscena(&escena);
+}
+
+
+static void frameEditor(uint32_t i) {
+	LCD_setValorFijoEditor(1000 + i, &editor);
+	LCD_atiendeEscena(&escena);
+}
+
+
+static void frameGrafica(uint32_t i) {
+	anadeHistorial(valorSimulado(i), &historial);
+	LCD_invalidaRegion(25, 30, 295, 210);  // Se redibuja entera, sin desplazar lo ya dibujado
+	LCD_restauraFondoRegiones();
+	dibujaGrafica(&historial);
+}
+
+
+static void frameResumen(uint32_t i) {
+	anadeResumenHistorial(valorSimulado(i), &resumen);
+	LCD_invalidaRegion(25, 30, 295, 210);
+	LCD_restauraFondoRegiones();
+	dibujaGraficaResumen(&resumen);
+}
+
+
+static void preparaGlucosa(void) {
+	inicializaPantallaGlucosa(&pantalla);
+	for (uint32_t i = 0; i < HISTORIAL_CAPACIDAD; i++) {  // Gráfica llena, como tras un rato en marcha
+		EstadoControl estado = {.instante = i, .valor = valorSimulado(i), .alarma = 0,
+			.calidad = CALIDAD_VALIDA, .fuente = FUENTE_SENSOR, .numero = i};
+		actualizaPantallaGlucosa(&estado, &pantalla);
+	}
+}
+
+
+static void preparaBotones(void) {
+	static char textos[BOTONES_FILAS * BOTONES_COLUMNAS][8];
+	if (imagenBoton == 0)
+		imagenBoton = reservaSDRAM(BOTON_ANCHO * BOTON_ALTO * 4);
+	if (imagenBoton == 0)
+		return;
+	uint32_t * colores = (uint32_t *) imagenBoton;
+	for (uint16_t y = 0; y < BOTON_ALTO; y++)  // Degradado con el borde semitransparente
+		for (uint16_t x = 0; x < BOTON_ANCHO; x++) {
+			int borde = x < 2 || y < 2 || x >= BOTON_ANCHO - 2 || y >= BOTON_ALTO - 2;
+			*colores++ = (borde ? 0x80000000u : 0xFF000000u) | (x * 3) << 16 | (y * 4) << 8 | 0xC0;
+		}
+
+	preparaPantalla(0xFF202020, dibujaNada);
+	for (int i = 0; i < BOTONES_FILAS * BOTONES_COLUMNAS; i++) {
+		LCD_formateaEntero(i, LCD_formateaTexto("B", textos[i]));
+		LCD_inicializaBoton((i % BOTONES_COLUMNAS) * 80 + 2, (i / BOTONES_COLUMNAS) * 60 + 2, BOTON_ANCHO,
+			BOTON_ALTO, imagenBoton, textos[i], &juegoAlpha15, 1, 0xFFFFFFFF, 0, 1, 1, &botones[i]);
+		LCD_anadeElementoEscena(LCD_ELEMENTO_BOTON, &botones[i], LCD_ESCENA_SIN_GRUPO, 0, &escena);
+	}
+}
+
+
+void ejecutaRendimiento(uint32_t iteraciones, void (*escribe)(const char * linea)) {
+	static const uint32_t puntosGrafica[] = {300, 1000, 10000};
+	static const uint32_t puntosVentana[] = {288, 864, 4032};  // 24 horas, 3 días y 14 días cada 5 minutos
+	inicializaContador();
+	escribe("escenario,iteraciones,unidad,medio,minimo,maximo,puntos_redibujados,puntos_dma2d,puntos_cpu\n");
+
+	preparaGlucosa();
+	mide("pantalla_glucosa", iteraciones, frameGlucosa, escribe);
+	preparaGlucosa();
+	mide("pantalla_glucosa_alarma", iteraciones, frameGlucosaAlarma, escribe);
+
+	preparaBotones();
+	if (imagenBoton != 0) {
+		mide("botones_completa", iteraciones, frameBotonesCompleta, escribe);
+		mide("botones_uno", iteraciones, frameBotonesUno, escribe);
+	}
+
+	preparaPantalla(0xFF202020, dibujaNada);
+	LCD_inicializaBarraFija("Nivel ", 0, 4000, 200, 20, 60, 100, 6, 1, 0xFFFFFFFF, 0xFF00C000, 0xFF404040,
+		&juegoAlpha15, 1, &barra);
+	LCD_anadeElementoEscena(LCD_ELEMENTO_BARRA, &barra, LCD_ESCENA_SIN_GRUPO, 0, &escena);
+	mide("barra", iteraciones, frameBarra, escribe);
+
+	preparaPantalla(0xFF202020, dibujaNada);
+	LCD_inicializaEditorFijo(1000, 1, 10, 100, 100, 120, 30, 5, 6, LCD_ALINEACION_CENTRO, 0xFF000000, 0xFFFFFFFF,
+		&juegoAlpha15, 1, 1, &editor);
+	LCD_anadeElementoEscena(LCD_ELEMENTO_EDITOR, &editor, LCD_ESCENA_SIN_GRUPO, 0, &escena);
+	mide("editor", iteraciones, frameEditor, escribe);
+
+	for (int g = 0; g < 3; g++) {
+		char nombre[20];
+		preparaPantalla(0x00000000, inicializaGrafica);
+		inicializaHistorial(&historial);
+		for (uint32_t i = 0; i < puntosGrafica[g]; i++)
+			anadeHistorial(valorSimulado(i), &historial);
+		LCD_formateaNatural(puntosGrafica[g], LCD_formateaTexto("grafica_", nombre));
+		mide(nombre, iteraciones, frameGrafica, escribe);
+	}
+
+	for (int v = 0; v < 3; v++) {
+		char nombre[20];
+		preparaPantalla(0x00000000, inicializaGrafica);
+		inicializaResumenHistorial(RESUMEN_MUESTRAS_POR_COLUMNA(puntosVentana[v]), &resumen);
+		for (uint32_t i = 0; i < puntosVentana[v]; i++)
+			anadeResumenHistorial(valorSimulado(i), &resumen);
+		LCD_formateaNatural(puntosVentana[v], LCD_formateaTexto("resumen_", nombre));
+		mide(nombre, iteraciones, frameResumen, escribe);
+	}
+}
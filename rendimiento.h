@@ -0,0 +1,74 @@
+#ifndef RENDIMIENTO_H_
+#define RENDIMIENTO_H_
+
+#include <stdint.h>
+
+/**
+  * @file rendimiento.h
+  * @author EII
+  *
+  * @brief Medidas del tiempo de dibujo de frames representativos de la interfaz.
+  *
+  * Dibuja una serie de escenarios y, para cada uno, mide el tiempo de cada frame desde que se empieza a
+  * dibujar hasta que termina la última transferencia del DMA2D, sin contar el intercambio de buffers, que
+  * espera al refresco de la pantalla. También cuenta los puntos de cada frame:
+  *
+  * - Redibujados: área de las regiones inválidas (ver LCD_areaRegionesInvalidas() en frameLCD.h).
+  * - DMA2D: escritos por las operaciones de bloque (ver LCD_puntosDMA2D() en dma2dLCD.h).
+  * - CPU: escritos punto a punto por pantallaLCD. Sólo se conocen en el simulador.
+  *
+  * En la placa el tiempo se mide en ciclos con el contador DWT->CYCCNT; en el simulador (LCD_SIMULADOR)
+  * en nanosegundos. Conviene medir sin las demás tareas, que se adelantarían a la de la pantalla: en
+  * main.c, compilando con -DRENDIMIENTO se ejecutan las medidas en lugar de la aplicación y se envían por
+  * USART1. En el simulador, con la opción -b.
+  *
+  * La salida es CSV, una línea por escenario después de una cabecera:
+  * @code
+  * escenario,iteraciones,unidad,medio,minimo,maximo,puntos_redibujados,puntos_dma2d,puntos_cpu
+  * pantalla_glucosa,50,ns,34146,24749,122796,9600,71760,1138
+  * @endcode
+  * Los puntos son medias por frame. En la placa la columna puntos_cpu queda vacía. Los del DMA2D pueden
+  * superar a los redibujados: el desplazamiento de la gráfica copia puntos fuera de las regiones inválidas.
+  *
+  * Escenarios:
+  * - pantalla_glucosa: la pantalla de la aplicación, con una medición nueva por frame.
+  * - pantalla_glucosa_alarma: la misma con el aviso de nivel bajo, que obliga a redibujar la gráfica.
+  * - botones_completa: una pantalla llena de LCD_Boton que se redibuja entera.
+  * - botones_uno: la misma pantalla cuando sólo cambia un botón.
+  * - barra: una LCD_Barra cuyo valor cambia en cada frame.
+  * - editor: un LCD_Editor cuyo valor cambia en cada frame.
+  * - grafica_300, grafica_1000, grafica_10000: dibujaGrafica() completa tras añadir ese número de
+  *   mediciones al historial. La gráfica representa como mucho HISTORIAL_CAPACIDAD mediciones.
+  * - resumen_288, resumen_864, resumen_4032: dibujaGraficaResumen() completa de una ventana de 24 horas,
+  *   3 días y 14 días con una medición cada 5 minutos. Deberían costar lo mismo.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * static void escribe(const char * linea) {
+  *     HAL_UART_Transmit(&huart1, (uint8_t *) linea, strlen(linea), HAL_MAX_DELAY);
+  * }
+  * ...
+  * ejecutaRendimiento(RENDIMIENTO_ITERACIONES, escribe);
+  * @endcode
+  */
+
+
+/** @brief Número de frames medidos en cada escenario */
+#ifndef RENDIMIENTO_ITERACIONES
+#define RENDIMIENTO_ITERACIONES 50
+#endif
+
+
+/**
+ * @brief Ejecuta todos los escenarios y escribe los resultados
+ *
+ * Inicializa la pantalla en horizontal con la gestión de regiones, así que hay que llamarla en lugar de
+ * tareaPantalla(). Al terminar la pantalla queda con el último escenario.
+ *
+ * @param iteraciones Número de frames medidos en cada escenario
+ * @param escribe Función que recibe cada línea de la salida, terminada en salto de línea
+ */
+void ejecutaRendimiento(uint32_t iteraciones, void (*escribe)(const char * linea));
+
+
+#endif /* RENDIMIENTO_H_ */
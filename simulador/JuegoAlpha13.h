@@ -0,0 +1,9 @@
+#ifndef JUEGOALPHA13_H_
+#define JUEGOALPHA13_H_
+
+#include "pantallaLCD.h"
+
+/** @brief Juego de caracteres simulado de 13 puntos de alto */
+extern const LCD_JuegoCaracteresAlpha juegoAlpha13;
+
+#endif /* JUEGOALPHA13_H_ */
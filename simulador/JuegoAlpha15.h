@@ -0,0 +1,9 @@
+#ifndef JUEGOALPHA15_H_
+#define JUEGOALPHA15_H_
+
+#include "pantallaLCD.h"
+
+/** @brief Juego de caracteres simulado de 15 puntos de alto */
+extern const LCD_JuegoCaracteresAlpha juegoAlpha15;
+
+#endif /* JUEGOALPHA15_H_ */
@@ -0,0 +1,9 @@
+#ifndef JUEGOALPHA17_H_
+#define JUEGOALPHA17_H_
+
+#include "pantallaLCD.h"
+
+/** @brief Juego de caracteres simulado de 17 puntos de alto */
+extern const LCD_JuegoCaracteresAlpha juegoAlpha17;
+
+#endif /* JUEGOALPHA17_H_ */
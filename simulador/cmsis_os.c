@@ -0,0 +1,302 @@
+#include "cmsis_os.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+
+static uint64_t inicio;  // Instante real de osKernelInitialize() en us
+static uint32_t escala = 1;  // Ticks por ms real
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cambio;  // Se señala cada vez que se pone o se quita algo
+	uint8_t * mensajes;
+	uint32_t tamano, capacidad, numMensajes, primero;
+} Cola;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cambio;
+	uint32_t cuenta, maximo;
+} Semaforo;
+
+typedef struct {
+	osThreadFunc_t funcion;
+	void * argumento;
+} Arranque;
+
+#define MAX_HILOS 32
+
+static struct {
+	pthread_t hilo;
+	const char * nombre;
+} hilos[MAX_HILOS];  // Nombres de los hilos creados, para osThreadGetName()
+static int numHilos = 0;
+static pthread_mutex_t mutexHilos = PTHREAD_MUTEX_INITIALIZER;
+
+
+static uint64_t ahora(void) {
+// Instante real en us
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t) t.tv_sec * 1000000u + t.tv_nsec / 1000;
+}
+
+
+static void limite(uint32_t ticks, struct timespec * t) {
+// Instante absoluto, para pthread_cond_timedwait(), tras 'ticks' ticks
+
+	uint64_t us = ticks * 1000ull / escala;
+	clock_gettime(CLOCK_REALTIME, t);
+	t->tv_sec += us / 1000000u;
+	t->tv_nsec += (us % 1000000u) * 1000;
+	if (t->tv_nsec >= 1000000000) {
+		t->tv_sec++;
+		t->tv_nsec -= 1000000000;
+	}
+}
+
+
+static int espera(pthread_cond_t * cambio, pthread_mutex_t * mutex, uint32_t timeout, const struct timespec * t) {
+// Espera un cambio con el mutex tomado. Devuelve falso si vence el plazo
+
+	if (timeout == 0)
+		return 0;
+	if (timeout == osWaitForever)
+		return pthread_cond_wait(cambio, mutex) == 0;
+	return pthread_cond_timedwait(cambio, mutex, t) == 0;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Núcleo y tiempo
+
+osStatus_t osKernelInitialize(void) {
+	inicio = ahora();
+	return osOK;
+}
+
+
+osStatus_t osKernelStart(void) {
+	for(;;)  // Los hilos ya están en marcha. El programa termina con exit()
+		pause();
+	return osOK;
+}
+
+
+uint32_t osKernelGetTickCount(void) {
+	return (uint32_t) ((ahora() - inicio) * escala / 1000u);
+}
+
+
+uint32_t osKernelGetTickFreq(void) {
+	return 1000;
+}
+
+
+void osSimuladorSetEscala(uint32_t nuevaEscala) {
+	uint32_t ticks = osKernelGetTickCount();
+	escala = nuevaEscala == 0 ? 1 : nuevaEscala;
+	inicio = ahora() - ticks * 1000ull / escala;  // Los ticks no saltan al cambiar de escala
+}
+
+
+osStatus_t osDelay(uint32_t ticks) {
+	usleep(ticks * 1000ull / escala);
+	return osOK;
+}
+
+
+osStatus_t osDelayUntil(uint32_t ticks) {
+	int32_t restantes = (int32_t) (ticks - osKernelGetTickCount());
+	if (restantes > 0)
+		osDelay(restantes);
+	return osOK;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Hilos
+
+static void * arranca(void * p) {
+	Arranque a = *(Arranque *) p;
+	free(p);
+	a.funcion(a.argumento);
+	return NULL;
+}
+
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void * argument, const osThreadAttr_t * attr) {
+	Arranque * a = malloc(sizeof(Arranque));
+	pthread_t hilo;
+	if (a == NULL)
+		return NULL;
+	a->funcion = func;
+	a->argumento = argument;
+	if (pthread_create(&hilo, NULL, arranca, a) != 0) {
+		free(a);
+		return NULL;
+	}
+	pthread_detach(hilo);
+	pthread_mutex_lock(&mutexHilos);
+	if (numHilos < MAX_HILOS && attr != NULL) {
+		hilos[numHilos].hilo = hilo;
+		hilos[numHilos++].nombre = attr->name;
+	}
+	pthread_mutex_unlock(&mutexHilos);
+	return (osThreadId_t) hilo;
+}
+
+
+const char * osThreadGetName(osThreadId_t thread_id) {
+	const char * nombre = NULL;
+	pthread_mutex_lock(&mutexHilos);
+	for (int i = 0; i < numHilos && nombre == NULL; i++)
+		if (pthread_equal(hilos[i].hilo, (pthread_t) thread_id))
+			nombre = hilos[i].nombre;
+	pthread_mutex_unlock(&mutexHilos);
+	return nombre;
+}
+
+
+osThreadId_t osThreadGetId(void) {
+	return (osThreadId_t) pthread_self();
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Colas de mensajes
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t * attr) {
+	Cola * c = calloc(1, sizeof(Cola));
+	if (c == NULL || (c->mensajes = malloc(msg_count * msg_size)) == NULL) {
+		free(c);
+		return NULL;
+	}
+	pthread_mutex_init(&c->mutex, NULL);
+	pthread_cond_init(&c->cambio, NULL);
+	c->tamano = msg_size;
+	c->capacidad = msg_count;
+	return c;
+}
+
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void * msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+	Cola * c = mq_id;
+	struct timespec t;
+	limite(timeout, &t);
+	pthread_mutex_lock(&c->mutex);
+	while (c->numMensajes == c->capacidad)
+		if (!espera(&c->cambio, &c->mutex, timeout, &t)) {
+			pthread_mutex_unlock(&c->mutex);
+			return timeout == 0 ? osErrorResource : osErrorTimeout;
+		}
+	uint32_t posicion = (c->primero + c->numMensajes++) % c->capacidad;
+	memcpy(c->mensajes + posicion * c->tamano, msg_ptr, c->tamano);
+	pthread_cond_broadcast(&c->cambio);
+	pthread_mutex_unlock(&c->mutex);
+	return osOK;
+}
+
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void * msg_ptr, uint8_t * msg_prio, uint32_t timeout) {
+	Cola * c = mq_id;
+	struct timespec t;
+	limite(timeout, &t);
+	pthread_mutex_lock(&c->mutex);
+	while (c->numMensajes == 0)
+		if (!espera(&c->cambio, &c->mutex, timeout, &t)) {
+			pthread_mutex_unlock(&c->mutex);
+			return timeout == 0 ? osErrorResource : osErrorTimeout;
+		}
+	memcpy(msg_ptr, c->mensajes + c->primero * c->tamano, c->tamano);
+	c->primero = (c->primero + 1) % c->capacidad;
+	c->numMensajes--;
+	if (msg_prio != NULL)
+		*msg_prio = 0;
+	pthread_cond_broadcast(&c->cambio);
+	pthread_mutex_unlock(&c->mutex);
+	return osOK;
+}
+
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id) {
+	Cola * c = mq_id;
+	pthread_mutex_lock(&c->mutex);
+	uint32_t n = c->numMensajes;
+	pthread_mutex_unlock(&c->mutex);
+	return n;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Semáforos y mutex
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t * attr) {
+	Semaforo * s = calloc(1, sizeof(Semaforo));
+	if (s == NULL)
+		return NULL;
+	pthread_mutex_init(&s->mutex, NULL);
+	pthread_cond_init(&s->cambio, NULL);
+	s->cuenta = initial_count;
+	s->maximo = max_count;
+	return s;
+}
+
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+	Semaforo * s = semaphore_id;
+	struct timespec t;
+	limite(timeout, &t);
+	pthread_mutex_lock(&s->mutex);
+	while (s->cuenta == 0)
+		if (!espera(&s->cambio, &s->mutex, timeout, &t)) {
+			pthread_mutex_unlock(&s->mutex);
+			return timeout == 0 ? osErrorResource : osErrorTimeout;
+		}
+	s->cuenta--;
+	pthread_mutex_unlock(&s->mutex);
+	return osOK;
+}
+
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+	Semaforo * s = semaphore_id;
+	osStatus_t resultado = osOK;
+	pthread_mutex_lock(&s->mutex);
+	if (s->cuenta < s->maximo) {
+		s->cuenta++;
+		pthread_cond_signal(&s->cambio);
+	} else resultado = osErrorResource;
+	pthread_mutex_unlock(&s->mutex);
+	return resultado;
+}
+
+
+osMutexId_t osMutexNew(const osMutexAttr_t * attr) {
+	pthread_mutex_t * m = malloc(sizeof(pthread_mutex_t));
+	pthread_mutexattr_t atributos;
+	if (m == NULL)
+		return NULL;
+	pthread_mutexattr_init(&atributos);
+	pthread_mutexattr_settype(&atributos, PTHREAD_MUTEX_RECURSIVE);  // Como los mutex de CMSIS-RTOS2
+	pthread_mutex_init(m, &atributos);
+	pthread_mutexattr_destroy(&atributos);
+	return m;
+}
+
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+	if (timeout == 0)
+		return pthread_mutex_trylock(mutex_id) == 0 ? osOK : osErrorResource;
+	return pthread_mutex_lock(mutex_id) == 0 ? osOK : osError;
+	// Con un plazo distinto de 0 se espera siempre: la aplicación sólo utiliza osWaitForever
+}
+
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+	return pthread_mutex_unlock(mutex_id) == 0 ? osOK : osError;
+}
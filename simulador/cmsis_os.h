@@ -0,0 +1,109 @@
+#ifndef CMSIS_OS_H_
+#define CMSIS_OS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+  * @file cmsis_os.h
+  * @author EII
+  *
+  * @brief Subconjunto de CMSIS-RTOS2 para el simulador, implementado con hilos POSIX.
+  *
+  * Cubre las funciones que utiliza la aplicación: hilos, esperas, ticks, colas de mensajes, semáforos y
+  * mutex. Las prioridades se aceptan pero no se aplican: los hilos del simulador se reparten los núcleos
+  * del PC. Un tick equivale a 1 ms dividido por la escala fijada con osSimuladorSetEscala().
+  */
+
+
+typedef void * osThreadId_t;
+typedef void * osMessageQueueId_t;
+typedef void * osSemaphoreId_t;
+typedef void * osMutexId_t;
+typedef void (*osThreadFunc_t)(void * argument);
+
+typedef enum {
+  osOK = 0,
+  osError = -1,
+  osErrorTimeout = -2,
+  osErrorResource = -3,
+  osErrorParameter = -4,
+  osErrorNoMemory = -5
+} osStatus_t;
+
+typedef enum {
+  osPriorityNone = 0,
+  osPriorityIdle = 1,
+  osPriorityLow = 8,
+  osPriorityBelowNormal = 16,
+  osPriorityNormal = 24,
+  osPriorityAboveNormal = 32,
+  osPriorityAboveNormal1 = 32 + 1,
+  osPriorityHigh = 40,
+  osPriorityRealtime = 48,
+  osPriorityISR = 56
+} osPriority_t;
+
+typedef struct {
+  const char * name;
+  uint32_t attr_bits;
+  void * cb_mem;
+  uint32_t cb_size;
+  void * stack_mem;
+  uint32_t stack_size;
+  osPriority_t priority;
+} osThreadAttr_t;
+
+typedef struct {
+  const char * name;
+  uint32_t attr_bits;
+  void * cb_mem;
+  uint32_t cb_size;
+  void * mq_mem;
+  uint32_t mq_size;
+} osMessageQueueAttr_t;
+
+typedef struct {
+  const char * name;
+  uint32_t attr_bits;
+  void * cb_mem;
+  uint32_t cb_size;
+} osSemaphoreAttr_t, osMutexAttr_t;
+
+#define osWaitForever 0xFFFFFFFFU
+
+
+osStatus_t osKernelInitialize(void);
+osStatus_t osKernelStart(void);
+uint32_t osKernelGetTickCount(void);
+uint32_t osKernelGetTickFreq(void);
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void * argument, const osThreadAttr_t * attr);
+osThreadId_t osThreadGetId(void);
+const char * osThreadGetName(osThreadId_t thread_id);
+osStatus_t osDelay(uint32_t ticks);
+osStatus_t osDelayUntil(uint32_t ticks);
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t * attr);
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void * msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void * msg_ptr, uint8_t * msg_prio, uint32_t timeout);
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id);
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t * attr);
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+
+osMutexId_t osMutexNew(const osMutexAttr_t * attr);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+
+
+/**
+ * @brief Acelera el tiempo del simulador
+ *
+ * @param escala Ticks que avanzan por cada ms real. Con 1 el tiempo es real
+ */
+void osSimuladorSetEscala(uint32_t escala);
+
+
+#endif /* CMSIS_OS_H_ */
@@ -0,0 +1,138 @@
+// Decodifica la telemetría de USART1 (ver telemetria.h) y la escribe en CSV por la salida estándar.
+//
+// Uso: decodificaTelemetria [fichero|pseudoterminal]. Sin argumento lee la entrada estándar. Al terminar
+// escribe en la salida de error las tramas leídas, las erróneas y los registros perdidos según la secuencia,
+// y sale con código 1 si hay alguna errónea o algún registro perdido.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <termios.h>
+#include <unistd.h>
+#include "telemetria.h"
+
+
+#define MAX_TRAMA (TELEMETRIA_MAX_REGISTRO + 2)  // Con el byte de COBS y el 0 final
+
+
+static uint32_t numTramas = 0, numErroneas = 0, numPerdidos = 0;
+
+
+static uint16_t crc16(const uint8_t * datos, uint32_t bytes) {
+// CRC-16/CCITT como en telemetria.c
+
+	uint16_t crc = 0xFFFF;
+	for (uint32_t i = 0; i < bytes; i++) {
+		crc ^= (uint16_t) datos[i] << 8;
+		for (int b = 0; b < 8; b++)
+			crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+
+static int decodificaCOBS(const uint8_t * origen, uint32_t bytes, uint8_t * destino) {
+// Decodifica una trama sin el 0 final. Devuelve los bytes decodificados, o -1 si la trama está mal formada
+
+	uint32_t n = 0, i = 0;
+	while (i < bytes) {
+		uint8_t codigo = origen[i++];
+		if (codigo == 0 || i + codigo - 1 > bytes)
+			return -1;
+		for (uint8_t j = 1; j < codigo; j++)
+			destino[n++] = origen[i++];
+		if (codigo < 0xFF && i < bytes)
+			destino[n++] = 0;
+	}
+	return n;
+}
+
+
+static uint32_t leeEntero(const uint8_t * datos, int bytes) {
+	uint32_t valor = 0;
+	for (int i = bytes - 1; i >= 0; i--)
+		valor = valor << 8 | datos[i];
+	return valor;
+}
+
+
+static void escribeRegistro(const uint8_t * trama, uint32_t bytes) {
+	static int secuenciaEsperada = -1;
+	uint8_t registro[MAX_TRAMA];
+	int n = decodificaCOBS(trama, bytes, registro);
+	numTramas++;
+	if (n < TELEMETRIA_CABECERA + 2 || n > TELEMETRIA_MAX_REGISTRO ||
+			crc16(registro, n - 2) != leeEntero(&registro[n - 2], 2)) {
+		numErroneas++;
+		return;
+	}
+
+	uint8_t secuencia = registro[1];
+	if (secuenciaEsperada >= 0)
+		numPerdidos += (uint8_t) (secuencia - secuenciaEsperada);
+	secuenciaEsperada = (uint8_t) (secuencia + 1);
+
+	const uint8_t * datos = &registro[TELEMETRIA_CABECERA];
+	int numDatos = n - 2 - TELEMETRIA_CABECERA;
+	printf("%u,%u,", secuencia, leeEntero(&registro[2], 4));
+	switch (registro[0]) {
+	case TELEMETRIA_LECTURA:
+		if (numDatos == 2)
+			printf("lectura,%d,\n", (int16_t) leeEntero(datos, 2));
+		break;
+	case TELEMETRIA_DOSIS:
+		if (numDatos == 2)
+			printf("dosis,%.2f,\n", leeEntero(datos, 2) / 100.0);
+		break;
+	case TELEMETRIA_ALARMA:
+		if (numDatos == 3)
+			printf("alarma,%d,%u\n", (int16_t) leeEntero(datos, 2), datos[2]);
+		break;
+	case TELEMETRIA_PERFIL:
+		if (numDatos == 6)
+			printf("perfil,%u,%u/%u\n", leeEntero(&datos[2], 4), datos[0], datos[1]);  // Duración, tarea/zona
+		break;
+	default:
+		printf("tipo %u,,\n", registro[0]);
+	}
+}
+
+
+int main(int argc, char ** argv) {
+	FILE * entrada = stdin;
+	if (argc > 2) {
+		fprintf(stderr, "Uso: %s [fichero|pseudoterminal]\n", argv[0]);
+		return 2;
+	}
+	if (argc == 2 && (entrada = fopen(argv[1], "rb")) == NULL) {
+		fprintf(stderr, "No se puede abrir %s\n", argv[1]);
+		return 1;
+	}
+	if (isatty(fileno(entrada))) {  // Pseudoterminal del simulador o puerto serie: sin conversiones
+		struct termios modo;
+		tcgetattr(fileno(entrada), &modo);
+		cfmakeraw(&modo);
+		tcsetattr(fileno(entrada), TCSANOW, &modo);
+	}
+
+	printf("secuencia,instante,tipo,valor,extra\n");
+	uint8_t trama[MAX_TRAMA];
+	uint32_t bytes = 0;
+	int c, desbordada = 0;
+	while ((c = fgetc(entrada)) != EOF) {
+		if (c != 0) {
+			if (bytes < MAX_TRAMA)
+				trama[bytes++] = c;
+			else desbordada = 1;  // Sin el 0 de la anterior: se descarta hasta el siguiente 0
+			continue;
+		}
+		if (desbordada)
+			numErroneas++, numTramas++;
+		else if (bytes > 0)
+			escribeRegistro(trama, bytes);
+		bytes = 0;
+		desbordada = 0;
+	}
+	fflush(stdout);
+	fprintf(stderr, "%u tramas, %u erróneas, %u registros perdidos\n", numTramas, numErroneas, numPerdidos);
+	return numErroneas > 0 || numPerdidos > 0;
+}
@@ -0,0 +1,9 @@
+#include "JuegoAlpha13.h"
+#include "JuegoAlpha15.h"
+#include "JuegoAlpha17.h"
+
+
+// Mismo alto que los juegos reales y un ancho medio aproximado
+const LCD_JuegoCaracteresAlpha juegoAlpha13 = {13, 8};
+const LCD_JuegoCaracteresAlpha juegoAlpha15 = {15, 9};
+const LCD_JuegoCaracteresAlpha juegoAlpha17 = {17, 10};
@@ -0,0 +1,309 @@
+#include "pantallaLCD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "simulador.h"
+#include "frameLCD.h"
+#include "memoriaSDRAM.h"
+#include "colorLCD.h"
+
+
+uint8_t simuladorSDRAM[SDRAM_TAMANO] __attribute__((aligned(32)));  // Frame buffers y resto de la SDRAM
+
+static int horizontal = 0;  // Buleano cierto si la pantalla está girada 90 grados
+static int bufferVisible = 0;  // Índice del frame buffer que se muestra
+static uint32_t numFrames = 0;  // Número de intercambios de buffers
+static uint32_t puntosEscritos = 0;  // Puntos escritos por las funciones de dibujo
+static uint32_t framesFinal = 0;  // Termina tras este número de frames, 0 para no terminar
+static const char * ficheroFinal = NULL;  // Donde se guarda la última imagen
+
+static pthread_mutex_t mutexTactil = PTHREAD_MUTEX_INITIALIZER;
+static int pulsandoGuion = 0, pulsandoLeido = 0;  // Estado que fija el guion y estado leído
+static uint16_t xGuion, yGuion, xLeido, yLeido;
+
+
+// ---------------------------------------------------------------------------------------------------
+// Puntos
+
+static uint16_t anchoPantalla(void) {
+	return horizontal ? LCD_ALTO_FISICO : LCD_ANCHO_FISICO;
+}
+
+
+static uint16_t altoPantalla(void) {
+	return horizontal ? LCD_ANCHO_FISICO : LCD_ALTO_FISICO;
+}
+
+
+static uint8_t * direccionPunto(int buffer, uint16_t x, uint16_t y) {
+// Dirección del punto (x, y) de la pantalla en el frame buffer indicado
+
+	uint16_t columna = x, fila = y;
+	if (horizontal) {
+		columna = LCD_ANCHO_FISICO - 1 - y;
+		fila = x;
+	}
+	return simuladorSDRAM + buffer * LCD_TAMANO_BUFFER + (fila * LCD_ANCHO_FISICO + columna) * LCD_BYTES_PUNTO;
+}
+
+
+static uint32_t leePunto(const uint8_t * p) {
+#ifdef LCD_FORMATO_RGB565
+	return LCD_RGB565_A_ARGB(*(const uint16_t *) p);
+#else
+	return *(const uint32_t *) p;
+#endif
+}
+
+
+static void escribePunto(uint8_t * p, uint32_t color) {
+#ifdef LCD_FORMATO_RGB565
+	*(uint16_t *) p = LCD_ARGB_A_RGB565(color);
+#else
+	*(uint32_t *) p = color;
+#endif
+}
+
+
+static uint32_t gris(uint32_t color) {
+	uint32_t r = (color >> 16) & 0xFF, g = (color >> 8) & 0xFF, b = color & 0xFF;
+	uint32_t luminancia = (r * 77 + g * 150 + b * 29) >> 8;
+	return (color & 0xFF000000u) | (luminancia << 16) | (luminancia << 8) | luminancia;
+}
+
+
+static void mezclaPunto(uint16_t x, uint16_t y, uint32_t color, uint32_t alfa, int enBlancoYNegro) {
+// Mezcla un color con opacidad 'alfa' (0 a 255) en el punto (x, y) del frame buffer oculto
+
+	if (x >= anchoPantalla() || y >= altoPantalla() || alfa == 0)
+		return;
+	if (enBlancoYNegro)
+		color = gris(color);
+	uint8_t * p = direccionPunto(!bufferVisible, x, y);
+	puntosEscritos++;
+	if (alfa >= 255) {
+		escribePunto(p, color | 0xFF000000u);
+		return;
+	}
+	uint32_t fondo = leePunto(p), mezcla = 0xFF000000u;
+	for (int desp = 0; desp < 24; desp += 8) {
+		uint32_t cf = (fondo >> desp) & 0xFF, cc = (color >> desp) & 0xFF;
+		mezcla |= ((cc * alfa + cf * (255 - alfa) + 127) / 255) << desp;
+	}
+	escribePunto(p, mezcla);
+}
+
+
+static uint32_t alfaColor(uint32_t color, int transparencia) {
+// Opacidad de 0 a 255 de un color según su canal alfa y la transparencia de 0 a 100
+
+	if (transparencia <= 0) return 0;
+	if (transparencia > 100) transparencia = 100;
+	return (color >> 24) * transparencia / 100;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Frame buffers
+
+void LCD_inicializa2Buffers(int enHorizontal) {
+	horizontal = enHorizontal;
+	bufferVisible = 0;  // Se muestra el primero y se dibuja en el segundo, como en la placa
+}
+
+
+void LCD_intercambiaBuffers(void) {
+	bufferVisible = !bufferVisible;
+	numFrames++;
+	if (framesFinal != 0 && numFrames >= framesFinal) {
+		if (ficheroFinal != NULL)
+			simuladorGuardaPantalla(ficheroFinal);
+		exit(0);
+	}
+}
+
+
+void LCD_setFondoColor(uint32_t color) {
+	uint8_t * p = simuladorSDRAM + !bufferVisible * LCD_TAMANO_BUFFER;
+	for (uint32_t i = 0; i < LCD_ANCHO_FISICO * LCD_ALTO_FISICO; i++, p += LCD_BYTES_PUNTO)
+		escribePunto(p, color);
+	puntosEscritos += LCD_ANCHO_FISICO * LCD_ALTO_FISICO;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Primitivas
+
+void LCD_dibujaPunto(uint16_t x, uint16_t y, uint32_t color, int enBlancoYNegro, int transparencia) {
+	mezclaPunto(x, y, color, alfaColor(color, transparencia), enBlancoYNegro);
+}
+
+
+void LCD_dibujaLinea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, int enBlancoYNegro,
+	int transparencia) {
+	uint32_t alfa = alfaColor(color, transparencia);
+	int dx = abs(x2 - x1), dy = -abs(y2 - y1);
+	int sx = x1 < x2 ? 1 : -1, sy = y1 < y2 ? 1 : -1;
+	int error = dx + dy, x = x1, y = y1;
+	for(;;) {  // Algoritmo de Bresenham
+		mezclaPunto(x, y, color, alfa, enBlancoYNegro);
+		if (x == x2 && y == y2)
+			break;
+		int e2 = 2 * error;
+		if (e2 >= dy) { error += dy; x += sx; }
+		if (e2 <= dx) { error += dx; y += sy; }
+	}
+}
+
+
+void LCD_dibujaRectangulo(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+	int enBlancoYNegro, int transparencia) {
+	if (ancho == 0 || alto == 0)
+		return;
+	LCD_dibujaLinea(x, y, x + ancho - 1, y, color, enBlancoYNegro, transparencia);
+	LCD_dibujaLinea(x, y + alto - 1, x + ancho - 1, y + alto - 1, color, enBlancoYNegro, transparencia);
+	LCD_dibujaLinea(x, y, x, y + alto - 1, color, enBlancoYNegro, transparencia);
+	LCD_dibujaLinea(x + ancho - 1, y, x + ancho - 1, y + alto - 1, color, enBlancoYNegro, transparencia);
+}
+
+
+void LCD_dibujaRectanguloRelleno(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+	int enBlancoYNegro, int transparencia) {
+	uint32_t alfa = alfaColor(color, transparencia);
+	for (uint16_t j = 0; j < alto; j++)
+		for (uint16_t i = 0; i < ancho; i++)
+			mezclaPunto(x + i, y + j, color, alfa, enBlancoYNegro);
+}
+
+
+void LCD_dibujaRectanguloRellenoOpaco(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color) {
+	for (uint16_t j = 0; j < alto; j++)
+		for (uint16_t i = 0; i < ancho; i++)
+			mezclaPunto(x + i, y + j, color, 255, 0);
+}
+
+
+void LCD_dibujaImagen(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
+	int enBlancoYNegro, int transparencia) {
+	const uint32_t * puntos = (const uint32_t *) colores;
+	for (uint16_t j = 0; j < alto; j++)
+		for (uint16_t i = 0; i < ancho; i++, puntos++)
+			mezclaPunto(x + i, y + j, *puntos, alfaColor(*puntos, transparencia), enBlancoYNegro);
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Texto
+
+static uint16_t anchoCaracter(char c, const LCD_JuegoCaracteresAlpha * juego) {
+	return c == ' ' ? juego->ancho / 2 : juego->ancho;
+}
+
+
+static uint8_t alfaCaracter(char c, uint16_t i, uint16_t j, const LCD_JuegoCaracteresAlpha * juego) {
+// Patrón sintético del carácter 'c': el borde del rectángulo y una línea horizontal que depende del carácter
+
+	if (c == ' ')
+		return 0;
+	uint16_t ancho = juego->ancho, alto = juego->alto;
+	if (i == 0 || j == 0 || i == ancho - 1 || j == alto - 1)
+		return 255;
+	if (j == 1 + (uint8_t) c % (alto - 2))
+		return 160;
+	return 0;
+}
+
+
+void LCD_dibujaCadenaCaracteresAlpha(uint16_t x, uint16_t y, const char * cadena, uint32_t color,
+	uint16_t separacion, const LCD_JuegoCaracteresAlpha * juego, int enBlancoYNegro, int transparencia) {
+	uint32_t opacidad = transparencia <= 0 ? 0 : transparencia >= 100 ? 255 : transparencia * 255 / 100;
+	// El alfa del color no se utiliza: la opacidad de cada punto la da el carácter
+	for (; *cadena; cadena++) {
+		uint16_t ancho = anchoCaracter(*cadena, juego);
+		for (uint16_t j = 0; j < juego->alto; j++)
+			for (uint16_t i = 0; i < ancho; i++) {
+				uint32_t alfa = alfaCaracter(*cadena, i, j, juego) * opacidad / 255;
+				mezclaPunto(x + i, y + j, color, alfa, enBlancoYNegro);
+			}
+		x += ancho + separacion;
+	}
+}
+
+
+uint16_t LCD_anchoCadenaCaracteresAlpha(const char * cadena, const LCD_JuegoCaracteresAlpha * juego,
+	uint16_t separacion) {
+	uint16_t ancho = 0;
+	for (const char * c = cadena; *c; c++)
+		ancho += anchoCaracter(*c, juego) + (c == cadena ? 0 : separacion);
+	return ancho;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Pantalla táctil
+
+void LCD_actualizaPulsacion(void) {
+	pthread_mutex_lock(&mutexTactil);
+	pulsandoLeido = pulsandoGuion;
+	xLeido = xGuion;
+	yLeido = yGuion;
+	pthread_mutex_unlock(&mutexTactil);
+}
+
+
+int LCD_pulsando(void) {
+	return pulsandoLeido;
+}
+
+
+uint16_t LCD_xPulsacion(void) {
+	return xLeido;
+}
+
+
+uint16_t LCD_yPulsacion(void) {
+	return yLeido;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Control del simulador
+
+void simuladorSetPulsacion(int pulsando, uint16_t x, uint16_t y) {
+	pthread_mutex_lock(&mutexTactil);
+	pulsandoGuion = pulsando;
+	xGuion = x;
+	yGuion = y;
+	pthread_mutex_unlock(&mutexTactil);
+}
+
+
+void simuladorSetFinal(uint32_t frames, const char * fichero) {
+	framesFinal = frames;
+	ficheroFinal = fichero;
+}
+
+
+uint32_t simuladorNumFrames(void) {
+	return numFrames;
+}
+
+
+uint32_t simuladorPuntosEscritos(void) {
+	return puntosEscritos;
+}
+
+
+int simuladorGuardaPantalla(const char * fichero) {
+	FILE * f = fopen(fichero, "wb");
+	if (f == NULL)
+		return 0;
+	fprintf(f, "P6\n%d %d\n255\n", anchoPantalla(), altoPantalla());
+	for (uint16_t y = 0; y < altoPantalla(); y++)
+		for (uint16_t x = 0; x < anchoPantalla(); x++) {
+			uint32_t color = leePunto(direccionPunto(bufferVisible, x, y));
+			uint8_t rgb[3] = {color >> 16, color >> 8, color};
+			fwrite(rgb, 1, 3, f);
+		}
+	return fclose(f) == 0;
+}
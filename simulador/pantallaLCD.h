@@ -0,0 +1,87 @@
+#ifndef PANTALLALCD_H_
+#define PANTALLALCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file pantallaLCD.h
+  * @author EII
+  *
+  * @brief Simulación de la biblioteca pantallaLCD para ejecutar la interfaz en un PC, sin pantalla.
+  *
+  * Implementa las funciones de pantallaLCD que utilizan interfazLCD y la aplicación sobre dos frame buffers
+  * en memoria, con la misma organización que en la placa: 240 x 320 puntos físicos, el primer buffer al
+  * principio de la SDRAM simulada y el segundo a continuación, y la pantalla girada 90 grados en
+  * horizontal. Así se comprueban también frameLCD, fondoLCD y dma2dLCD, que escriben directamente en los
+  * frame buffers.
+  *
+  * La pantalla táctil se alimenta con un guion (ver simulador.h). Los juegos de caracteres son sintéticos:
+  * cada carácter es un rectángulo con un patrón de alfa, con el mismo coste por punto que uno real pero sin
+  * su forma.
+  */
+
+
+/**
+ * @brief Juego de caracteres simulado
+ */
+typedef struct {
+    /** @brief Alto de los caracteres en puntos */
+    uint16_t alto;
+    /** @brief Ancho de los caracteres en puntos, salvo el espacio */
+    uint16_t ancho;
+} LCD_JuegoCaracteresAlpha;
+
+
+/** @brief Inicializa la pantalla con dos frame buffers, en horizontal si 'horizontal' es cierto */
+void LCD_inicializa2Buffers(int horizontal);
+
+/** @brief Muestra el frame buffer oculto y pasa a dibujar en el otro */
+void LCD_intercambiaBuffers(void);
+
+/** @brief Rellena el frame buffer oculto con un color */
+void LCD_setFondoColor(uint32_t color);
+
+/** @brief Dibuja un punto */
+void LCD_dibujaPunto(uint16_t x, uint16_t y, uint32_t color, int enBlancoYNegro, int transparencia);
+
+/** @brief Dibuja una línea entre dos puntos */
+void LCD_dibujaLinea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, int enBlancoYNegro,
+    int transparencia);
+
+/** @brief Dibuja el borde de un rectángulo */
+void LCD_dibujaRectangulo(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+    int enBlancoYNegro, int transparencia);
+
+/** @brief Dibuja un rectángulo relleno, mezclado según el alfa del color y la transparencia */
+void LCD_dibujaRectanguloRelleno(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color,
+    int enBlancoYNegro, int transparencia);
+
+/** @brief Dibuja un rectángulo relleno opaco, ignorando el alfa del color */
+void LCD_dibujaRectanguloRellenoOpaco(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, uint32_t color);
+
+/** @brief Dibuja una imagen en formato ARGB de 32 bits */
+void LCD_dibujaImagen(uint16_t x, uint16_t y, uint16_t ancho, uint16_t alto, const uint8_t * colores,
+    int enBlancoYNegro, int transparencia);
+
+/** @brief Dibuja una cadena de caracteres */
+void LCD_dibujaCadenaCaracteresAlpha(uint16_t x, uint16_t y, const char * cadena, uint32_t color,
+    uint16_t separacion, const LCD_JuegoCaracteresAlpha * juego, int enBlancoYNegro, int transparencia);
+
+/** @brief Ancho en puntos de una cadena de caracteres */
+uint16_t LCD_anchoCadenaCaracteresAlpha(const char * cadena, const LCD_JuegoCaracteresAlpha * juego,
+    uint16_t separacion);
+
+/** @brief Lee el estado de la pantalla táctil, que en el simulador da el guion */
+void LCD_actualizaPulsacion(void);
+
+/** @brief Buleano cierto si había una pulsación en la última lectura */
+int LCD_pulsando(void);
+
+/** @brief Coordenada X de la última pulsación */
+uint16_t LCD_xPulsacion(void);
+
+/** @brief Coordenada Y de la última pulsación */
+uint16_t LCD_yPulsacion(void);
+
+
+#endif /* PANTALLALCD_H_ */
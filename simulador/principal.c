@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cmsis_os.h"
+#include "simulador.h"
+#include "tactilLCD.h"
+#include "tareas.h"
+#include "rendimiento.h"
+#include "perfilado.h"
+#include "telemetria.h"
+
+
+#define MAX_EVENTOS_GUION 1024
+
+typedef struct {
+	uint32_t instante;
+	int pulsando;
+	uint16_t x, y;
+} EventoGuion;
+
+static EventoGuion guion[MAX_EVENTOS_GUION];  // Eventos táctiles del guion, en orden de instante
+static int numEventosGuion = 0;
+
+static const osThreadAttr_t tareaPantalla_attributes = {
+  .name = "defaultTask",
+  .stack_size = 4096 * 4,
+  .priority = (osPriority_t) osPriorityNormal,
+};
+
+static const osThreadAttr_t tareaGuion_attributes = {
+  .name = "guion",
+  .stack_size = 256 * 4,
+  .priority = (osPriority_t) osPriorityRealtime,
+};
+
+
+static int cargaGuion(const char * fichero) {
+// Lee el guion táctil. Devuelve falso si no se puede abrir o hay una línea incorrecta
+
+	FILE * f = fopen(fichero, "r");
+	char linea[128], evento[16];
+	if (f == NULL)
+		return 0;
+	while (fgets(linea, sizeof(linea), f) != NULL && numEventosGuion < MAX_EVENTOS_GUION) {
+		EventoGuion * e = &guion[numEventosGuion];
+		unsigned instante, x = 0, y = 0;
+		if (linea[0] == '#' || sscanf(linea, "%u %15s", &instante, evento) < 2)
+			continue;  // Comentario o línea vacía
+		if (strcmp(evento, "suelta") != 0 && sscanf(linea, "%*u %*s %u %u", &x, &y) != 2) {
+			fclose(f);
+			return 0;
+		}
+		e->instante = instante;
+		e->pulsando = strcmp(evento, "suelta") != 0;
+		e->x = x;
+		e->y = y;
+		numEventosGuion++;
+	}
+	fclose(f);
+	return 1;
+}
+
+
+static void escribeSalida(const char * linea) {
+	fputs(linea, stdout);
+}
+
+
+#ifdef PERFILADO
+static void escribeInformePerfilado(void) {
+// Al terminar el programa, tras el último frame
+
+	informePerfilado(escribeSalida);
+}
+#endif
+
+
+static void tareaGuion(void * argumento) {
+// Reproduce el guion táctil: en cada instante fija el estado del panel y activa TP_INT1
+
+	for (int i = 0; i < numEventosGuion; i++) {
+		osDelayUntil(guion[i].instante);
+		simuladorSetPulsacion(guion[i].pulsando, guion[i].x, guion[i].y);
+		LCD_interrupcionTactil();
+	}
+}
+
+
+int main(int argc, char ** argv) {
+	uint32_t numFrames = 200, escala = 1, iteraciones = 0;
+	const char * imagen = NULL, * ficheroGuion = NULL, * destinoUART = NULL;
+	int opcion;
+	while ((opcion = getopt(argc, argv, "f:s:t:e:b:u:")) != -1) {
+		switch (opcion) {
+		case 'f': numFrames = strtoul(optarg, NULL, 10); break;
+		case 's': imagen = optarg; break;
+		case 't': ficheroGuion = optarg; break;
+		case 'e': escala = strtoul(optarg, NULL, 10); break;
+		case 'b': iteraciones = strtoul(optarg, NULL, 10); break;
+		case 'u': destinoUART = optarg; break;
+		default:
+			fprintf(stderr, "Uso: %s [-f frames] [-s imagen.ppm] [-t guion.txt] [-e escala] [-b iteraciones] "
+				"[-u fichero|pty]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (ficheroGuion != NULL && !cargaGuion(ficheroGuion)) {
+		fprintf(stderr, "No se puede leer el guion %s\n", ficheroGuion);
+		return 1;
+	}
+	if (destinoUART != NULL && !simuladorAbreUART(destinoUART)) {
+		fprintf(stderr, "No se puede abrir %s para USART1\n", destinoUART);
+		return 1;
+	}
+
+	osKernelInitialize();
+#ifdef PERFILADO
+	inicializaPerfilado();
+	atexit(escribeInformePerfilado);
+#endif
+	if (iteraciones > 0) {  // Sólo las medidas, sin las demás tareas
+		ejecutaRendimiento(iteraciones, escribeSalida);
+		if (imagen != NULL)
+			simuladorGuardaPantalla(imagen);
+		return 0;
+	}
+	osSimuladorSetEscala(escala);
+	simuladorSetFinal(numFrames, imagen);
+
+	inicializaTelemetria();
+	inicializaTareas();  // Lo mismo que main.c en la placa
+	osThreadNew(tareaPantalla, NULL, &tareaPantalla_attributes);
+	if (numEventosGuion > 0)
+		osThreadNew(tareaGuion, NULL, &tareaGuion_attributes);
+
+	osKernelStart();
+	return 0;
+}
@@ -0,0 +1,247 @@
+// Prueba en el PC de la entrada de las lecturas del sensor (ver ingestaGlucosa.h).
+//
+// Simula un transmisor que pierde lecturas sueltas y periodos largos, más largos que la ventana de
+// reenvío, y que las reenvía más tarde, a veces fuera de la ventana, o repite lecturas. El consumidor saca
+// las lecturas a ratos y a veces da por perdida la siguiente con huecoIngesta(). Cada lectura que devuelve
+// la entrada se compara con la que predice un modelo sencillo de ingestaGlucosa.h: huecos en orden con el
+// instante de su periodo, como mucho INGESTA_VENTANA_REENVIO - 1 por salto, reenviadas sólo para huecos
+// aún en la ventana y repetidas descartadas. Termina con un código distinto de 0 si algo no coincide.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ingestaGlucosa.h"
+
+
+#define NUM_PERIODOS 200000
+#define PERIODO 50  // Ticks entre dos lecturas. Las lecturas llevan el instante numero * PERIODO
+#define MAX_PENDIENTES 1024  // Lecturas perdidas que el transmisor guarda para reenviarlas
+
+enum {SIN_DEVOLVER, DEVUELTA, HUECO, RELLENADO};  // Estado de cada periodo en el modelo
+
+static IngestaGlucosa ingesta;
+static int valores[NUM_PERIODOS];  // Lo que mide el sensor en cada periodo
+static int errores = 0;
+
+static struct {
+	int hayLecturas;
+	uint32_t siguiente;
+	uint8_t estado[NUM_PERIODOS];
+	uint32_t numHuecos, numRecuperadas, numDescartadas, numRecortadas, numEsperas;
+	uint32_t numOlvidados;  // Periodos saltados que no caben en la ventana y no se devuelven como hueco
+} modelo;
+
+static LecturaSensor publicadas[INGESTA_CAPACIDAD_COLA];  // Copia de la cola, para el modelo
+static uint32_t cabezaPublicadas = 0, colaPublicadas = 0;
+static LecturaSensor esperadas[INGESTA_VENTANA_REENVIO + 1];  // Lo que debe devolver la entrada
+static uint32_t numEsperadas = 0, siguienteEsperada = 0;
+
+typedef struct {
+	uint32_t numero;  // Periodo de la lectura
+	uint32_t reenvio;  // Periodo en que se reenvía
+} Pendiente;
+
+static Pendiente pendientes[MAX_PENDIENTES];
+static uint32_t numPendientes = 0;
+
+
+static LecturaSensor lectura(uint32_t numero) {
+	return (LecturaSensor) {numero * PERIODO, numero, valores[numero], CALIDAD_VALIDA, FUENTE_SENSOR};
+}
+
+
+static void espera(LecturaSensor l) {
+	esperadas[numEsperadas++] = l;
+}
+
+
+static void esperaHueco(uint32_t numero) {
+	espera((LecturaSensor) {numero * PERIODO, numero, 0, CALIDAD_HUECO, FUENTE_INGESTA});
+	modelo.estado[numero] = HUECO;
+}
+
+
+static void modeloRecibe(LecturaSensor l) {
+// Lo que devuelve la entrada al sacar de la cola la lectura 'l', según ingestaGlucosa.h
+
+	if (l.valor < INGESTA_MINIMO || l.valor > INGESTA_MAXIMO) {
+		l.valor = l.valor < INGESTA_MINIMO ? INGESTA_MINIMO : INGESTA_MAXIMO;
+		l.calidad = CALIDAD_FUERA_RANGO;
+		modelo.numRecortadas++;
+	}
+	uint32_t n = l.numero;
+	if (!modelo.hayLecturas || n >= modelo.siguiente) {
+		if (modelo.hayLecturas) {
+			uint32_t saltados = n - modelo.siguiente;
+			uint32_t huecos = saltados < INGESTA_VENTANA_REENVIO ? saltados : INGESTA_VENTANA_REENVIO - 1;
+			modelo.numHuecos += saltados;
+			modelo.numOlvidados += saltados - huecos;
+			for (uint32_t k = n - huecos; k < n; k++)
+				esperaHueco(k);  // Los más antiguos que no caben en la ventana no se devuelven
+		}
+		modelo.hayLecturas = 1;
+		modelo.siguiente = n + 1;
+		modelo.estado[n] = DEVUELTA;
+		espera(l);
+	} else if (modelo.siguiente - n <= INGESTA_VENTANA_REENVIO && modelo.estado[n] == HUECO) {
+		l.fuente = FUENTE_REENVIO;
+		modelo.estado[n] = RELLENADO;
+		modelo.numRecuperadas++;
+		espera(l);
+	} else modelo.numDescartadas++;
+}
+
+
+static int iguales(const LecturaSensor * a, const LecturaSensor * b) {
+	return a->instante == b->instante && a->numero == b->numero && a->valor == b->valor &&
+		a->calidad == b->calidad && a->fuente == b->fuente;
+}
+
+
+static void compruebaSalida(const LecturaSensor * l) {
+	while (siguienteEsperada == numEsperadas && colaPublicadas != cabezaPublicadas) {
+		numEsperadas = siguienteEsperada = 0;
+		modeloRecibe(publicadas[colaPublicadas++ % INGESTA_CAPACIDAD_COLA]);
+	}
+	if (siguienteEsperada == numEsperadas) {
+		printf("Periodo %u: sobra una lectura\n", l->numero);
+		errores++;
+		return;
+	}
+	const LecturaSensor * e = &esperadas[siguienteEsperada++];
+	if (!iguales(l, e)) {
+		printf("Periodo %u: devuelve periodo %u, valor %d, calidad %u, fuente %u; se esperaba periodo %u, "
+			"valor %d, calidad %u, fuente %u\n", e->numero, l->numero, l->valor, l->calidad, l->fuente,
+			e->numero, e->valor, e->calidad, e->fuente);
+		errores++;
+	}
+}
+
+
+static void consume(void) {
+	LecturaSensor l;
+	while (siguienteLecturaIngesta(&l, &ingesta))
+		compruebaSalida(&l);
+
+	// Todo lo publicado tiene que haber salido, salvo las que el modelo descarta
+	while (colaPublicadas != cabezaPublicadas) {
+		numEsperadas = siguienteEsperada = 0;
+		modeloRecibe(publicadas[colaPublicadas++ % INGESTA_CAPACIDAD_COLA]);
+		if (numEsperadas > 0) {
+			printf("Periodo %u: falta una lectura\n", esperadas[0].numero);
+			errores++;
+		}
+	}
+	if (siguienteEsperada != numEsperadas) {
+		printf("Periodo %u: falta una lectura\n", esperadas[siguienteEsperada].numero);
+		errores++;
+	}
+	numEsperadas = siguienteEsperada = 0;
+}
+
+
+static void publica(LecturaSensor l) {
+	while (!publicaLecturaSensor(&l, &ingesta))
+		consume();  // Cola llena: el consumidor se pone al día
+	publicadas[cabezaPublicadas++ % INGESTA_CAPACIDAD_COLA] = l;
+}
+
+
+static void esperaLectura(void) {
+// El consumidor no recibe la siguiente lectura a tiempo y da su periodo por perdido
+
+	consume();
+	uint32_t instante;
+	int hay = instanteSiguienteIngesta(&instante, &ingesta);
+	if (hay != modelo.hayLecturas || (hay && instante != modelo.siguiente * PERIODO)) {
+		printf("Instante siguiente: %u, se esperaba %u\n", instante, modelo.siguiente * PERIODO);
+		errores++;
+	}
+	LecturaSensor l;
+	if (huecoIngesta(&l, &ingesta) != modelo.hayLecturas) {
+		printf("Espera tras el periodo %u: hueco %s\n", modelo.siguiente, modelo.hayLecturas ? "no devuelto" :
+			"sin lecturas");
+		errores++;
+		return;
+	}
+	if (!modelo.hayLecturas)
+		return;
+	esperaHueco(modelo.siguiente++);
+	modelo.numHuecos++;
+	modelo.numEsperas++;
+	compruebaSalida(&l);
+	numEsperadas = siguienteEsperada = 0;
+}
+
+
+static void guardaPerdida(uint32_t numero) {
+// El transmisor la reenviará al cabo de 1 a 1,5 ventanas, así que algunas llegan fuera de la ventana
+
+	if (numPendientes < MAX_PENDIENTES && rand() % 5 != 0)
+		pendientes[numPendientes++] = (Pendiente) {numero,
+			numero + 1 + rand() % (INGESTA_VENTANA_REENVIO * 3 / 2)};
+}
+
+
+static void reenvia(uint32_t periodo) {
+	for (uint32_t i = 0; i < numPendientes; )
+		if (pendientes[i].reenvio <= periodo) {
+			publica(lectura(pendientes[i].numero));
+			pendientes[i] = pendientes[--numPendientes];
+		} else i++;
+}
+
+
+int main(void) {
+	srand(1);
+	inicializaIngesta(PERIODO, &ingesta);
+	esperaLectura();  // Sin lecturas aún no hay hueco
+
+	int valor = 120;
+	uint32_t finCorte = 0;  // Periodo en que vuelve la conexión
+	int esperasEnCorte = 0;  // Buleano cierto si el consumidor da por perdidas las lecturas durante el corte
+	for (uint32_t n = 0; n < NUM_PERIODOS; n++) {
+		valor += rand() % 7 - 3;
+		if (valor < 60 || valor > 300) valor = 120;
+		valores[n] = rand() % 100 == 0 ? (rand() % 2 ? 20 : 450) : valor;  // Algunas fuera de rango
+
+		if (n > 0 && rand() % 2000 == 0) {
+			finCorte = n + 1 + rand() % (INGESTA_VENTANA_REENVIO + 100);  // Corte más largo que la ventana
+			esperasEnCorte = rand() % 2;  // Si no, sus huecos se descubren de golpe al volver la conexión
+		}
+		if (n < finCorte)
+			guardaPerdida(n);  // Sin conexión no llega nada
+		else {
+			if (n > 0 && rand() % 20 == 0)
+				guardaPerdida(n);
+			else publica(lectura(n));
+			reenvia(n);
+			if (n > 5 && rand() % 50 == 0)
+				publica(lectura(n - rand() % 5));  // Repetida
+		}
+		if (rand() % 2 == 0)
+			consume();
+		if (rand() % 10 == 0 && (n >= finCorte || esperasEnCorte))
+			esperaLectura();
+	}
+	reenvia(UINT32_MAX);
+	consume();
+
+	if (ingesta.numHuecos != modelo.numHuecos || ingesta.numRecuperadas != modelo.numRecuperadas ||
+			ingesta.numDescartadas != modelo.numDescartadas) {
+		printf("Contadores: %u huecos, %u recuperadas, %u descartadas; se esperaban %u, %u, %u\n",
+			ingesta.numHuecos, ingesta.numRecuperadas, ingesta.numDescartadas, modelo.numHuecos,
+			modelo.numRecuperadas, modelo.numDescartadas);
+		errores++;
+	}
+	if (modelo.numEsperas == 0 || modelo.numRecuperadas == 0 || modelo.numDescartadas == 0 ||
+			modelo.numRecortadas == 0 || modelo.numOlvidados == 0) {
+		printf("La prueba no ha cubierto todos los casos\n");
+		errores++;
+	}
+
+	printf("%u periodos: %u huecos (%u por espera, %u fuera de la ventana), %u recuperadas, %u descartadas, "
+		"%u fuera de rango\n", NUM_PERIODOS, modelo.numHuecos, modelo.numEsperas, modelo.numOlvidados,
+		modelo.numRecuperadas, modelo.numDescartadas, modelo.numRecortadas);
+	printf("%d errores\n", errores);
+	return errores != 0;
+}
@@ -0,0 +1,261 @@
+// Prueba en el PC del registro comprimido (ver registroGlucosa.h).
+//
+// Llena el registro hasta que da varias vueltas al buffer circular y comprueba que lo que se lee coincide
+// con lo que se escribió: el recorrido completo, búsquedas en instantes al azar, el relleno de huecos con
+// mediciones que llegan tarde y el salto de bloques con el CRC estropeado. Escribe la velocidad de
+// codificación y decodificación y termina con un código distinto de 0 si algo no coincide.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "frameLCD.h"
+#include "memoriaSDRAM.h"
+#include "registroGlucosa.h"
+
+
+#define NUM_MEDICIONES (4 * REGISTRO_BLOQUES * 60)  // Unas cuatro vueltas al buffer circular
+#define NUM_BUSQUEDAS 10000
+#define NUM_ESTROPEADOS 20
+#define NUM_FINALES 100  // Se añaden después de rellenar los huecos, para probar los del bloque que se llena
+
+uint8_t simuladorSDRAM[SDRAM_TAMANO] __attribute__((aligned(32)));  // Para reservaSDRAM(), sin pantallaLCD
+
+static uint32_t instantes[NUM_MEDICIONES];
+static int valores[NUM_MEDICIONES];
+static RegistroGlucosa registro;
+static int errores = 0;
+
+
+static double segundos(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+
+static void generaMediciones(void) {
+// Paseo aleatorio como el de un sensor, con saltos grandes, huecos (0) y saltos del reloj
+
+	uint32_t instante = 1000;
+	int valor = 100;
+	for (int i = 0; i < NUM_MEDICIONES; i++) {
+		int azar = rand() % 1000;
+		if (azar < 5)
+			instante += 1 + rand() % 20;  // Salto del reloj: empieza un bloque nuevo
+		else instante++;
+		if (azar < 10)
+			valor = 40 + rand() % 361;  // Diferencia de más de un byte
+		else valor += rand() % 7 - 3;
+		if (valor < 40) valor = 40;
+		if (valor > 400) valor = 400;
+		instantes[i] = instante;
+		valores[i] = rand() % 100 == 0 ? 0 : valor;
+	}
+}
+
+
+static int primeraGuardada(void) {
+// Índice de la primera medición que conserva el registro tras sobrescribir los bloques más antiguos
+
+	uint32_t inicio = bloqueRegistroGlucosa(0, &registro)->instante;
+	int i = 0;
+	while (instantes[i] < inicio)
+		i++;
+	return i;
+}
+
+
+static void compruebaRecorrido(int primera) {
+	IteradorRegistro it;
+	MuestraRegistro m;
+	int i = primera;
+	buscaRegistroGlucosa(0, &registro, &it);
+	while (siguienteRegistroGlucosa(&it, &m)) {
+		if (i >= NUM_MEDICIONES || m.instante != instantes[i] || m.valor != valores[i]) {
+			printf("Recorrido: medición %d distinta\n", i);
+			errores++;
+			return;
+		}
+		i++;
+	}
+	if (i != NUM_MEDICIONES || it.bloquesErroneos != 0) {
+		printf("Recorrido: %d mediciones de %d, %u bloques erróneos\n", i - primera, NUM_MEDICIONES - primera,
+			it.bloquesErroneos);
+		errores++;
+	}
+}
+
+
+static void compruebaBusquedas(int primera) {
+	uint32_t desde = instantes[primera], hasta = instantes[NUM_MEDICIONES - 1];
+	for (int n = 0; n < NUM_BUSQUEDAS; n++) {
+		uint32_t instante = desde - 10 + rand() % (hasta - desde + 20);
+		int i = primera;
+		while (i < NUM_MEDICIONES && instantes[i] < instante)  // La primera desde el instante
+			i++;
+
+		IteradorRegistro it;
+		MuestraRegistro m;
+		int hay = buscaRegistroGlucosa(instante, &registro, &it);
+		if (hay != (i < NUM_MEDICIONES)) {
+			printf("Búsqueda de %u: %s mediciones\n", instante, hay ? "sobran" : "faltan");
+			errores++;
+			continue;
+		}
+		for (int j = 0; j < 100 && i < NUM_MEDICIONES; j++, i++)  // Y las siguientes
+			if (!siguienteRegistroGlucosa(&it, &m) || m.instante != instantes[i] || m.valor != valores[i]) {
+				printf("Búsqueda de %u: medición %d distinta\n", instante, i);
+				errores++;
+				break;
+			}
+	}
+}
+
+
+static uint32_t bytesVarint(int diferencia) {
+	uint32_t zigzag = ((uint32_t) diferencia << 1) ^ (uint32_t) (diferencia >> 31);
+	uint32_t n = 1;
+	for (; zigzag >= 0x80; zigzag >>= 7)
+		n++;
+	return n;
+}
+
+
+static uint32_t bytesConRelleno(int primera, int i, int valor) {
+// Bytes que ocuparían las diferencias del bloque de la medición 'i' con 'valor' en su lugar
+
+	const BloqueRegistro * b = NULL;
+	for (uint32_t k = 0; k < numBloquesRegistroGlucosa(&registro); k++) {
+		b = bloqueRegistroGlucosa(k, &registro);
+		if (b->instante <= instantes[i] && instantes[i] < b->instante + b->numMuestras)
+			break;
+	}
+	int j = primera;
+	while (instantes[j] != b->instante)
+		j++;
+	uint32_t bytes = 0;
+	for (int k = j + 1; k < j + b->numMuestras; k++)
+		bytes += bytesVarint((k == i ? valor : valores[k]) - (k - 1 == i ? valor : valores[k - 1]));
+	return bytes;
+}
+
+
+static void compruebaRellenos(int primera, int hasta) {
+// Rellena los huecos guardados con una medición cercana a la anterior y comprueba que no se puede rellenar
+// lo que no es un hueco ni lo que no está guardado
+
+	uint32_t rellenos = 0, sinSitio = 0;
+	for (int i = primera; i < hasta; i++) {
+		if (valores[i] != 0) {
+			if (rand() % 100 == 0 && rellenaRegistroGlucosa(instantes[i], 100, &registro)) {
+				printf("Relleno de %u: no era un hueco\n", instantes[i]);
+				errores++;
+			}
+			continue;
+		}
+		int valor = (i > 0 && valores[i - 1] != 0 ? valores[i - 1] : 100) + rand() % 7 - 3;
+		if (rellenaRegistroGlucosa(instantes[i], valor, &registro)) {
+			valores[i] = valor;
+			rellenos++;
+		} else {
+			sinSitio++;
+			if (bytesConRelleno(primera, i, valor) <= REGISTRO_BYTES_DATOS) {  // Sólo si ya no cabe en el bloque
+				printf("Relleno de %u: no lo acepta y cabía\n", instantes[i]);
+				errores++;
+			}
+		}
+	}
+	if (rellenos == 0) {
+		printf("Relleno: no ha rellenado ningún hueco\n");
+		errores++;
+	}
+	if (rellenaRegistroGlucosa(instantes[primera] - 1, 100, &registro) ||
+			rellenaRegistroGlucosa(instantes[hasta - 1] + 1, 100, &registro)) {
+		printf("Relleno: acepta instantes no guardados\n");
+		errores++;
+	}
+	printf("%u huecos rellenados, %u sin sitio en su bloque\n", rellenos, sinSitio);
+}
+
+
+static void compruebaEstropeados(int primera) {
+// Estropea un byte de varios bloques cerrados y comprueba que el recorrido salta justo esos bloques
+
+	uint32_t numBloques = numBloquesRegistroGlucosa(&registro);
+	static uint8_t estropeado[REGISTRO_BLOQUES];
+	static uint8_t numMuestras[REGISTRO_BLOQUES];  // Antes de estropear las cabeceras
+	for (uint32_t b = 0; b < numBloques; b++)
+		numMuestras[b] = bloqueRegistroGlucosa(b, &registro)->numMuestras;
+	uint32_t numEstropeados = 0;
+	for (int n = 0; n < NUM_ESTROPEADOS; n++) {
+		uint32_t indice = rand() % (numBloques - 1);  // El último aún no tiene CRC
+		if (estropeado[indice])
+			continue;
+		uint8_t * bytes = (uint8_t *) bloqueRegistroGlucosa(indice, &registro);
+		bytes[rand() % (REGISTRO_BLOQUE_BYTES - 4)] ^= 1 << rand() % 8;
+		estropeado[indice] = 1;
+		numEstropeados++;
+	}
+
+	IteradorRegistro it;
+	MuestraRegistro m;
+	int i = primera;
+	buscaRegistroGlucosa(0, &registro, &it);
+	for (uint32_t b = 0; b < numBloques; b++) {
+		if (estropeado[b]) {
+			i += numMuestras[b];
+			continue;
+		}
+		for (int j = 0; j < numMuestras[b]; j++, i++)
+			if (!siguienteRegistroGlucosa(&it, &m) || m.instante != instantes[i] || m.valor != valores[i]) {
+				printf("Bloques estropeados: medición %d distinta\n", i);
+				errores++;
+				return;
+			}
+	}
+	if (siguienteRegistroGlucosa(&it, &m) || it.bloquesErroneos != numEstropeados) {
+		printf("Bloques estropeados: %u saltados de %u\n", it.bloquesErroneos, numEstropeados);
+		errores++;
+	}
+}
+
+
+int main(void) {
+	srand(1);
+	generaMediciones();
+	if (!inicializaRegistroGlucosa(1, &registro)) {
+		printf("Sin SDRAM para el registro\n");
+		return 1;
+	}
+
+	double inicio = segundos();
+	for (int i = 0; i < NUM_MEDICIONES - NUM_FINALES; i++)
+		anadeRegistroGlucosa(instantes[i], valores[i], &registro);
+	double codificacion = segundos() - inicio;
+
+	compruebaRellenos(primeraGuardada(), NUM_MEDICIONES - NUM_FINALES);
+	for (int i = NUM_MEDICIONES - NUM_FINALES; i < NUM_MEDICIONES; i++)
+		anadeRegistroGlucosa(instantes[i], valores[i], &registro);
+	int primera = primeraGuardada();
+	uint32_t guardadas = NUM_MEDICIONES - primera;
+	inicio = segundos();
+	IteradorRegistro it;
+	MuestraRegistro m;
+	uint32_t leidas = 0;
+	buscaRegistroGlucosa(0, &registro, &it);
+	while (siguienteRegistroGlucosa(&it, &m))
+		leidas++;
+	double decodificacion = segundos() - inicio;
+
+	compruebaRecorrido(primera);
+	compruebaBusquedas(primera);
+	compruebaEstropeados(primera);
+
+	printf("%u mediciones en %u bloques, %.2f bytes por medición\n", guardadas,
+		numBloquesRegistroGlucosa(&registro), (double) numBloquesRegistroGlucosa(&registro) *
+		REGISTRO_BLOQUE_BYTES / guardadas);
+	printf("Codificación: %.1f millones de mediciones/s\n", (NUM_MEDICIONES - NUM_FINALES) / codificacion / 1e6);
+	printf("Decodificación con CRC: %.1f millones de mediciones/s\n", leidas / decodificacion / 1e6);
+	printf("%d errores\n", errores);
+	return errores != 0;
+}
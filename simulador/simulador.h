@@ -0,0 +1,88 @@
+#ifndef SIMULADOR_H_
+#define SIMULADOR_H_
+
+#include <stdint.h>
+
+/**
+  * @file simulador.h
+  * @author EII
+  *
+  * @brief Control del simulador de la pantalla.
+  *
+  * El programa del simulador ejecuta en un PC las mismas tareas que la placa: tareaPantalla(), que dibuja
+  * la interfaz, y las de sensor, control, registro y pantalla táctil, sobre una versión de CMSIS-RTOS2 con
+  * hilos POSIX (ver cmsis_os.h). Termina tras un número de frames y guarda la última imagen mostrada.
+  *
+  * El guion táctil es un fichero de texto con un evento por línea, en orden de instante:
+  * @code
+  * # instante(ms) evento [x y]
+  * 1000 pulsa 40 100
+  * 1050 mueve 60 100
+  * 1200 suelta
+  * @endcode
+  *
+  * Uso: simulador [-f frames] [-s imagen.ppm] [-t guion.txt] [-e escala] [-b iteraciones] [-u destino].
+  * La escala acelera el tiempo: con -e 10 cada osDelay(50) dura 5 ms reales, aunque los ticks avanzan 50.
+  * Con -b no se ejecuta la aplicación, sino las medidas de rendimiento.h, y se escriben en CSV por la
+  * salida estándar. Con -u lo que se envía por USART1 (ver telemetria.h) se escribe en un fichero o, si
+  * el destino es "pty", en un pseudoterminal cuyo nombre se muestra al arrancar.
+  */
+
+
+/**
+ * @brief Fija el estado de la pantalla táctil que leerá LCD_actualizaPulsacion()
+ */
+void simuladorSetPulsacion(int pulsando, uint16_t x, uint16_t y);
+
+
+/**
+ * @brief Termina el programa tras mostrar el frame indicado
+ *
+ * @param numFrames Número de intercambios de buffers, 0 para no terminar nunca
+ * @param fichero Fichero PPM donde se guarda la última imagen mostrada, o NULL
+ */
+void simuladorSetFinal(uint32_t numFrames, const char * fichero);
+
+
+/**
+ * @brief Número de intercambios de buffers realizados
+ */
+uint32_t simuladorNumFrames(void);
+
+
+/**
+ * @brief Número de puntos escritos por las funciones de dibujo de pantallaLCD desde el arranque
+ *
+ * No incluye los que escriben directamente frameLCD, fondoLCD y dma2dLCD, ver LCD_puntosDMA2D().
+ */
+uint32_t simuladorPuntosEscritos(void);
+
+
+/**
+ * @brief Guarda en un fichero PPM la imagen que se está mostrando, según la orientación de la pantalla
+ *
+ * @return Buleano cierto si se pudo guardar
+ */
+int simuladorGuardaPantalla(const char * fichero);
+
+
+/**
+ * @brief Abre el destino de lo que se envía por USART1
+ *
+ * @param destino Nombre de un fichero, o "pty" para crear un pseudoterminal en modo binario
+ * @return Buleano cierto si se pudo abrir
+ */
+int simuladorAbreUART(const char * destino);
+
+
+/**
+ * @brief Escribe bytes enviados por USART1 en el destino abierto, sin esperar
+ *
+ * Sin destino abierto, o si el receptor no los admite, se descartan.
+ *
+ * @return Buleano cierto si se escribieron todos, o si no hay destino abierto
+ */
+int simuladorTransmiteUART(const uint8_t * datos, uint32_t bytes);
+
+
+#endif /* SIMULADOR_H_ */
@@ -0,0 +1,46 @@
+#define _XOPEN_SOURCE 600  // posix_openpt()
+#define _DEFAULT_SOURCE  // cfmakeraw()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "simulador.h"
+
+
+static int descriptor = -1;  // Destino de lo que se envía por USART1, -1 si se descarta
+static int esclavo = -1;  // Lado del pseudoterminal que lee el receptor, abierto para fijar el modo binario
+
+
+static int abrePseudoterminal(void) {
+	descriptor = posix_openpt(O_RDWR | O_NOCTTY);
+	if (descriptor < 0 || grantpt(descriptor) != 0 || unlockpt(descriptor) != 0)
+		return 0;
+	const char * nombre = ptsname(descriptor);
+	esclavo = open(nombre, O_RDWR | O_NOCTTY);
+	if (esclavo < 0)
+		return 0;
+
+	struct termios modo;  // Sin conversiones de fin de línea ni caracteres especiales
+	tcgetattr(esclavo, &modo);
+	cfmakeraw(&modo);
+	tcsetattr(esclavo, TCSANOW, &modo);
+	fcntl(descriptor, F_SETFL, O_NONBLOCK);
+	fprintf(stderr, "USART1 en %s\n", nombre);
+	return 1;
+}
+
+
+int simuladorAbreUART(const char * destino) {
+	if (strcmp(destino, "pty") == 0)
+		return abrePseudoterminal();
+	descriptor = open(destino, O_WRONLY | O_CREAT | O_TRUNC | O_NONBLOCK, 0644);
+	return descriptor >= 0;
+}
+
+
+int simuladorTransmiteUART(const uint8_t * datos, uint32_t bytes) {
+	// Con el receptor lento o desconectado se pierden, como en la línea serie
+	return descriptor < 0 || write(descriptor, datos, bytes) == (ssize_t) bytes;
+}
@@ -0,0 +1,152 @@
+#include "sincroniaLCD.h"
+#include "cmsis_os.h"
+#include "frameLCD.h"
+
+#ifndef LCD_SIMULADOR
+#include "main.h"
+
+extern LTDC_HandleTypeDef hltdc;  // Inicializado en main.c
+#endif
+
+
+static osSemaphoreId_t semaforoBorrado;  // Lo libera la interrupción de línea del LTDC
+static uint8_t frecuencia = 20;
+static uint32_t siguiente;  // Instante en ticks en que empieza el siguiente periodo
+
+static osSemaphoreId_t semaforoDespertar;  // Lo libera LCD_despiertaPantalla()
+static volatile uint8_t motivos = 0;  // Motivos de actividad fijados, LCD_MotivoActividad
+static volatile uint32_t finActividad;  // Instante en ticks hasta el que sigue activa tras una notificación
+static void (*funcionActividad)(int activa) = NULL;  // Avisa al entrar y salir del reposo
+static int enReposo = 0;  // Buleano cierto si el último frame se presentó sin actividad
+static uint32_t inicioReposo;  // Instante en ticks del primer frame sin actividad
+static int reposoAvisado = 0;  // Buleano cierto si se ha avisado a funcionActividad del reposo
+
+
+static void esperaBorrado(void) {
+// Bloquea hasta el comienzo del siguiente borrado vertical
+
+#ifdef LCD_SIMULADOR
+	uint32_t ahora = osKernelGetTickCount();
+	osDelayUntil((ahora / LCD_PERIODO_REFRESCO_SIMULADO + 1) * LCD_PERIODO_REFRESCO_SIMULADO);
+#else
+	osSemaphoreAcquire(semaforoBorrado, 0);  // Descarta un borrado anterior que nadie esperaba
+	HAL_LTDC_ProgramLineEvent(&hltdc, hltdc.Init.AccumulatedActiveH + 1);  // Primera línea sin imagen
+	osSemaphoreAcquire(semaforoBorrado, LCD_ESPERA_MAXIMA_BORRADO);
+#endif
+}
+
+
+static uint32_t ticks(uint32_t ms) {
+	return ms * osKernelGetTickFreq() / 1000;
+}
+
+
+static int recargaPendiente(void) {
+// Buleano cierto si el LTDC aún no ha cargado la dirección del nuevo buffer visible
+
+#ifdef LCD_SIMULADOR
+	return 0;
+#else
+	return (hltdc.Instance->SRCR & (LTDC_SRCR_VBR | LTDC_SRCR_IMR)) != 0;
+#endif
+}
+
+
+void LCD_inicializaSincronia(uint8_t frecuenciaFrames) {
+	semaforoBorrado = osSemaphoreNew(1, 0, NULL);
+	semaforoDespertar = osSemaphoreNew(1, 0, NULL);
+	LCD_setFrecuenciaFrames(frecuenciaFrames);
+	siguiente = osKernelGetTickCount();
+	LCD_notificaActividad();  // Activa al arrancar, para mostrar la pantalla completa
+}
+
+
+void LCD_setFrecuenciaFrames(uint8_t frecuenciaFrames) {
+	frecuencia = frecuenciaFrames > 0 ? frecuenciaFrames : 1;
+}
+
+
+uint8_t LCD_frecuenciaFrames(void) {
+	return frecuencia;
+}
+
+
+void LCD_setActividad(LCD_MotivoActividad motivo, int activa) {
+	if (activa)
+		motivos |= motivo;
+	else motivos &= ~motivo;
+}
+
+
+void LCD_notificaActividad(void) {
+	finActividad = osKernelGetTickCount() + ticks(LCD_TIEMPO_ACTIVIDAD);
+}
+
+
+int LCD_pantallaActiva(void) {
+	return motivos != 0 || (int32_t) (finActividad - osKernelGetTickCount()) > 0;
+}
+
+
+void LCD_setFuncionActividad(void (*funcion)(int activa)) {
+	funcionActividad = funcion;
+}
+
+
+void LCD_despiertaPantalla(void) {
+	if (semaforoDespertar != NULL)
+		osSemaphoreRelease(semaforoDespertar);  // Si ya estaba liberado, el siguiente frame no espera
+}
+
+
+int LCD_presentaFrame(void) {
+	int cambios = LCD_hayCambiosBufferOculto();  // Se descartan al intercambiar
+	if (cambios) {
+		esperaBorrado();
+		LCD_intercambiaBuffersRegiones();
+		if (recargaPendiente())
+			esperaBorrado();  // El cambio de buffer se hace efectivo en este borrado vertical
+	}
+
+	if (!LCD_pantallaActiva()) {
+		// Sin actividad: la tarea se bloquea y la tarea inactiva detiene la CPU hasta que la despierten. Sólo
+		// se avisa del reposo cuando dura LCD_REPOSO_MINIMO ms, y la espera no se pasa de ese instante
+		uint32_t ahora = osKernelGetTickCount(), espera = ticks(LCD_ESPERA_INACTIVA);
+		if (!enReposo) {
+			enReposo = 1;
+			inicioReposo = ahora;
+		}
+		if (!reposoAvisado) {
+			uint32_t transcurrido = ahora - inicioReposo;
+			if (transcurrido >= ticks(LCD_REPOSO_MINIMO)) {
+				reposoAvisado = 1;
+				if (funcionActividad != NULL)
+					funcionActividad(0);
+			} else if (ticks(LCD_REPOSO_MINIMO) - transcurrido < espera)
+				espera = ticks(LCD_REPOSO_MINIMO) - transcurrido;
+		}
+		osSemaphoreAcquire(semaforoDespertar, espera);
+		siguiente = osKernelGetTickCount();
+		return cambios;
+	}
+	enReposo = 0;
+	if (reposoAvisado) {
+		reposoAvisado = 0;
+		if (funcionActividad != NULL)
+			funcionActividad(1);
+	}
+
+	uint8_t frecuenciaPeriodo = cambios || frecuencia < LCD_FRECUENCIA_REPOSO ? frecuencia : LCD_FRECUENCIA_REPOSO;
+	siguiente += osKernelGetTickFreq() / frecuenciaPeriodo;
+	uint32_t ahora = osKernelGetTickCount();
+	if ((int32_t) (siguiente - ahora) < 0)
+		siguiente = ahora;  // Frame más largo que el periodo: no se intenta recuperar el retraso
+	else osDelayUntil(siguiente);
+	return cambios;
+}
+
+
+void LCD_interrupcionLineaLTDC(void) {
+	if (semaforoBorrado != NULL)
+		osSemaphoreRelease(semaforoBorrado);
+}
@@ -0,0 +1,182 @@
+#ifndef SINCRONIALCD_H_
+#define SINCRONIALCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file sincroniaLCD.h
+  * @author EII
+  *
+  * @brief Presentación de los frames sincronizada con el barrido del panel y a una frecuencia fija.
+  *
+  * Si los buffers se intercambian mientras el LTDC está leyendo el frame buffer, la pantalla muestra
+  * durante un refresco la parte de arriba de un frame y la de abajo del otro. Además, esperar un tiempo
+  * fijo después de cada frame hace que la frecuencia dependa de lo que se tarde en dibujar.
+  *
+  * LCD_presentaFrame() sustituye a LCD_intercambiaBuffersRegiones() seguido de osDelay() en el bucle de la
+  * tarea que dibuja la pantalla:
+  *
+  * - Bloquea la tarea en un semáforo hasta que el LTDC termina de leer la última línea visible. Lo libera
+  *   la interrupción de línea del LTDC, programada en la primera línea del borrado vertical. Entonces
+  *   intercambia los buffers y, si el cambio de dirección del LTDC queda pendiente de la recarga en el
+  *   borrado vertical, espera también a que se haga efectivo antes de dejar dibujar en el otro buffer.
+  * - Después espera hasta el siguiente periodo de la frecuencia de frames, contado desde el anterior y no
+  *   desde que termina el frame, con osDelayUntil().
+  * - Si en el frame no se ha redibujado nada (no hay regiones inválidas en el buffer oculto ni se ha
+  *   llamado a LCD_marcaBufferModificado(), ver frameLCD.h), no intercambia los buffers y espera con la frecuencia de reposo,
+  *   LCD_FRECUENCIA_REPOSO, hasta que vuelva a cambiar algo.
+  *
+  * Además, la frecuencia se adapta a la actividad para ahorrar batería entre mediciones:
+  *
+  * - La pantalla está activa mientras hay algún motivo fijado con LCD_setActividad(), como una alarma o
+  *   una animación, y durante LCD_TIEMPO_ACTIVIDAD ms desde la última llamada a LCD_notificaActividad(),
+  *   que hace LCD_atiendeEventosTactiles() con cada evento y mientras se mantiene una pulsación. Entonces
+  *   los frames siguen la frecuencia establecida.
+  * - Si no, tras presentar el frame la tarea queda bloqueada hasta que alguien llama a
+  *   LCD_despiertaPantalla(), como la tarea táctil (ver tactilLCD.h) al detectar una pulsación o la
+  *   aplicación al recibir una medición nueva, o como mucho LCD_ESPERA_INACTIVA ms. Con todas las tareas
+  *   bloqueadas, FreeRTOS ejecuta la tarea inactiva, que detiene la CPU con WFI hasta la siguiente
+  *   interrupción: el tick de FreeRTOS o TP_INT1.
+  *
+  * Hay que llamar a LCD_interrupcionLineaLTDC() desde HAL_LTDC_LineEventCallback(). En el simulador
+  * (LCD_SIMULADOR) no hay LTDC y el borrado vertical se simula cada LCD_PERIODO_REFRESCO_SIMULADO ticks.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * LCD_inicializaSincronia(30);
+  * LCD_inicializaTactil();  // Despierta a la pantalla con cada pulsación
+  * while(1) {
+  *     LCD_setActividad(LCD_ACTIVIDAD_ALARMA, alarma);
+  *     LCD_atiendeEscena(&escena);
+  *     LCD_presentaFrame();  // 30 frames por segundo, o ninguno si no hay actividad, sin cortes en la imagen
+  * }
+  * @endcode
+  */
+
+
+/** @brief Frecuencia en Hz a la que se baja cuando un frame no redibuja nada */
+#ifndef LCD_FRECUENCIA_REPOSO
+#define LCD_FRECUENCIA_REPOSO 10
+#endif
+
+/** @brief Tiempo en ms que la pantalla sigue activa tras la última llamada a LCD_notificaActividad() */
+#ifndef LCD_TIEMPO_ACTIVIDAD
+#define LCD_TIEMPO_ACTIVIDAD 3000
+#endif
+
+/** @brief Tiempo máximo en ms entre frames cuando la pantalla está inactiva */
+#ifndef LCD_ESPERA_INACTIVA
+#define LCD_ESPERA_INACTIVA 10000
+#endif
+
+/** @brief Tiempo en ms que la pantalla tiene que seguir inactiva para avisar a la función de actividad */
+#ifndef LCD_REPOSO_MINIMO
+#define LCD_REPOSO_MINIMO 5000
+#endif
+
+/** @brief Tiempo máximo en ms que se espera al borrado vertical, por si el LTDC está parado */
+#ifndef LCD_ESPERA_MAXIMA_BORRADO
+#define LCD_ESPERA_MAXIMA_BORRADO 50
+#endif
+
+/** @brief Periodo del borrado vertical simulado, en ticks */
+#ifndef LCD_PERIODO_REFRESCO_SIMULADO
+#define LCD_PERIODO_REFRESCO_SIMULADO 16
+#endif
+
+
+/**
+ * @brief Motivos que mantienen activa la pantalla
+ */
+typedef enum {
+    /** @brief Hay una alarma en pantalla */
+    LCD_ACTIVIDAD_ALARMA = 1,
+    /** @brief Hay una animación en curso */
+    LCD_ACTIVIDAD_ANIMACION = 2} LCD_MotivoActividad;
+
+
+/**
+ * @brief Crea el semáforo del borrado vertical y fija la frecuencia de frames
+ *
+ * @param frecuencia Número de frames por segundo, por ejemplo 1, 10, 30 o 60. Como mucho la frecuencia de
+ *     refresco del panel
+ */
+void LCD_inicializaSincronia(uint8_t frecuencia);
+
+
+/**
+ * @brief Cambia la frecuencia de frames
+ *
+ * @param frecuencia Número de frames por segundo
+ */
+void LCD_setFrecuenciaFrames(uint8_t frecuencia);
+
+
+/**
+ * @brief Frecuencia de frames establecida
+ */
+uint8_t LCD_frecuenciaFrames(void);
+
+
+/**
+ * @brief Fija o quita un motivo para mantener la pantalla activa
+ *
+ * @param motivo Motivo de actividad
+ * @param activa Buleano cierto mientras dure el motivo
+ */
+void LCD_setActividad(LCD_MotivoActividad motivo, int activa);
+
+
+/**
+ * @brief Mantiene la pantalla activa durante LCD_TIEMPO_ACTIVIDAD ms a partir de ahora
+ */
+void LCD_notificaActividad(void);
+
+
+/**
+ * @brief Indica si la pantalla está activa
+ */
+int LCD_pantallaActiva(void);
+
+
+/**
+ * @brief Indica una función a la que se avisa cuando la pantalla deja de estar activa y cuando vuelve
+ *
+ * Sirve para bajar el reloj mientras la pantalla está inactiva (ver energia.h). La función se llama desde
+ * LCD_presentaFrame() con un buleano falso cuando la pantalla lleva LCD_REPOSO_MINIMO ms inactiva, y con
+ * uno cierto en el primer frame en que vuelve a estar activa. Los frames que presenta la pantalla inactiva
+ * al despertarla con LCD_despiertaPantalla(), por ejemplo con cada medición, no cambian nada.
+ *
+ * @param funcion Función que recibe un buleano cierto al volver a la actividad, o NULL
+ */
+void LCD_setFuncionActividad(void (*funcion)(int activa));
+
+
+/**
+ * @brief Hace que la pantalla inactiva presente un frame nuevo sin esperar a LCD_ESPERA_INACTIVA
+ *
+ * Se puede llamar desde otra tarea o desde una interrupción.
+ */
+void LCD_despiertaPantalla(void);
+
+
+/**
+ * @brief Muestra el frame dibujado en el borrado vertical y espera al siguiente frame
+ *
+ * Se llama al terminar de dibujar cada frame, en lugar de LCD_intercambiaBuffersRegiones(). Si la pantalla
+ * está inactiva espera a LCD_despiertaPantalla() en lugar de al siguiente periodo.
+ *
+ * @return Buleano cierto si se intercambiaron los buffers, falso si el frame no tenía cambios
+ */
+int LCD_presentaFrame(void);
+
+
+/**
+ * @brief Libera a la tarea que espera al borrado vertical
+ *
+ * Se llama desde la interrupción de línea del LTDC.
+ */
+void LCD_interrupcionLineaLTDC(void);
+
+
+#endif /* SINCRONIALCD_H_ */
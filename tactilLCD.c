@@ -0,0 +1,148 @@
+#include "tactilLCD.h"
+#include "cmsis_os.h"
+#include "pantallaLCD.h"
+#include "indiceTactilLCD.h"
+#include "sincroniaLCD.h"
+#include "perfilado.h"
+
+
+static osMessageQueueId_t colaEventos;  // Eventos pendientes de consumir por la tarea de la pantalla
+static osSemaphoreId_t semaforoInterrupcion;  // Lo libera la interrupción TP_INT1
+static int eventosActivos = 0;  // Buleano cierto si se llamó a LCD_inicializaTactil()
+
+static int pulsando;  // Estado táctil del frame actual
+static uint16_t xPulsacion, yPulsacion;
+
+typedef struct {
+	int pulsando;
+	uint16_t x, y;  // Último punto pulsado
+} Seguimiento;  // Última lectura del controlador, para obtener los eventos de la siguiente
+
+static const osThreadAttr_t tareaTactil_attributes = {
+  .name = "tactil",
+  .stack_size = 256 * 4,
+  .priority = (osPriority_t) osPriorityAboveNormal,
+};
+
+
+static int leeEvento(Seguimiento * pSeguimiento, LCD_EventoTactil * evento) {
+// Lee el controlador y compara con la lectura anterior. Devuelve cierto si hay un evento
+
+	LCD_actualizaPulsacion();  // Única lectura del controlador por I2C
+	int pulsa = LCD_pulsando();
+	uint16_t x = LCD_xPulsacion(), y = LCD_yPulsacion();
+	int hayEvento = 1;
+
+	if (pulsa && !pSeguimiento->pulsando)
+		*evento = (LCD_EventoTactil) {LCD_TACTIL_PULSA, x, y, osKernelGetTickCount()};
+	else if (pulsa && (x != pSeguimiento->x || y != pSeguimiento->y))
+		*evento = (LCD_EventoTactil) {LCD_TACTIL_MUEVE, x, y, osKernelGetTickCount()};
+	else if (!pulsa && pSeguimiento->pulsando)
+		*evento = (LCD_EventoTactil) {LCD_TACTIL_SUELTA, pSeguimiento->x, pSeguimiento->y,
+			osKernelGetTickCount()};
+	else hayEvento = 0;
+
+	pSeguimiento->pulsando = pulsa;
+	if (pulsa) {
+		pSeguimiento->x = x;
+		pSeguimiento->y = y;
+	}
+	return hayEvento;
+}
+
+
+static void tareaTactil(void * argumento) {
+	Seguimiento seguimiento = {0, 0, 0};
+
+	for (;;) {
+		if (seguimiento.pulsando)
+			osDelay(TACTIL_PERIODO_SEGUIMIENTO);  // Sigue al dedo mientras no se suelte
+		else osSemaphoreAcquire(semaforoInterrupcion, TACTIL_ESPERA_MAXIMA);  // Espera a TP_INT1
+
+		LCD_EventoTactil evento;
+		if (leeEvento(&seguimiento, &evento)) {
+			osMessageQueuePut(colaEventos, &evento, 0, 0);  // Si la cola está llena se descarta el evento
+			LCD_despiertaPantalla();  // La pantalla inactiva atiende el evento sin esperar
+		}
+	}
+}
+
+
+void LCD_inicializaTactil(void) {
+	colaEventos = osMessageQueueNew(TACTIL_TAMANO_COLA, sizeof(LCD_EventoTactil), NULL);
+	semaforoInterrupcion = osSemaphoreNew(1, 0, NULL);
+	osThreadNew(tareaTactil, NULL, &tareaTactil_attributes);
+	eventosActivos = 1;
+}
+
+
+void LCD_interrupcionTactil(void) {
+	if (eventosActivos)
+		osSemaphoreRelease(semaforoInterrupcion);
+}
+
+
+int LCD_leeEventoTactil(LCD_EventoTactil * evento, uint32_t espera) {
+	return eventosActivos && osMessageQueueGet(colaEventos, evento, NULL, espera) == osOK;
+}
+
+
+void LCD_atiendeEventosTactiles(void) {
+	PERFIL_INICIO(PERFIL_ZONA_ATIENDE_EVENTOS_TACTILES);
+	LCD_EventoTactil evento;
+	if (!eventosActivos) {
+		static Seguimiento seguimiento = {0, 0, 0};  // Lectura del frame anterior
+		if (leeEvento(&seguimiento, &evento) && LCD_indiceTactilActivo())
+			LCD_despachaEventoTactil(&evento);
+		PERFIL_FIN(PERFIL_ZONA_ATIENDE_EVENTOS_TACTILES);
+		return;
+	}
+	int pulsadaEnFrame = 0;  // Buleano cierto si empezó alguna pulsación desde el frame anterior
+	while (LCD_leeEventoTactil(&evento, 0)) {
+		if (LCD_indiceTactilActivo())
+			LCD_despachaEventoTactil(&evento);  // Cada evento llega al componente pulsado según se consume
+		switch (evento.tipo) {
+		case LCD_TACTIL_PULSA:
+			pulsadaEnFrame = 1;
+			pulsando = 1;
+			xPulsacion = evento.x;
+			yPulsacion = evento.y;
+			break;
+		case LCD_TACTIL_MUEVE:
+			xPulsacion = evento.x;
+			yPulsacion = evento.y;
+			break;
+		case LCD_TACTIL_SUELTA:
+			pulsando = 0;
+			break;
+		}
+	}
+	if (pulsadaEnFrame || pulsando)
+		LCD_notificaActividad();  // Frecuencia completa mientras se usa la pantalla, ver sincroniaLCD.h
+	if (pulsadaEnFrame && !pulsando)
+		pulsando = -1;  // Pulsación corta: activa durante este frame y se suelta en el siguiente
+	else if (pulsando < 0)
+		pulsando = 0;
+	PERFIL_FIN(PERFIL_ZONA_ATIENDE_EVENTOS_TACTILES);
+}
+
+
+int LCD_tactilPulsando(void) {
+	if (!eventosActivos)
+		return LCD_pulsando();
+	return pulsando != 0;
+}
+
+
+uint16_t LCD_tactilX(void) {
+	if (!eventosActivos)
+		return LCD_xPulsacion();
+	return xPulsacion;
+}
+
+
+uint16_t LCD_tactilY(void) {
+	if (!eventosActivos)
+		return LCD_yPulsacion();
+	return yPulsacion;
+}
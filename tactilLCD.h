@@ -0,0 +1,130 @@
+#ifndef TACTILLCD_H_
+#define TACTILLCD_H_
+
+#include <stdint.h>
+
+/**
+  * @file tactilLCD.h
+  * @author EII
+  *
+  * @brief Eventos de la pantalla táctil generados a partir de la interrupción TP_INT1.
+  *
+  * Una tarea dedicada espera bloqueada a que el controlador táctil active la línea TP_INT1. Entonces lee
+  * el controlador por I2C una sola vez por muestra y publica eventos de pulsación, movimiento y
+  * liberación, con su instante en ticks, en una cola. Mientras se mantiene la pulsación, sigue al dedo
+  * con un periodo fijo hasta que se suelta.
+  *
+  * La tarea que dibuja la pantalla consume la cola una vez por frame con LCD_atiendeEventosTactiles() y
+  * los componentes de interfazLCD consultan el estado resultante con LCD_tactilPulsando(), LCD_tactilX() y
+  * LCD_tactilY(), sin acceder al controlador. Si no se llama a LCD_inicializaTactil(), esas funciones
+  * consultan directamente la biblioteca pantallaLCD como antes.
+  *
+  * Cada evento despierta a la pantalla si estaba inactiva y la mantiene activa mientras se usa (ver
+  * sincroniaLCD.h).
+  *
+  * Hay que llamar a LCD_interrupcionTactil() desde HAL_GPIO_EXTI_Callback() cuando se activa TP_INT1_Pin.
+  */
+
+
+/** @brief Periodo de muestreo en ms mientras se mantiene una pulsación */
+#ifndef TACTIL_PERIODO_SEGUIMIENTO
+#define TACTIL_PERIODO_SEGUIMIENTO 10
+#endif
+
+/** @brief Tiempo máximo en ms sin leer el controlador aunque no llegue la interrupción, por si se pierde
+ *     un flanco */
+#ifndef TACTIL_ESPERA_MAXIMA
+#define TACTIL_ESPERA_MAXIMA 500
+#endif
+
+/** @brief Número de eventos que caben en la cola */
+#ifndef TACTIL_TAMANO_COLA
+#define TACTIL_TAMANO_COLA 16
+#endif
+
+
+/**
+ * @brief Tipo de evento táctil
+ */
+typedef enum {
+    /** @brief Comienza una pulsación */
+    LCD_TACTIL_PULSA,
+    /** @brief El punto pulsado se ha movido */
+    LCD_TACTIL_MUEVE,
+    /** @brief Termina la pulsación */
+    LCD_TACTIL_SUELTA} LCD_TipoEventoTactil;
+
+
+/**
+ * @brief Evento de la pantalla táctil
+ */
+typedef struct {
+    /** @brief Tipo de evento */
+    LCD_TipoEventoTactil tipo;
+    /** @brief Coordenada X del punto pulsado */
+    uint16_t x;
+    /** @brief Coordenada Y del punto pulsado */
+    uint16_t y;
+    /** @brief Instante del evento, en ticks de FreeRTOS */
+    uint32_t instante;
+} LCD_EventoTactil;
+
+
+/**
+ * @brief Crea la cola de eventos y la tarea que atiende al controlador táctil
+ *
+ * Hay que llamarla después de inicializar la pantalla con LCD_inicializa2Buffers().
+ */
+void LCD_inicializaTactil(void);
+
+
+/**
+ * @brief Despierta a la tarea del controlador táctil
+ *
+ * Se llama desde la rutina de interrupción de la línea TP_INT1.
+ */
+void LCD_interrupcionTactil(void);
+
+
+/**
+ * @brief Extrae un evento de la cola
+ *
+ * @param evento Puntero donde se copia el evento
+ * @param espera Tiempo máximo de espera en ticks
+ * @return Buleano cierto si se obtuvo un evento
+ */
+int LCD_leeEventoTactil(LCD_EventoTactil * evento, uint32_t espera);
+
+
+/**
+ * @brief Consume los eventos pendientes y actualiza el estado táctil del frame
+ *
+ * Sustituye a LCD_actualizaPulsacion() en el bucle de la tarea que dibuja la pantalla. Una pulsación que
+ * empieza y termina entre dos frames se considera activa durante un frame para que no se pierda.
+ *
+ * Si se ha activado el índice de zonas táctiles (ver indiceTactilLCD.h), entrega además cada evento al
+ * componente pulsado. Sin la tarea táctil, los eventos se obtienen comparando con la lectura del frame
+ * anterior.
+ */
+void LCD_atiendeEventosTactiles(void);
+
+
+/**
+ * @brief Indica si se está pulsando la pantalla en el frame actual
+ */
+int LCD_tactilPulsando(void);
+
+
+/**
+ * @brief Coordenada X de la última pulsación
+ */
+uint16_t LCD_tactilX(void);
+
+
+/**
+ * @brief Coordenada Y de la última pulsación
+ */
+uint16_t LCD_tactilY(void);
+
+
+#endif /* TACTILLCD_H_ */
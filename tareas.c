@@ -0,0 +1,472 @@
+#include "tareas.h"
+#include <math.h>
+#include "cmsis_os.h"
+#include "pantallaLCD.h"
+#include "interfazLCD.h"
+#include "frameLCD.h"
+#include "fondoLCD.h"
+#include "dma2dLCD.h"
+#include "textoLCD.h"
+#include "formatoLCD.h"
+#include "tactilLCD.h"
+#include "indiceTactilLCD.h"
+#include "escenaLCD.h"
+#include "sincroniaLCD.h"
+#include "historialGlucosa.h"
+#include "energia.h"
+#include "estadisticasGlucosa.h"
+#include "registroGlucosa.h"
+#include "telemetria.h"
+#include "ingestaGlucosa.h"
+#include "JuegoAlpha15.h"
+#include "JuegoAlpha17.h"
+
+
+static IngestaGlucosa ingesta;  // Sensor -> control, sin bloqueos
+static osSemaphoreId_t lecturasPendientes;  // Despierta al control cuando el sensor publica
+static osMessageQueueId_t colaPantalla;  // Control -> pantalla
+static osMessageQueueId_t colaRegistro;  // Control -> registro
+static volatile uint32_t perdidos = 0;  // Mensajes descartados por colas llenas
+
+static EventoRegistro registro[REGISTRO_CAPACIDAD];  // Eventos guardados, en un buffer circular
+static uint32_t cabezaRegistro = 0;  // Posición donde se guardará el próximo evento
+static uint32_t numRegistro = 0;  // Número de eventos guardados
+static osMutexId_t mutexRegistro;
+static RegistroGlucosa registroLecturas;  // Lecturas comprimidas, en la SDRAM, con el periodo del transmisor
+
+static const osThreadAttr_t tareaSensor_attributes = {
+  .name = "sensor",
+  .stack_size = 256 * 4,
+  .priority = (osPriority_t) osPriorityHigh,
+};
+
+static const osThreadAttr_t tareaControl_attributes = {
+  .name = "control",
+  .stack_size = 512 * 4,
+  .priority = (osPriority_t) osPriorityAboveNormal1,
+};
+
+static const osThreadAttr_t tareaRegistro_attributes = {
+  .name = "registro",
+  .stack_size = 512 * 4,
+  .priority = (osPriority_t) osPriorityLow,
+};
+
+
+static void cuentaPerdido(void) {
+// Lo llaman el sensor y el control, que se expropian entre sí: con ++ se perderían cuentas
+
+	__atomic_fetch_add(&perdidos, 1, __ATOMIC_RELAXED);
+}
+
+
+static void envia(osMessageQueueId_t cola, const void * mensaje) {
+// Envía un mensaje sin bloquear a la tarea que envía. Si la cola está llena se descarta
+
+	if (osMessageQueuePut(cola, mensaje, 0, 0) != osOK)
+		cuentaPerdido();
+}
+
+
+static int leeSensor(uint32_t t) {
+// Medición simulada del sensor
+
+	return 80 + (int)(40 * sin(0.02 * t));
+}
+
+
+static void publica(const LecturaSensor * lectura) {
+// Publica una lectura en la entrada sin bloquear al sensor. Si la cola está llena se descarta
+
+	if (!publicaLecturaSensor(lectura, &ingesta)) {
+		cuentaPerdido();
+		return;
+	}
+	osSemaphoreRelease(lecturasPendientes);  // Si ya estaba liberado, el control aún no ha despertado
+}
+
+
+#ifdef LCD_SIMULADOR
+#define SENSOR_CICLO_PERDIDAS 60  // Cada tantos periodos el transmisor simulado pierde la conexión...
+#define SENSOR_PERIODOS_PERDIDOS 3  // ... durante tantos periodos al final del ciclo
+#define SENSOR_RETRASO_REENVIO 10  // Periodo del ciclo siguiente en que reenvía las perdidas
+
+
+static void publicaConPerdidas(const LecturaSensor * lectura) {
+// Retiene las lecturas de los periodos sin conexión y reenvía las de la pérdida anterior, salvo una de cada
+// cuatro veces que no las recupera
+
+	static LecturaSensor perdidas[SENSOR_PERIODOS_PERDIDOS];  // Las que el transmisor guarda para reenviarlas
+	uint32_t fase = lectura->numero % SENSOR_CICLO_PERDIDAS;
+	if (fase >= SENSOR_CICLO_PERDIDAS - SENSOR_PERIODOS_PERDIDOS)
+		perdidas[fase - (SENSOR_CICLO_PERDIDAS - SENSOR_PERIODOS_PERDIDOS)] = *lectura;
+	else publica(lectura);
+
+	uint32_t ciclo = lectura->numero / SENSOR_CICLO_PERDIDAS;
+	if (fase == SENSOR_RETRASO_REENVIO && ciclo % 4 != 0)
+		for (int i = 0; i < SENSOR_PERIODOS_PERDIDOS; i++)
+			publica(&perdidas[i]);
+}
+#endif
+
+
+static void tareaSensor(void * argumento) {
+	uint32_t numero = 0;
+	uint32_t siguiente = osKernelGetTickCount();
+	for(;;) {
+		LecturaSensor lectura = {osKernelGetTickCount(), numero, leeSensor(numero), CALIDAD_VALIDA,
+			FUENTE_SENSOR};
+#ifdef LCD_SIMULADOR
+		publicaConPerdidas(&lectura);
+#else
+		publica(&lectura);
+#endif
+		numero++;
+
+		siguiente += PERIODO_SENSOR;
+		osDelayUntil(siguiente);  // Periodo fijo, independiente de lo que tarde cada medición
+	}
+}
+
+
+static void controlaLectura(const LecturaSensor * lectura, int * alarma) {
+	EstadoControl estado = {lectura->instante, lectura->valor, *alarma, lectura->calidad, lectura->fuente,
+		lectura->numero};
+	EventoRegistro evento = {REGISTRO_LECTURA, lectura->instante, lectura->valor, lectura->numero};
+	if (lectura->fuente == FUENTE_REENVIO)
+		evento.tipo = REGISTRO_RECUPERADA;  // Ya pasada: sólo se anota
+	else if (lectura->calidad == CALIDAD_HUECO)
+		evento.tipo = REGISTRO_HUECO;  // Sin dato, la alarma sigue como estaba
+	else {
+		estado.alarma = lectura->valor < UMBRAL_HIPOGLUCEMIA;
+		// Las decisiones de dosificación se toman aquí, sin esperar nunca a la pantalla
+	}
+
+	envia(colaRegistro, &evento);
+	if (estado.alarma != *alarma) {
+		evento.tipo = estado.alarma ? REGISTRO_ALARMA_ACTIVA : REGISTRO_ALARMA_FIN;
+		envia(colaRegistro, &evento);
+	}
+	*alarma = estado.alarma;
+
+	envia(colaPantalla, &estado);
+}
+
+
+static void tareaControl(void * argumento) {
+	int alarma = 0;
+	uint32_t margen = MARGEN_SENSOR * osKernelGetTickFreq() / 1000;
+	for(;;) {
+		// Espera a la siguiente lectura como mucho hasta su instante previsto más el margen
+		uint32_t instante, espera = osWaitForever;
+		if (instanteSiguienteIngesta(&instante, &ingesta)) {
+			int32_t resto = instante + margen - osKernelGetTickCount();
+			espera = resto > 0 ? resto : 0;
+		}
+		LecturaSensor lectura;
+		if (osSemaphoreAcquire(lecturasPendientes, espera) != osOK && huecoIngesta(&lectura, &ingesta))
+			controlaLectura(&lectura, &alarma);  // No ha llegado: su periodo es un hueco desde ya
+
+		// Todo lo publicado desde la última vez, con los huecos que no se detectaron a tiempo delante de la
+		// lectura que los descubre
+		while (siguienteLecturaIngesta(&lectura, &ingesta))
+			controlaLectura(&lectura, &alarma);
+		LCD_despiertaPantalla();  // Un frame por medición o hueco aunque la pantalla esté inactiva
+	}
+}
+
+
+static void tareaRegistro(void * argumento) {
+	for(;;) {
+		EventoRegistro evento;
+		if (osMessageQueueGet(colaRegistro, &evento, NULL, osWaitForever) != osOK)
+			continue;
+
+		osMutexAcquire(mutexRegistro, osWaitForever);
+		if (evento.tipo == REGISTRO_LECTURA || evento.tipo == REGISTRO_HUECO)
+			anadeRegistroGlucosa(evento.numero, evento.valor, &registroLecturas);  // Los huecos, con valor 0
+		else if (evento.tipo == REGISTRO_RECUPERADA)
+			rellenaRegistroGlucosa(evento.numero, evento.valor, &registroLecturas);
+		registro[cabezaRegistro] = evento;
+		if (++cabezaRegistro == REGISTRO_CAPACIDAD)
+			cabezaRegistro = 0;
+		if (numRegistro < REGISTRO_CAPACIDAD)
+			numRegistro++;
+		osMutexRelease(mutexRegistro);
+
+		// Telemetría desde aquí y no desde el control: copiar las tramas no le quita tiempo a su plazo
+		if (evento.tipo == REGISTRO_LECTURA || evento.tipo == REGISTRO_RECUPERADA)
+			enviaLecturaTelemetria(evento.instante, evento.valor);
+		else if (evento.tipo != REGISTRO_HUECO)
+			enviaAlarmaTelemetria(evento.instante, evento.valor, evento.tipo == REGISTRO_ALARMA_ACTIVA);
+		enviaPerfiladoTelemetria();
+	}
+}
+
+
+void inicializaTareas(void) {
+	inicializaIngesta(PERIODO_SENSOR * osKernelGetTickFreq() / 1000, &ingesta);
+	lecturasPendientes = osSemaphoreNew(1, 0, NULL);
+	colaPantalla = osMessageQueueNew(TAMANO_COLA_PANTALLA, sizeof(EstadoControl), NULL);
+	colaRegistro = osMessageQueueNew(TAMANO_COLA_REGISTRO, sizeof(EventoRegistro), NULL);
+	mutexRegistro = osMutexNew(NULL);
+	inicializaRegistroGlucosa(1, &registroLecturas);
+
+	osThreadNew(tareaSensor, NULL, &tareaSensor_attributes);
+	osThreadNew(tareaControl, NULL, &tareaControl_attributes);
+	osThreadNew(tareaRegistro, NULL, &tareaRegistro_attributes);
+}
+
+
+uint32_t mensajesPerdidos(void) {
+	return perdidos;
+}
+
+
+int leeRegistro(uint32_t indice, EventoRegistro * evento) {
+	osMutexAcquire(mutexRegistro, osWaitForever);
+	int existe = indice < numRegistro;
+	if (existe)
+		*evento = registro[(cabezaRegistro + REGISTRO_CAPACIDAD - 1 - indice) % REGISTRO_CAPACIDAD];
+	osMutexRelease(mutexRegistro);
+	return existe;
+}
+
+
+uint32_t leeLecturasRegistradas(uint32_t desde, uint32_t maximo, MuestraRegistro * muestras) {
+	IteradorRegistro it;
+	uint32_t n = 0;
+	osMutexAcquire(mutexRegistro, osWaitForever);
+	if (buscaRegistroGlucosa(desde, &registroLecturas, &it))
+		while (n < maximo && siguienteRegistroGlucosa(&it, &muestras[n]))
+			n++;
+	osMutexRelease(mutexRegistro);
+	return n;
+}
+
+
+static void atiendeCabecera(void * datos) {
+	PantallaGlucosa * pPantalla = datos;
+	char nivelTexto[20];
+
+	if (LCD_intersectaRegionInvalida(0, 0, 320, 30)) {
+		// Las dos cadenas se mezclan desde la caché de texto; el valor sólo falla cuando cambia
+		LCD_dibujaCadenaCaracteresAlphaCache(10, 10, "Nivel Glucosa ", 0x00000000, 2, &juegoAlpha17, 0, 100);
+
+		if (pPantalla->nivelActual != 0)
+			LCD_formateaTexto(" mg/dL", LCD_formateaEntero(pPantalla->nivelActual, nivelTexto));
+		else LCD_formateaTexto("--- mg/dL", nivelTexto);  // Sin lectura en el último periodo
+		LCD_dibujaCadenaCaracteresAlphaCache(200, 10, nivelTexto, 0x00000000, 2, &juegoAlpha17, 0, 100);
+	}
+}
+
+
+static void atiendeAviso(void * datos) {
+	LCD_dibujaRectanguloRellenoDMA2D(45, 35, 230, 25, 0xFFFF0000, 0, 100);
+	LCD_dibujaCadenaCaracteresAlphaCache(50, 40, "Nivel bajo de glucosa!", 0xFFFFFFFF, 2, &juegoAlpha17, 0, 100);
+}
+
+
+static void atiendeGrafica(void * datos) {
+	dibujaGraficaDesplazando(&((PantallaGlucosa *) datos)->historial);
+}
+
+
+static char * formateaPorcentaje(const char * titulo, int32_t porcentaje, char * destino) {
+	return LCD_formateaTexto("%", LCD_formateaFijo(porcentaje, 1, LCD_formateaTexto(titulo, destino)));
+}
+
+
+static void escribeEstadisticas(PantallaGlucosa * pPantalla) {
+	// Las etiquetas sólo invalidan su zona cuando cambia el texto, ver LCD_setTextoEtiqueta()
+	static const char * const titulos[ESTADISTICAS_NUM_VENTANAS] = {"24 horas: ", "7 dias: ", "14 dias: "};
+	ValoresEstadisticas v;
+	char texto[FILAS_ESTADISTICAS][60];
+	calculaEstadisticas(pPantalla->ventanaMostrada, &pPantalla->estadisticas, &v);
+
+	LCD_formateaTexto(" lecturas", LCD_formateaNatural(v.numMuestras,
+		LCD_formateaTexto(titulos[pPantalla->ventanaMostrada], texto[0])));
+	formateaPorcentaje("En rango 70-180: ", v.porcentajeRango[RANGO_GLUCOSA_OBJETIVO], texto[1]);
+	formateaPorcentaje("   <54: ", v.porcentajeRango[RANGO_GLUCOSA_MUY_BAJO],
+		formateaPorcentaje("Bajo <70: ", v.porcentajeRango[RANGO_GLUCOSA_BAJO], texto[2]));
+	formateaPorcentaje("   >250: ", v.porcentajeRango[RANGO_GLUCOSA_MUY_ALTO],
+		formateaPorcentaje("Alto >180: ", v.porcentajeRango[RANGO_GLUCOSA_ALTO], texto[3]));
+	LCD_formateaFijo(v.desviacion, 1, LCD_formateaTexto(" mg/dL   DE: ",
+		LCD_formateaFijo(v.media, 1, LCD_formateaTexto("Media: ", texto[4]))));
+	formateaPorcentaje("   GMI: ", v.gmi, formateaPorcentaje("CV: ", v.coeficienteVariacion, texto[5]));
+
+	for (int i = 0; i < FILAS_ESTADISTICAS; i++)
+		LCD_setTextoEtiqueta(texto[i], &pPantalla->etiquetasEstadisticas[i]);
+	pPantalla->estadisticasCambiadas = 0;
+}
+
+
+static int tocaCabecera(void * componente, const LCD_EventoTactil * evento) {
+	// Cada pulsación en la cabecera muestra la siguiente vista: gráfica, estadísticas de 24 h, 7 d y 14 d,
+	// y otra vez la gráfica
+	PantallaGlucosa * pPantalla = componente;
+	if (evento->tipo != LCD_TACTIL_PULSA)
+		return 0;
+	if (++pPantalla->ventanaMostrada == ESTADISTICAS_NUM_VENTANAS)
+		pPantalla->ventanaMostrada = -1;
+	pPantalla->estadisticasCambiadas = 1;
+
+	int estadisticas = pPantalla->ventanaMostrada >= 0;
+	LCD_setVisibilidadGrupoEscena(!estadisticas, pPantalla->grupoGrafica, &pPantalla->escena);
+	LCD_setVisibilidadGrupoEscena(estadisticas, pPantalla->grupoEstadisticas, &pPantalla->escena);
+	if (estadisticas)
+		escribeEstadisticas(pPantalla);  // Los eventos llegan antes de que la escena restaure y dibuje
+	return 1;
+}
+
+
+void inicializaPantallaGlucosa(PantallaGlucosa * pPantalla) {
+	// Inicializa la pantalla con dos buffers, en horizontal
+	LCD_inicializa2Buffers(1);
+
+	// Sólo se redibujan los rectángulos que cambian; al principio toda la pantalla es inválida
+	LCD_inicializaRegiones(320, 240);
+
+	// Las cadenas que no cambian entre frames se guardan ya dibujadas en la SDRAM
+	LCD_inicializaCacheTexto(LCD_CACHE_TEXTO_BYTES);
+
+	// Los eventos táctiles van al componente bajo el dedo a través de una rejilla, donde los componentes
+	// se registran al inicializarse
+	LCD_inicializaIndiceTactil();
+
+	// Ejes, etiquetas, cabecera y umbral se dibujan una vez en la SDRAM y el DMA2D los restaura en cada frame
+	LCD_inicializaFondo(0x00000000, inicializaGrafica);
+
+	inicializaHistorial(&pPantalla->historial);  // Últimas lecturas, las más antiguas se sobrescriben en O(1)
+	inicializaPiramide(&pPantalla->piramide);  // Semanas de lecturas y agregados por hora y día, en la SDRAM
+	inicializaEstadisticas(&pPantalla->estadisticas);  // Sumas acumuladas de 24 h, 7 d y 14 d
+	pPantalla->ventanaMostrada = -1;
+	pPantalla->estadisticasCambiadas = 1;
+	pPantalla->nivelActual = 0;
+	pPantalla->ultimoNumero = 0;
+	pPantalla->nivelAnterior = -1;
+	pPantalla->alarmaActual = 0;
+	pPantalla->alarmaAnterior = 0;
+
+	// La escena dibuja la cabecera, el aviso de alarma y la gráfica en este orden; el aviso va en su grupo
+	LCD_inicializaEscena(&pPantalla->escena);
+	LCD_anadeFuncionEscena(atiendeCabecera, pPantalla, 0, 0, 320, 30, LCD_ESCENA_SIN_GRUPO, 0, &pPantalla->escena);
+	pPantalla->grupoAviso = LCD_anadeGrupoEscena(LCD_ESCENA_SIN_GRUPO, &pPantalla->escena);
+	LCD_anadeFuncionEscena(atiendeAviso, pPantalla, 45, 35, 230, 25, pPantalla->grupoAviso, 0, &pPantalla->escena);
+	LCD_setVisibilidadGrupoEscena(0, pPantalla->grupoAviso, &pPantalla->escena);
+	pPantalla->grupoGrafica = LCD_anadeGrupoEscena(LCD_ESCENA_SIN_GRUPO, &pPantalla->escena);
+	LCD_anadeFuncionEscena(atiendeGrafica, pPantalla, 25, 30, 295, 210, pPantalla->grupoGrafica, 0,
+		&pPantalla->escena);
+
+	// La vista de estadísticas tapa la zona de la gráfica con etiquetas opacas y se muestra en su lugar
+	pPantalla->grupoEstadisticas = LCD_anadeGrupoEscena(LCD_ESCENA_SIN_GRUPO, &pPantalla->escena);
+	for (int i = 0; i < FILAS_ESTADISTICAS; i++) {
+		LCD_inicializaEtiqueta("", 0, 30 + i * 35, &juegoAlpha15, 1, 320, 35, 10, 10, LCD_ALINEACION_IZQUIERDA,
+			0xFFFFFFFF, 0xFF000000, 1, 1, &pPantalla->etiquetasEstadisticas[i]);
+		LCD_anadeElementoEscena(LCD_ELEMENTO_ETIQUETA, &pPantalla->etiquetasEstadisticas[i],
+			pPantalla->grupoEstadisticas, 0, &pPantalla->escena);
+	}
+	LCD_setVisibilidadGrupoEscena(0, pPantalla->grupoEstadisticas, &pPantalla->escena);
+
+	// Al pulsar la cabecera se alterna entre la gráfica y las estadísticas
+	LCD_anadeZonaTactil(0, 0, 320, 30, tocaCabecera, pPantalla);
+}
+
+
+static void anadeMedicion(int valor, PantallaGlucosa * pPantalla) {
+	// Añade una lectura, o un hueco si 'valor' es 0
+	if (valor == 0)
+		anadeHuecoHistorial(&pPantalla->historial);
+	else anadeHistorial(valor, &pPantalla->historial);
+	// Primero las estadísticas: la pirámide aún guarda las lecturas que salen de cada ventana
+	anadeEstadisticas(valor, &pPantalla->piramide, &pPantalla->estadisticas);
+	anadePiramide(valor, &pPantalla->piramide);
+	pPantalla->estadisticasCambiadas = 1;
+}
+
+
+static void rellenaHueco(const EstadoControl * estado, PantallaGlucosa * pPantalla) {
+	// Una lectura reenviada rellena su hueco allí donde aún se guarde. La gráfica sólo añade columnas
+	// nuevas al desplazarse, así que se redibuja entera
+	uint32_t antiguedad = pPantalla->ultimoNumero - estado->numero;
+	if (rellenaHistorial(antiguedad, estado->valor, &pPantalla->historial))
+		LCD_invalidaRegion(25, 30, 295, 210);
+	if (rellenaPiramide(antiguedad, estado->valor, &pPantalla->piramide)) {
+		rellenaEstadisticas(antiguedad, estado->valor, &pPantalla->estadisticas);
+		pPantalla->estadisticasCambiadas = 1;
+	}
+}
+
+
+void actualizaPantallaGlucosa(const EstadoControl * estado, PantallaGlucosa * pPantalla) {
+	pPantalla->alarmaActual = estado->alarma;
+	if (estado->fuente == FUENTE_REENVIO) {
+		rellenaHueco(estado, pPantalla);
+		return;
+	}
+
+	// Una columna por periodo: un hueco ocupa su columna y se guarda como 0 en la pirámide y las
+	// estadísticas. Los periodos cuyo mensaje se descartó por una cola llena también son huecos, hasta las
+	// semanas que guarda la pirámide
+	uint32_t saltados = estado->numero - pPantalla->ultimoNumero - 1;
+	if (totalMuestrasHistorial(&pPantalla->historial) > 0 && saltados < PIRAMIDE_CAPACIDAD_MUESTRAS)
+		while (saltados-- > 0)
+			anadeMedicion(0, pPantalla);
+	anadeMedicion(estado->calidad == CALIDAD_HUECO ? 0 : estado->valor, pPantalla);
+	pPantalla->nivelActual = estado->valor;
+	pPantalla->ultimoNumero = estado->numero;
+}
+
+
+void dibujaPantallaGlucosa(PantallaGlucosa * pPantalla) {
+	// La gráfica se desplaza sola; la cabecera sólo cambia con el valor. Mientras se muestra el aviso de
+	// alarma (y una vez más cuando desaparece) se redibuja toda la gráfica encima
+	if (pPantalla->nivelActual != pPantalla->nivelAnterior)
+		LCD_invalidaRegion(0, 0, 320, 30);
+	if (pPantalla->alarmaActual || pPantalla->alarmaAnterior)
+		LCD_invalidaRegion(25, 30, 295, 210);
+	pPantalla->nivelAnterior = pPantalla->nivelActual;
+	pPantalla->alarmaAnterior = pPantalla->alarmaActual;
+	LCD_setVisibilidadGrupoEscena(pPantalla->alarmaActual, pPantalla->grupoAviso, &pPantalla->escena);
+	if (pPantalla->ventanaMostrada >= 0 && pPantalla->estadisticasCambiadas)
+		escribeEstadisticas(pPantalla);  // Sólo se redibujan las etiquetas cuyo texto ha cambiado
+	LCD_setActividad(LCD_ACTIVIDAD_ALARMA, pPantalla->alarmaActual);  // Frecuencia completa mientras dure la alarma
+
+	// Eventos táctiles, restauración del fondo de las regiones inválidas y dibujo, en una pasada
+	LCD_atiendeEscena(&pPantalla->escena);
+}
+
+
+static void cambiaPerfil(int activa) {
+	setPerfilEnergia(activa ? ENERGIA_PERFIL_ALTO : ENERGIA_PERFIL_BAJO);
+}
+
+
+void tareaPantalla(void * argumento) {
+	static PantallaGlucosa pantalla;
+	inicializaPantallaGlucosa(&pantalla);
+
+	// El controlador táctil lo lee su propia tarea con TP_INT1; los componentes consumen sus eventos una
+	// vez por frame
+	LCD_inicializaTactil();
+
+	// Frames al ritmo del borrado vertical del LTDC, ver sincroniaLCD.h
+	LCD_inicializaSincronia(FRECUENCIA_PANTALLA);
+
+	// Reloj completo mientras se usa la pantalla y a la mitad cuando lleva LCD_REPOSO_MINIMO ms inactiva. Los
+	// frames de cada medición con la pantalla inactiva no cambian el reloj
+	LCD_setFuncionActividad(cambiaPerfil);
+
+	for(;;)
+	{
+		// Lecturas publicadas por el control desde el último frame. Un frame lento sólo retrasa a la pantalla
+		EstadoControl estado;
+		while (osMessageQueueGet(colaPantalla, &estado, NULL, 0) == osOK)
+			actualizaPantallaGlucosa(&estado, &pantalla);
+
+		dibujaPantallaGlucosa(&pantalla);
+
+		// Intercambio en el borrado vertical y espera al siguiente periodo, o a que la despierten si está inactiva
+		LCD_presentaFrame();
+	}
+}
@@ -0,0 +1,265 @@
+#ifndef TAREAS_H_
+#define TAREAS_H_
+
+#include <stdint.h>
+#include "historialGlucosa.h"
+#include "piramideGlucosa.h"
+#include "estadisticasGlucosa.h"
+#include "registroGlucosa.h"
+#include "ingestaGlucosa.h"
+#include "escenaLCD.h"
+
+/**
+  * @file tareas.h
+  * @author EII
+  *
+  * @brief Tareas de la aplicación y colas de mensajes entre ellas.
+  *
+  * La aplicación se reparte en cuatro tareas que se comunican mediante colas de mensajes de CMSIS-RTOS2,
+  * de forma que un frame que tarda en dibujarse nunca retrasa la adquisición ni las decisiones de control:
+  *
+  * - Sensor (osPriorityHigh): obtiene una medición cada PERIODO_SENSOR ms, numerada con su periodo, y la
+  *   publica en la entrada del sensor (ver ingestaGlucosa.h), una cola sin bloqueos hacia la tarea de
+  *   control. En el simulador (LCD_SIMULADOR) el transmisor además pierde a veces la conexión y reenvía
+  *   después parte de las lecturas, para probar los huecos; en la placa publica todas las que toma.
+  *   Apenas hace trabajo, así que basta una pila pequeña.
+  * - Control (osPriorityAboveNormal1): saca de la entrada las lecturas, los huecos de los periodos sin
+  *   lectura y las lecturas reenviadas. Si una lectura no llega MARGEN_SENSOR ms después de lo previsto,
+  *   su periodo pasa a ser un hueco en ese momento, sin esperar a la lectura siguiente. Evalúa cada
+  *   lectura nueva (umbral de alarma) y es donde se toman las decisiones de dosificación, que así se
+  *   enteran enseguida de que el sensor ha dejado de enviar; los huecos y las reenviadas no cambian la
+  *   alarma. Publica el resultado para la pantalla y para el registro. Su plazo es el periodo del sensor.
+  * - Pantalla (osPriorityNormal): es la tarea por defecto. Consume las mediciones pendientes una vez por
+  *   frame y redibuja la interfaz. Necesita la pila más grande por las funciones de dibujo. Sin pulsaciones
+  *   ni alarma dibuja sólo un frame por medición (ver sincroniaLCD.h). Al pulsar la cabecera se pasa de
+  *   la gráfica a las estadísticas de 24 horas, 7 días y 14 días (ver estadisticasGlucosa.h), y de ahí
+  *   otra vez a la gráfica. Los huecos cortan la gráfica y se rellenan si llega la lectura reenviada.
+  * - Registro (osPriorityLow): guarda los eventos en memoria cuando no hay nada más urgente que hacer, y
+  *   las lecturas también en un registro comprimido de meses en la SDRAM (ver registroGlucosa.h). También
+  *   envía las lecturas, las alarmas y las medidas del perfilado por telemetría (ver telemetria.h). Los
+  *   huecos ocupan su periodo en el registro comprimido con valor 0, y las lecturas reenviadas lo
+  *   rellenan en su bloque.
+  *
+  * Los envíos nunca bloquean a la tarea que envía: si la cola de destino está llena se descarta el mensaje
+  * y se contabiliza. Las colas están dimensionadas para absorber varios frames sin atender.
+  *
+  * La tarea táctil (tactilLCD) queda con osPriorityAboveNormal, por debajo del control y por encima de la
+  * pantalla.
+  *
+  * Ejemplo, dentro de main.c:
+  * @code{.c}
+  * inicializaTareas();  // Tras osKernelInitialize(): crea las colas y las tareas de sensor, control y registro
+  * ...
+  * void StartDefaultTask(void *argument) {
+  *     tareaPantalla(argument);  // La tarea por defecto dibuja la pantalla
+  * }
+  * @endcode
+  */
+
+
+/** @brief Periodo de adquisición del sensor en ms */
+#ifndef PERIODO_SENSOR
+#define PERIODO_SENSOR 50
+#endif
+
+/** @brief Retraso en ms sobre el instante previsto a partir del cual el control da por perdida una lectura */
+#ifndef MARGEN_SENSOR
+#define MARGEN_SENSOR (PERIODO_SENSOR / 2)
+#endif
+
+/** @brief Frecuencia de refresco de la pantalla en Hz, ver sincroniaLCD.h */
+#ifndef FRECUENCIA_PANTALLA
+#define FRECUENCIA_PANTALLA 20
+#endif
+
+/** @brief Nivel de glucosa en mg/dL por debajo del cual se activa la alarma */
+#ifndef UMBRAL_HIPOGLUCEMIA
+#define UMBRAL_HIPOGLUCEMIA 50
+#endif
+
+/** @brief Número de etiquetas, una por línea, de la vista de estadísticas */
+#define FILAS_ESTADISTICAS 6
+
+/** @brief Mensajes que caben en la cola del control a la pantalla. Cubre varios frames sin atender */
+#ifndef TAMANO_COLA_PANTALLA
+#define TAMANO_COLA_PANTALLA 16
+#endif
+
+/** @brief Mensajes que caben en la cola del control al registro */
+#ifndef TAMANO_COLA_REGISTRO
+#define TAMANO_COLA_REGISTRO 32
+#endif
+
+/** @brief Número de eventos que guarda el registro en memoria. Los más antiguos se sobrescriben */
+#ifndef REGISTRO_CAPACIDAD
+#define REGISTRO_CAPACIDAD 256
+#endif
+
+
+/**
+ * @brief Resultado del control enviado a la tarea de la pantalla, por cada lectura, hueco o lectura reenviada
+ */
+typedef struct {
+    /** @brief Instante de la medición en ticks del sistema */
+    uint32_t instante;
+    /** @brief Nivel de glucosa en mg/dL, 0 en los huecos */
+    int valor;
+    /** @brief Buleano cierto si la última lectura nueva está por debajo de UMBRAL_HIPOGLUCEMIA */
+    int alarma;
+    /** @brief Calidad de la lectura, CalidadLectura */
+    uint8_t calidad;
+    /** @brief Origen de la lectura, FuenteLectura */
+    uint8_t fuente;
+    /** @brief Periodo del transmisor de la lectura */
+    uint32_t numero;
+} EstadoControl;
+
+
+/**
+ * @brief Tipo de evento del registro
+ */
+typedef enum {
+    /** @brief Nueva medición */
+    REGISTRO_LECTURA,
+    /** @brief Se activa la alarma */
+    REGISTRO_ALARMA_ACTIVA,
+    /** @brief Se desactiva la alarma */
+    REGISTRO_ALARMA_FIN,
+    /** @brief Periodo sin medición */
+    REGISTRO_HUECO,
+    /** @brief Medición reenviada que rellena un hueco anterior */
+    REGISTRO_RECUPERADA} TipoRegistro;
+
+
+/**
+ * @brief Evento enviado a la tarea de registro
+ */
+typedef struct {
+    /** @brief Tipo de evento */
+    TipoRegistro tipo;
+    /** @brief Instante del evento en ticks del sistema */
+    uint32_t instante;
+    /** @brief Nivel de glucosa en mg/dL asociado al evento */
+    int valor;
+    /** @brief Periodo del transmisor de la medición asociada al evento */
+    uint32_t numero;
+} EventoRegistro;
+
+
+/**
+ * @brief Estado de la pantalla principal, con la cabecera, la gráfica y la alarma
+ *
+ * @see inicializaPantallaGlucosa(), actualizaPantallaGlucosa(), dibujaPantallaGlucosa()
+ */
+typedef struct {
+    /** @brief Mediciones que se muestran en la gráfica */
+    HistorialGlucosa historial;
+    /** @brief Historial largo por horas y días, para gráficas y estadísticas de semanas o meses */
+    PiramideGlucosa piramide;
+    /** @brief Estadísticas de las últimas 24 horas, 7 días y 14 días */
+    EstadisticasGlucosa estadisticas;
+    /** @brief Ventana cuyas estadísticas se muestran en lugar de la gráfica, o -1 si se muestra la gráfica */
+    int ventanaMostrada;
+    /** @brief Buleano cierto si hay que volver a escribir las etiquetas de las estadísticas */
+    int estadisticasCambiadas;
+    /** @brief Líneas de la vista de estadísticas */
+    LCD_Etiqueta etiquetasEstadisticas[FILAS_ESTADISTICAS];
+    /** @brief Último nivel recibido, que se muestra en la cabecera, o 0 si el último periodo es un hueco */
+    int nivelActual;
+    /** @brief Periodo del transmisor de la última medición o hueco añadido a la gráfica */
+    uint32_t ultimoNumero;
+    /** @brief Nivel mostrado en el frame anterior, o -1 si aún no se ha mostrado ninguno */
+    int nivelAnterior;
+    /** @brief Buleano cierto si hay que mostrar el aviso de nivel bajo */
+    int alarmaActual;
+    /** @brief Buleano cierto si el aviso se mostró en el frame anterior */
+    int alarmaAnterior;
+    /** @brief Cabecera, aviso y gráfica, en el orden en que se dibujan */
+    LCD_Escena escena;
+    /** @brief Índice en la escena del grupo del aviso, que sólo está visible durante la alarma */
+    int grupoAviso;
+    /** @brief Índice en la escena del grupo de la gráfica */
+    int grupoGrafica;
+    /** @brief Índice en la escena del grupo de las estadísticas, visible en lugar de la gráfica */
+    int grupoEstadisticas;
+} PantallaGlucosa;
+
+
+/**
+ * @brief Crea las colas de mensajes y las tareas de sensor, control y registro
+ *
+ * Hay que llamarla después de osKernelInitialize() y antes de osKernelStart(). La tarea de la pantalla es
+ * la tarea por defecto, que tiene que llamar a tareaPantalla().
+ */
+void inicializaTareas(void);
+
+
+/**
+ * @brief Cuerpo de la tarea que dibuja la pantalla. No retorna
+ *
+ * @param argumento No se utiliza
+ */
+void tareaPantalla(void * argumento);
+
+
+/**
+ * @brief Inicializa la pantalla, la capa de fondo con los ejes de la gráfica y el estado de la pantalla
+ *
+ * La estructura tiene que empezar a cero la primera vez, ver inicializaPiramide() en piramideGlucosa.h.
+ *
+ * @param pPantalla Puntero a la estructura que representa a la pantalla principal
+ */
+void inicializaPantallaGlucosa(PantallaGlucosa * pPantalla);
+
+
+/**
+ * @brief Anota un resultado de la tarea de control para mostrarlo en el siguiente frame
+ *
+ * Las lecturas nuevas y los huecos se añaden a la gráfica, a la pirámide y a las estadísticas. Las
+ * reenviadas rellenan su hueco en los tres, si aún lo guardan.
+ *
+ * @param estado Puntero al resultado recibido
+ * @param pPantalla Puntero a la estructura que representa a la pantalla principal
+ */
+void actualizaPantallaGlucosa(const EstadoControl * estado, PantallaGlucosa * pPantalla);
+
+
+/**
+ * @brief Dibuja un frame de la pantalla principal en el frame buffer oculto, sin intercambiar los buffers
+ *
+ * Es el cuerpo del bucle de tareaPantalla(), separado para poder medirlo (ver rendimiento.h). Después hay
+ * que llamar a LCD_intercambiaBuffersRegiones().
+ *
+ * @param pPantalla Puntero a la estructura que representa a la pantalla principal
+ */
+void dibujaPantallaGlucosa(PantallaGlucosa * pPantalla);
+
+
+/**
+ * @brief Número de mensajes descartados porque la cola de destino estaba llena
+ */
+uint32_t mensajesPerdidos(void);
+
+
+/**
+ * @brief Obtiene uno de los eventos guardados por la tarea de registro
+ *
+ * @param indice Antigüedad del evento: 0 es el más reciente
+ * @param evento Puntero donde se copia el evento
+ * @return Buleano cierto si existe el evento
+ */
+int leeRegistro(uint32_t indice, EventoRegistro * evento);
+
+
+/**
+ * @brief Copia las lecturas del registro comprimido desde un instante
+ *
+ * @param desde Periodo del transmisor desde el que se copia
+ * @param maximo Número máximo de lecturas que se copian
+ * @param muestras Vector donde se copian las lecturas, con su instante en periodos del transmisor
+ * @return Número de lecturas copiadas
+ */
+uint32_t leeLecturasRegistradas(uint32_t desde, uint32_t maximo, MuestraRegistro * muestras);
+
+
+#endif /* TAREAS_H_ */
@@ -0,0 +1,217 @@
+#include "telemetria.h"
+#include "cmsis_os.h"
+#include "perfilado.h"
+
+#ifdef LCD_SIMULADOR
+#include <pthread.h>
+#include "simulador.h"
+
+static pthread_mutex_t mutexBuffers = PTHREAD_MUTEX_INITIALIZER;
+
+#define ENTRA_SECCION() pthread_mutex_lock(&mutexBuffers)
+#define SALE_SECCION() pthread_mutex_unlock(&mutexBuffers)
+#else
+#include "main.h"
+
+extern UART_HandleTypeDef huart1;  // Inicializado en main.c
+
+static DMA_HandleTypeDef hdmaTransmision;
+
+// Con PRIMASK y no con la sección crítica de FreeRTOS, para poder enviar desde cualquier interrupción
+#define ENTRA_SECCION() uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define SALE_SECCION() __set_PRIMASK(primask)
+#endif
+
+
+static uint8_t buffers[2][TELEMETRIA_BUFFER_BYTES];
+static volatile uint32_t ocupados[2];  // Bytes de cada buffer
+static volatile uint32_t numRegistros[2];  // Registros de cada buffer, para contarlos si se pierde
+static volatile uint8_t llenando = 0;  // Buffer en el que escriben los productores
+static volatile int transmitiendo = 0;  // Buleano cierto si el DMA está enviando el otro buffer
+static volatile int pausada = 0;
+static uint8_t secuencia = 0;
+static volatile uint32_t perdidas = 0;
+static void (*funcionPausa)(void) = NULL;  // Avisa del final de un envío con la telemetría detenida
+
+
+static uint16_t crc16(const uint8_t * datos, uint32_t bytes) {
+	uint16_t crc = 0xFFFF;
+	for (uint32_t i = 0; i < bytes; i++) {
+		crc ^= (uint16_t) datos[i] << 8;
+		for (int b = 0; b < 8; b++)
+			crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+
+static uint32_t codificaCOBS(const uint8_t * origen, uint32_t bytes, uint8_t * destino) {
+// Codifica en COBS menos de 254 bytes y añade el 0 final. Devuelve los bytes escritos en 'destino'
+
+	uint32_t codigo = 0;  // Posición del byte que indica la distancia al siguiente 0
+	uint32_t n = 1;
+	for (uint32_t i = 0; i < bytes; i++) {
+		if (origen[i] == 0) {
+			destino[codigo] = n - codigo;
+			codigo = n++;
+		} else destino[n++] = origen[i];
+	}
+	destino[codigo] = n - codigo;
+	destino[n++] = 0;
+	return n;
+}
+
+
+static void transmite(uint8_t buffer) {
+#ifdef LCD_SIMULADOR
+	if (!simuladorTransmiteUART(buffers[buffer], ocupados[buffer]))
+		perdidas += numRegistros[buffer];
+	transmitiendo = 0;  // El envío simulado termina al volver
+#else
+	if (HAL_UART_Transmit_DMA(&huart1, buffers[buffer], ocupados[buffer]) != HAL_OK) {
+		perdidas += numRegistros[buffer];  // USART1 ocupada por otro envío: el buffer se pierde
+		transmitiendo = 0;
+	}
+#endif
+}
+
+
+static void arranca(void) {
+// Si el DMA está libre, empieza a enviar el buffer que se estaba llenando y los productores pasan al otro.
+// Se llama dentro de la sección
+
+	if (transmitiendo || pausada || ocupados[llenando] == 0)
+		return;
+	uint8_t envio = llenando;
+	llenando ^= 1;
+	ocupados[llenando] = 0;
+	numRegistros[llenando] = 0;
+	transmitiendo = 1;
+	transmite(envio);
+}
+
+
+void inicializaTelemetria(void) {
+#ifndef LCD_SIMULADOR
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	hdmaTransmision.Instance = DMA2_Stream7;
+	hdmaTransmision.Init.Channel = DMA_CHANNEL_4;
+	hdmaTransmision.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdmaTransmision.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdmaTransmision.Init.MemInc = DMA_MINC_ENABLE;
+	hdmaTransmision.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaTransmision.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdmaTransmision.Init.Mode = DMA_NORMAL;
+	hdmaTransmision.Init.Priority = DMA_PRIORITY_LOW;
+	hdmaTransmision.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	HAL_DMA_Init(&hdmaTransmision);
+	__HAL_LINKDMA(&huart1, hdmatx, hdmaTransmision);
+
+	// El DMA copia los bytes y la USART avisa del final del envío, que llega a HAL_UART_TxCpltCallback()
+	HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+	HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(USART1_IRQn);
+#endif
+	ocupados[0] = ocupados[1] = 0;
+	numRegistros[0] = numRegistros[1] = 0;
+	llenando = 0;
+	transmitiendo = 0;
+	pausada = 0;
+	perdidas = 0;
+}
+
+
+int enviaTelemetria(TipoTelemetria tipo, uint32_t instante, const uint8_t * datos, uint8_t bytes) {
+	uint8_t registro[TELEMETRIA_MAX_REGISTRO];
+	if (bytes > TELEMETRIA_MAX_DATOS)
+		return 0;
+	registro[0] = tipo;
+	for (int i = 0; i < 4; i++)
+		registro[2 + i] = instante >> (8 * i);
+	for (uint8_t i = 0; i < bytes; i++)
+		registro[TELEMETRIA_CABECERA + i] = datos[i];
+	uint32_t n = TELEMETRIA_CABECERA + bytes;
+
+	int cabe;
+	ENTRA_SECCION();
+	registro[1] = secuencia++;  // Dentro de la sección, para que el orden en el flujo sea el de la secuencia
+	uint16_t crc = crc16(registro, n);
+	registro[n] = crc;
+	registro[n + 1] = crc >> 8;
+	uint8_t * destino = &buffers[llenando][ocupados[llenando]];
+	cabe = ocupados[llenando] + n + 2 + 2 <= TELEMETRIA_BUFFER_BYTES;  // COBS añade un byte y el 0 final
+	if (cabe) {
+		ocupados[llenando] += codificaCOBS(registro, n + 2, destino);  // Directamente en el buffer de envío
+		numRegistros[llenando]++;
+		arranca();
+	} else perdidas++;
+	SALE_SECCION();
+	return cabe;
+}
+
+
+int enviaLecturaTelemetria(uint32_t instante, int valor) {
+	uint8_t datos[2] = {valor, valor >> 8};
+	return enviaTelemetria(TELEMETRIA_LECTURA, instante, datos, sizeof(datos));
+}
+
+
+int enviaDosisTelemetria(uint32_t instante, uint16_t centesimas) {
+	uint8_t datos[2] = {centesimas, centesimas >> 8};
+	return enviaTelemetria(TELEMETRIA_DOSIS, instante, datos, sizeof(datos));
+}
+
+
+int enviaAlarmaTelemetria(uint32_t instante, int valor, int activa) {
+	uint8_t datos[3] = {valor, valor >> 8, activa != 0};
+	return enviaTelemetria(TELEMETRIA_ALARMA, instante, datos, sizeof(datos));
+}
+
+
+void enviaPerfiladoTelemetria(void) {
+#ifdef PERFILADO
+	MuestraPerfil muestra;
+	uint32_t instante = osKernelGetTickCount();
+	for (uint32_t tarea = 0; tarea < PERFIL_TAREAS; tarea++)
+		while (leeMuestraPerfilado(tarea, &muestra)) {
+			uint8_t datos[6] = {tarea, muestra.zona, muestra.duracion, muestra.duracion >> 8,
+				muestra.duracion >> 16, muestra.duracion >> 24};
+			enviaTelemetria(TELEMETRIA_PERFIL, instante, datos, sizeof(datos));
+		}
+#endif
+}
+
+
+void pausaTelemetria(int pausa) {
+	ENTRA_SECCION();
+	pausada = pausa;
+	if (!pausa)
+		arranca();
+	SALE_SECCION();
+}
+
+
+int transmitiendoTelemetria(void) {
+	return transmitiendo;
+}
+
+
+void finTransmisionTelemetria(void) {
+	ENTRA_SECCION();
+	transmitiendo = 0;
+	arranca();
+	SALE_SECCION();
+	if (pausada && funcionPausa != NULL)
+		funcionPausa();
+}
+
+
+void setFuncionPausaTelemetria(void (*funcion)(void)) {
+	funcionPausa = funcion;
+}
+
+
+uint32_t perdidasTelemetria(void) {
+	return perdidas;
+}
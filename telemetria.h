@@ -0,0 +1,169 @@
+#ifndef TELEMETRIA_H_
+#define TELEMETRIA_H_
+
+#include <stdint.h>
+
+/**
+  * @file telemetria.h
+  * @author EII
+  *
+  * @brief Envío de telemetría binaria por USART1 con DMA: lecturas, dosis, alarmas y medidas del perfilado.
+  *
+  * Cada registro es una trama con este contenido, con los enteros en little endian:
+  *
+  * | Bytes | Campo                                                           |
+  * |-------|-----------------------------------------------------------------|
+  * | 1     | Tipo, TipoTelemetria                                            |
+  * | 1     | Número de secuencia, que se incrementa con cada registro        |
+  * | 4     | Instante en ticks del sistema                                   |
+  * | 0-6   | Datos del tipo, ver TipoTelemetria                              |
+  * | 2     | CRC-16/CCITT (polinomio 0x1021, inicial 0xFFFF) de lo anterior  |
+  *
+  * La trama se codifica en COBS, que elimina los bytes a 0, y se termina con un 0. Así el receptor puede
+  * engancharse en cualquier punto del flujo y una trama corrupta sólo se pierde ella. El número de
+  * secuencia permite al receptor contar los registros perdidos. El CRC se calcula por software: la unidad
+  * CRC trabaja con palabras de 32 bits y la usa el registro de glucosa (ver registroGlucosa.h) desde
+  * otra tarea.
+  *
+  * Las tramas se codifican directamente en uno de dos buffers: mientras el DMA envía uno, los productores
+  * llenan el otro, y al terminar el envío se intercambian. Los productores nunca esperan a la USART: si la
+  * trama no cabe en el buffer que se está llenando se descarta y se contabiliza. Se puede enviar desde
+  * cualquier tarea y desde interrupciones; la copia en el buffer se hace con las interrupciones enmascaradas.
+  *
+  * En la placa, inicializaTelemetria() configura el stream 7 del DMA2 (canal 4, USART1_TX) y hay que
+  * llamar a finTransmisionTelemetria() desde HAL_UART_TxCpltCallback(). En el simulador (LCD_SIMULADOR)
+  * las tramas se escriben en el destino de la opción -u, que puede ser un fichero o un pseudoterminal, y
+  * el programa decodificaTelemetria del simulador las decodifica en CSV.
+  *
+  * Ejemplo:
+  * @code{.c}
+  * MX_USART1_UART_Init();
+  * inicializaTelemetria();
+  * ...
+  * enviaLecturaTelemetria(osKernelGetTickCount(), 95);
+  * @endcode
+  */
+
+
+/** @brief Tamaño en bytes de cada uno de los dos buffers de envío */
+#ifndef TELEMETRIA_BUFFER_BYTES
+#define TELEMETRIA_BUFFER_BYTES 256
+#endif
+
+/** @brief Máximo de bytes de datos de un registro */
+#define TELEMETRIA_MAX_DATOS 6
+
+/** @brief Bytes de la cabecera de un registro: tipo, secuencia e instante */
+#define TELEMETRIA_CABECERA 6
+
+/** @brief Máximo de bytes de un registro sin codificar, con el CRC */
+#define TELEMETRIA_MAX_REGISTRO (TELEMETRIA_CABECERA + TELEMETRIA_MAX_DATOS + 2)
+
+
+/**
+ * @brief Tipo de registro de telemetría
+ */
+typedef enum {
+    /** @brief Lectura del sensor. Datos: valor en mg/dL (int16) */
+    TELEMETRIA_LECTURA = 1,
+    /** @brief Dosis administrada. Datos: cantidad en centésimas de unidad (uint16) */
+    TELEMETRIA_DOSIS,
+    /** @brief Cambio de la alarma. Datos: valor en mg/dL (int16), buleano activa (uint8) */
+    TELEMETRIA_ALARMA,
+    /** @brief Medida de perfilado.h. Datos: índice de la tarea (uint8), zona (uint8), duración (uint32) */
+    TELEMETRIA_PERFIL} TipoTelemetria;
+
+
+/**
+ * @brief Deja los buffers vacíos y, en la placa, configura el DMA de transmisión de USART1
+ *
+ * Hay que llamarla después de MX_USART1_UART_Init() y antes de que nadie envíe.
+ */
+void inicializaTelemetria(void);
+
+
+/**
+ * @brief Envía un registro sin esperar
+ *
+ * @param tipo Tipo de registro
+ * @param instante Instante en ticks del sistema
+ * @param datos Datos del registro, ya en little endian
+ * @param bytes Número de bytes de datos, como mucho TELEMETRIA_MAX_DATOS
+ * @return Buleano cierto si el registro cabía en el buffer. Si no, se descarta
+ */
+int enviaTelemetria(TipoTelemetria tipo, uint32_t instante, const uint8_t * datos, uint8_t bytes);
+
+
+/**
+ * @brief Envía una lectura del sensor
+ */
+int enviaLecturaTelemetria(uint32_t instante, int valor);
+
+
+/**
+ * @brief Envía una dosis administrada
+ *
+ * @param instante Instante en ticks del sistema
+ * @param centesimas Cantidad en centésimas de unidad
+ */
+int enviaDosisTelemetria(uint32_t instante, uint16_t centesimas);
+
+
+/**
+ * @brief Envía un cambio de la alarma
+ */
+int enviaAlarmaTelemetria(uint32_t instante, int valor, int activa);
+
+
+/**
+ * @brief Envía las medidas pendientes de los buffers circulares de perfilado.h
+ *
+ * Sin -DPERFILADO no hace nada. Sólo la puede llamar una tarea, ver leeMuestraPerfilado(). Las medidas se extraen aunque no quepan.
+ */
+void enviaPerfiladoTelemetria(void);
+
+
+/**
+ * @brief Detiene o reanuda el inicio de nuevos envíos
+ *
+ * Mientras está detenida los registros se siguen acumulando en el buffer. Lo usa setPerfilEnergia() para
+ * no cambiar la velocidad de la USART en mitad de un envío, ver setFuncionPausaTelemetria().
+ *
+ * @param pausa Buleano cierto para detenerla
+ */
+void pausaTelemetria(int pausa);
+
+
+/**
+ * @brief Buleano cierto si hay un envío por DMA en curso
+ */
+int transmitiendoTelemetria(void);
+
+
+/**
+ * @brief Avisa del final de un envío y empieza el del otro buffer si tiene registros
+ *
+ * Se llama desde HAL_UART_TxCpltCallback() cuando la interrupción es de USART1.
+ */
+void finTransmisionTelemetria(void);
+
+
+/**
+ * @brief Indica una función a la que se avisa cuando termina un envío con la telemetría detenida
+ *
+ * La llama finTransmisionTelemetria() desde la interrupción, con USART1 ya libre. La usa setPerfilEnergia()
+ * para cambiar el reloj al terminar el envío en curso, sin esperarlo.
+ *
+ * @param funcion Función sin parámetros, o NULL
+ */
+void setFuncionPausaTelemetria(void (*funcion)(void));
+
+
+/**
+ * @brief Número de registros descartados porque no cabían en el buffer o porque no se pudo empezar el envío
+ *     de su buffer
+ */
+uint32_t perdidasTelemetria(void);
+
+
+#endif /* TELEMETRIA_H_ */
@@ -0,0 +1,187 @@
+#include "textoLCD.h"
+#include <string.h>
+#include "frameLCD.h"
+#include "dma2dLCD.h"
+#include "memoriaSDRAM.h"
+#include "colorLCD.h"
+
+
+typedef struct {
+	char cadena[LCD_CACHE_TEXTO_LONGITUD + 1];  // Cadena vacía si la entrada está libre
+	const LCD_JuegoCaracteresAlpha * juego;
+	uint32_t color;
+	uint16_t separacion;
+	int transparencia;
+	int horizontal;  // Orientación de la pantalla cuando se dibujó
+	uint32_t desplazamiento, bytes;  // Posición y tamaño de los puntos dentro de la zona de la caché
+	uint32_t uso;  // Valor de 'usos' en el último acceso, para descartar la entrada usada hace más tiempo
+} EntradaCache;
+
+static EntradaCache entradas[LCD_CACHE_TEXTO_ENTRADAS];
+static uint8_t * zona = 0;  // Zona de la SDRAM donde se guardan los puntos de las cadenas
+static uint32_t tamanoZona;
+static uint32_t usos = 0;  // Número de accesos a la caché
+static uint32_t aciertos = 0, fallos = 0;
+
+
+static uint32_t leePunto(const uint8_t * p) {
+// Lee un punto de un frame buffer como un color ARGB de 32 bits
+
+#ifdef LCD_FORMATO_RGB565
+	return LCD_RGB565_A_ARGB(*(const uint16_t *) p);
+#else
+	return *(const uint32_t *) p;
+#endif
+}
+
+
+static EntradaCache * busca(const char * cadena, uint32_t color, uint16_t separacion,
+	const LCD_JuegoCaracteresAlpha * juego, int transparencia, int horizontal) {
+	for (int i = 0; i < LCD_CACHE_TEXTO_ENTRADAS; i++) {
+		EntradaCache * e = &entradas[i];
+		if (e->juego == juego && e->color == color && e->separacion == separacion &&
+				e->transparencia == transparencia && e->horizontal == horizontal && e->cadena[0] != 0 &&
+				strcmp(e->cadena, cadena) == 0)
+			return e;
+	}
+	return NULL;
+}
+
+
+static int buscaHueco(uint32_t bytes, uint32_t * desplazamiento) {
+// Busca el primer hueco de la zona donde caben 'bytes' bytes sin pisar ninguna entrada
+
+	uint32_t inicio = 0;
+	int solapa;
+	do {
+		solapa = 0;
+		for (int i = 0; i < LCD_CACHE_TEXTO_ENTRADAS; i++) {
+			const EntradaCache * e = &entradas[i];
+			if (e->cadena[0] != 0 && e->desplazamiento < inicio + bytes && inicio < e->desplazamiento + e->bytes) {
+				inicio = e->desplazamiento + e->bytes;  // Prueba justo después de la entrada que estorba
+				solapa = 1;
+			}
+		}
+	} while (solapa && inicio + bytes <= tamanoZona);
+	*desplazamiento = inicio;
+	return inicio + bytes <= tamanoZona;
+}
+
+
+static EntradaCache * entradaLibre(void) {
+	for (int i = 0; i < LCD_CACHE_TEXTO_ENTRADAS; i++)
+		if (entradas[i].cadena[0] == 0)
+			return &entradas[i];
+	return NULL;
+}
+
+
+static int descartaMenosUsada(void) {
+// Libera la entrada usada hace más tiempo. Devuelve falso si la caché ya estaba vacía
+
+	EntradaCache * menosUsada = NULL;
+	for (int i = 0; i < LCD_CACHE_TEXTO_ENTRADAS; i++)
+		if (entradas[i].cadena[0] != 0 && (menosUsada == NULL || usos - entradas[i].uso > usos - menosUsada->uso))
+			menosUsada = &entradas[i];
+	if (menosUsada == NULL)
+		return 0;
+	menosUsada->cadena[0] = 0;
+	return 1;
+}
+
+
+static EntradaCache * nuevaEntrada(uint32_t bytes) {
+// Obtiene una entrada libre con 'bytes' bytes de la zona, descartando las menos usadas si hace falta
+
+	uint32_t desplazamiento;
+	EntradaCache * e;
+	while (!buscaHueco(bytes, &desplazamiento) || (e = entradaLibre()) == NULL)
+		if (!descartaMenosUsada())
+			return NULL;  // No cabe ni con la caché vacía
+	e->desplazamiento = desplazamiento;
+	e->bytes = bytes;
+	return e;
+}
+
+
+static void capturaCadena(uint16_t x, uint16_t y, const char * cadena, const LCD_Region * fisica,
+	EntradaCache * e) {
+// Dibuja la cadena en blanco sobre negro en el bloque 'fisica' del frame buffer oculto y guarda en la
+// entrada la opacidad de cada punto junto con el color. Deja el bloque como estaba
+
+	uint8_t * puntos = zona + e->desplazamiento;
+	uint32_t opacidad = e->transparencia >= 100 ? 255 : e->transparencia * 255 / 100;
+	LCD_esperaDMA2D();
+	for (uint16_t fila = 0; fila < fisica->alto; fila++)  // Guarda lo que hay debajo
+		memcpy(puntos + fila * fisica->ancho * LCD_BYTES_PUNTO,
+			LCD_direccionPuntoFisico(fisica->x, fisica->y + fila), fisica->ancho * LCD_BYTES_PUNTO);
+	LCD_rellenaBloqueDMA2D(0xFF000000, LCD_direccionPuntoFisico(fisica->x, fisica->y), fisica->ancho,
+		fisica->alto);
+	LCD_esperaDMA2D();
+	LCD_dibujaCadenaCaracteresAlpha(x, y, cadena, 0xFFFFFFFF, e->separacion, e->juego, 0, 100);
+
+	for (int32_t i = fisica->ancho * fisica->alto - 1; i >= 0; i--) {
+		uint8_t * p = LCD_direccionPuntoFisico(fisica->x + i % fisica->ancho, fisica->y + i / fisica->ancho);
+		uint32_t cobertura = (leePunto(p) >> 8) & 0xFF;  // Canal verde del blanco mezclado con el negro
+		memcpy(p, puntos + i * LCD_BYTES_PUNTO, LCD_BYTES_PUNTO);  // Restaura el punto de debajo
+		((uint32_t *) puntos)[i] = (cobertura * opacidad / 255) << 24 | (e->color & 0x00FFFFFF);
+	}
+	// El punto i ocupa en la entrada los bytes 4i a 4i + 3, donde estaban guardados los puntos i y
+	// siguientes. Al recorrer de atrás adelante ya se han restaurado cuando se sobrescriben
+}
+
+
+int LCD_inicializaCacheTexto(uint32_t bytes) {
+	if (zona == 0) {
+		zona = reservaSDRAM(bytes);
+		tamanoZona = bytes;
+	}
+	for (int i = 0; i < LCD_CACHE_TEXTO_ENTRADAS; i++)
+		entradas[i].cadena[0] = 0;
+	return zona != 0;
+}
+
+
+void LCD_dibujaCadenaCaracteresAlphaCache(uint16_t x, uint16_t y, const char * cadena, uint32_t color,
+	uint16_t separacion, const LCD_JuegoCaracteresAlpha * juego, int enBlancoYNegro, int transparencia) {
+	uint16_t ancho = LCD_anchoCadenaCaracteresAlpha(cadena, juego, separacion);
+	if (zona == 0 || !LCD_regionesActivas() || enBlancoYNegro || transparencia <= 0 || ancho == 0 ||
+			strlen(cadena) > LCD_CACHE_TEXTO_LONGITUD || x + ancho > LCD_anchoPantalla() ||
+			y + juego->alto > LCD_altoPantalla()) {
+		LCD_esperaDMA2D();
+		LCD_dibujaCadenaCaracteresAlpha(x, y, cadena, color, separacion, juego, enBlancoYNegro, transparencia);
+		return;
+	}
+
+	int horizontal = LCD_anchoPantalla() > LCD_altoPantalla();
+	LCD_Region region = {x, y, ancho, juego->alto}, fisica;
+	LCD_regionFisica(&region, &fisica);
+	EntradaCache * e = busca(cadena, color, separacion, juego, transparencia, horizontal);
+	if (e != NULL)
+		aciertos++;
+	else {
+		e = nuevaEntrada(fisica.ancho * fisica.alto * 4);
+		if (e == NULL) {  // Más grande que toda la caché
+			LCD_esperaDMA2D();
+			LCD_dibujaCadenaCaracteresAlpha(x, y, cadena, color, separacion, juego, 0, transparencia);
+			return;
+		}
+		strcpy(e->cadena, cadena);
+		e->juego = juego;
+		e->color = color;
+		e->separacion = separacion;
+		e->transparencia = transparencia;
+		e->horizontal = horizontal;
+		capturaCadena(x, y, cadena, &fisica, e);
+		fallos++;
+	}
+	e->uso = ++usos;
+	LCD_mezclaBloqueARGBDMA2D(zona + e->desplazamiento, 0, LCD_direccionPuntoFisico(fisica.x, fisica.y),
+		fisica.ancho, fisica.alto, 255);
+}
+
+
+void LCD_estadisticasCacheTexto(uint32_t * pAciertos, uint32_t * pFallos) {
+	*pAciertos = aciertos;
+	*pFallos = fallos;
+}
@@ -0,0 +1,93 @@
+#ifndef TEXTOLCD_H_
+#define TEXTOLCD_H_
+
+#include <stdint.h>
+#include "pantallaLCD.h"
+
+/**
+  * @file textoLCD.h
+  * @author EII
+  *
+  * @brief Caché de textos ya dibujados, para no recorrer los caracteres uno a uno en cada frame.
+  *
+  * LCD_dibujaCadenaCaracteresAlpha() dibuja cada carácter punto a punto con la CPU. La mayoría de los
+  * textos de la interfaz (cabeceras, etiquetas, botones) no cambian de un frame a otro, así que
+  * LCD_dibujaCadenaCaracteresAlphaCache() guarda en la SDRAM cada cadena ya dibujada, como una imagen ARGB
+  * con el color y la opacidad aplicados, y las siguientes veces la mezcla con el frame buffer en una sola
+  * transferencia del DMA2D.
+  *
+  * Cada entrada se identifica por la cadena, el juego de caracteres, el color, la separación y la
+  * transparencia. Las entradas ocupan una zona de la SDRAM de tamaño fijo, reservada al inicializar la
+  * caché; cuando no cabe una nueva se descartan las usadas hace más tiempo.
+  *
+  * La primera vez la cadena se dibuja con pantallaLCD en blanco sobre negro en el propio frame buffer, de
+  * donde se obtiene la opacidad de cada punto, y después se restaura lo que había debajo. Así la imagen
+  * guardada es exactamente la que dibujaría pantallaLCD.
+  *
+  * Se dibuja directamente, sin caché, si no se ha inicializado la caché o la gestión de regiones
+  * (frameLCD.h), si la cadena se sale de la pantalla, si es más larga que LCD_CACHE_TEXTO_LONGITUD o si se
+  * dibuja en blanco y negro.
+  *
+  * Como las demás funciones del DMA2D, retorna sin esperar a que termine la transferencia: antes de dibujar
+  * con la CPU hay que llamar a LCD_esperaDMA2D().
+  *
+  * Ejemplo:
+  * @code{.c}
+  * LCD_inicializaRegiones(320, 240);
+  * LCD_inicializaCacheTexto(LCD_CACHE_TEXTO_BYTES);
+  *
+  * while(1) {
+  *     ...
+  *     LCD_dibujaCadenaCaracteresAlphaCache(10, 10, "Nivel Glucosa ", 0x00000000, 2, &juegoAlpha17, 0, 100);
+  *     LCD_intercambiaBuffersRegiones();
+  * }
+  * @endcode
+  */
+
+
+/** @brief Bytes de la SDRAM reservados para la caché. Cada punto de una cadena ocupa 4 bytes */
+#ifndef LCD_CACHE_TEXTO_BYTES
+#define LCD_CACHE_TEXTO_BYTES (64 * 1024)
+#endif
+
+/** @brief Número máximo de cadenas en la caché */
+#ifndef LCD_CACHE_TEXTO_ENTRADAS
+#define LCD_CACHE_TEXTO_ENTRADAS 32
+#endif
+
+/** @brief Longitud máxima de las cadenas que se guardan en la caché, sin contar el terminador */
+#ifndef LCD_CACHE_TEXTO_LONGITUD
+#define LCD_CACHE_TEXTO_LONGITUD 31
+#endif
+
+
+/**
+ * @brief Reserva la memoria de la caché en la SDRAM
+ *
+ * Sólo reserva la primera vez que se llama; las siguientes vacían la caché.
+ *
+ * @param bytes Tamaño de la caché en bytes
+ * @return Buleano cierto si se pudo reservar la memoria
+ */
+int LCD_inicializaCacheTexto(uint32_t bytes);
+
+
+/**
+ * @brief Dibuja una cadena de caracteres utilizando la caché
+ *
+ * Tiene los mismos parámetros que LCD_dibujaCadenaCaracteresAlpha() y el mismo resultado.
+ */
+void LCD_dibujaCadenaCaracteresAlphaCache(uint16_t x, uint16_t y, const char * cadena, uint32_t color,
+    uint16_t separacion, const LCD_JuegoCaracteresAlpha * juego, int enBlancoYNegro, int transparencia);
+
+
+/**
+ * @brief Obtiene el número de cadenas dibujadas desde la caché y el de cadenas que hubo que dibujar
+ *
+ * @param aciertos Puntero donde se copia el número de cadenas encontradas en la caché
+ * @param fallos Puntero donde se copia el número de cadenas añadidas a la caché
+ */
+void LCD_estadisticasCacheTexto(uint32_t * aciertos, uint32_t * fallos);
+
+
+#endif /* TEXTOLCD_H_ */